@@ -0,0 +1,56 @@
+#!/bin/bash
+
+# dumps the synthetic UE process of src/Fixture/UEFixture.cpp on a Linux host
+# and checks the dumped objects & types counts against the fixture's
+#   ./fixture.sh [fixture options], e.g. ./fixture.sh --engine 5.1 --classes 20000
+
+BUILD_DIR=${BUILD_DIR:-build-host}
+OUT_DIR=${OUT_DIR:-$BUILD_DIR/out}
+
+if [ $# -eq 0 ]; then
+    set -- --engine 4.27 --classes 2000
+fi
+
+cmake -S . -B "$BUILD_DIR" -DCMAKE_BUILD_TYPE=Release || exit 1
+cmake --build "$BUILD_DIR" -j"$(nproc)" || exit 1
+
+DUMPER=$(ls "$BUILD_DIR"/UEDump3r_* | head -n 1)
+
+FIXTURE_LOG=$(mktemp)
+trap 'kill $FIXTURE_PID 2>/dev/null; rm -f "$FIXTURE_LOG"' EXIT
+
+"$BUILD_DIR"/UEFixture "$@" > "$FIXTURE_LOG" &
+FIXTURE_PID=$!
+
+# wait for the fixture to lay out its world
+for _ in $(seq 1 100); do
+    grep -q "waiting to be dumped" "$FIXTURE_LOG" && break
+    kill -0 $FIXTURE_PID 2>/dev/null || { cat "$FIXTURE_LOG"; exit 1; }
+    sleep 0.1
+done
+cat "$FIXTURE_LOG"
+
+echo dumping fixture...
+
+"$DUMPER" -p UEFixture -o "$OUT_DIR" || exit 1
+
+LOGS="$OUT_DIR/UEDump3r/UEFixture/Logs.txt"
+if [ ! -f "$LOGS" ]; then
+    echo "missing $LOGS"
+    exit 1
+fi
+
+check() {
+    local name=$1 expected=$2 dumped=$3
+    if [ "$expected" != "$dumped" ]; then
+        echo "FAIL: $name fixture=$expected dumped=$dumped"
+        return 1
+    fi
+    echo "OK: $name $dumped"
+}
+
+status=0
+check Objects "$(sed -n 's/^Objects: \([0-9]*\).*/\1/p' "$FIXTURE_LOG")" "$(sed -n 's/^ObjObjects Num: \([0-9]*\).*/\1/p' "$LOGS" | head -n 1)" || status=1
+check Types "$(sed -n 's/^Types: \([0-9]*\).*/\1/p' "$FIXTURE_LOG")" "$(sed -n 's/^Types: \([0-9]*\).*/\1/p' "$LOGS" | head -n 1)" || status=1
+
+exit $status
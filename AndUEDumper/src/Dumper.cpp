@@ -1,62 +1,243 @@
 #include "Dumper.hpp"
 
-#include <fmt/format.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <unordered_set>
 
-#include <nlohmann/json.hpp>
-using json = nlohmann::json;
+#include <fmt/format.h>
 
 #include "UE/UEMemory.hpp"
+#include "UE/UEOffsetsDiscovery.hpp"
 using namespace UEMemory;
 
 #include "UPackageGenerator.hpp"
+#include "SDKDatabaseWriter.hpp"
+#include "UsmapWriter.hpp"
 
-#define kVECTOR_CONTAINS(vec, val) (std::find(vec.begin(), vec.end(), val) != vec.end())
+#include "Utils/JsonWriter.hpp"
+#include "Utils/ThreadPool.hpp"
+#include "Utils/TraceUtils.hpp"
 
 namespace dumper_jf_ns
 {
-    static uintptr_t base_address = 0;
     struct JsonFunction
     {
         std::string Parent;
         std::string Name;
         uint64_t Address = 0;
     };
-    static std::vector<JsonFunction> jsonFunctions;
 
-    void to_json(json &j, const JsonFunction &jf)
+    // invalid functions are skipped
+    bool WriteJsonFunction(JsonWriter &writer, const JsonFunction &jf, uintptr_t baseAddress)
     {
         if (jf.Parent.empty() || jf.Parent == "None" || jf.Parent == "null")
-            return;
+            return false;
         if (jf.Name.empty() || jf.Name == "None" || jf.Name == "null")
-            return;
-        if (jf.Address == 0 || jf.Address <= base_address)
-            return;
+            return false;
+        if (jf.Address == 0 || jf.Address <= baseAddress)
+            return false;
 
         std::string fname = IOUtils::replace_specials(jf.Parent, '_');
         fname += "$$";
         fname += IOUtils::replace_specials(jf.Name, '_');
 
-        j = json{{"Name", fname}, {"Address", (jf.Address - base_address)}};
+        writer.beginObject();
+        writer.key("Address");
+        writer.value(uint64_t(jf.Address - baseAddress));
+        writer.key("Name");
+        writer.value(fname);
+        writer.endObject();
+        return true;
     }
 }  // namespace dumper_jf_ns
 
-bool UEDumper::Init(IGameProfile *profile)
+namespace dumper_ci_ns
+{
+    // class -> index of its first instance that isn't a class default object,
+    // classes with only a default object get INT32_MAX, so every native class is a key
+    using ClassIndex = std::unordered_map<uint8_t *, int32_t>;
+
+    ClassIndex BuildClassIndex()
+    {
+        int32_t objectsCount = UEWrappers::GetObjects()->GetNumElements();
+
+        std::mutex mergeMtx;
+        ClassIndex index;
+
+        ThreadPool::Get().parallelFor(0, size_t(std::max(0, objectsCount)), 4096, [&](size_t begin, size_t end)
+        {
+            ClassIndex local;
+            for (int32_t i = int32_t(begin); i < int32_t(end); i++)
+            {
+                UE_UObject object = UEWrappers::GetObjects()->GetObjectPtr(i);
+                if (!object) continue;
+
+                UE_UClass objectClass = object.GetClass();
+                if (!objectClass) continue;
+
+                auto it = local.emplace(objectClass.GetAddress(), INT32_MAX).first;
+                if (it->second == INT32_MAX && !object.HasFlags(EObjectFlags::ClassDefaultObject))
+                    it->second = i;
+            }
+
+            std::lock_guard<std::mutex> lock(mergeMtx);
+            for (const auto &it : local)
+            {
+                auto entry = index.emplace(it.first, it.second).first;
+                entry->second = std::min(entry->second, it.second);
+            }
+        });
+
+        return index;
+    }
+
+    UE_UClass FindClass(const ClassIndex &index, const std::string &name, const std::string &fullName)
+    {
+        for (const auto &it : index)
+        {
+            UE_UClass cls = it.first;
+            if (cls.GetName() == name && cls.GetFullName() == fullName)
+                return cls;
+        }
+        return {};
+    }
+
+    // first non default instance of cls or of any class derived from it
+    uint8_t *FindFirstInstance(const ClassIndex &index, UE_UClass cls)
+    {
+        if (!cls) return nullptr;
+
+        int32_t first = INT32_MAX;
+        for (const auto &it : index)
+        {
+            if (it.second >= first)
+                continue;
+
+            for (UE_UStruct super = UE_UClass(it.first); super; super = super.GetSuper())
+            {
+                if (super == cls)
+                {
+                    first = it.second;
+                    break;
+                }
+            }
+        }
+
+        return first != INT32_MAX ? UEWrappers::GetObjects()->GetObjectPtr(first) : nullptr;
+    }
+
+    // GUObjectArray index of each full name, -1 if not found.
+    // Names are compared first, full names are only built for objects with a matching name
+    std::vector<int32_t> FindObjects(const std::vector<std::string> &fullNames)
+    {
+        std::unordered_map<std::string, std::vector<size_t>> byName;
+        for (size_t i = 0; i < fullNames.size(); i++)
+        {
+            size_t sep = fullNames[i].find_last_of(". ");
+            byName[sep != std::string::npos ? fullNames[i].substr(sep + 1) : fullNames[i]].push_back(i);
+        }
+
+        std::mutex foundMtx;
+        std::vector<int32_t> found(fullNames.size(), -1);
+        int32_t objectsCount = UEWrappers::GetObjects()->GetNumElements();
+
+        ThreadPool::Get().parallelFor(0, size_t(std::max(0, objectsCount)), 4096, [&](size_t begin, size_t end)
+        {
+            for (int32_t i = int32_t(begin); i < int32_t(end); i++)
+            {
+                UE_UObject object = UEWrappers::GetObjects()->GetObjectPtr(i);
+                if (!object) continue;
+
+                auto it = byName.find(object.GetName());
+                if (it == byName.end()) continue;
+
+                std::string fullName = object.GetFullName();
+                for (size_t k : it->second)
+                {
+                    if (fullName != fullNames[k]) continue;
+
+                    std::lock_guard<std::mutex> lock(foundMtx);
+                    if (found[k] == -1 || i < found[k])
+                        found[k] = i;
+                }
+            }
+        });
+
+        return found;
+    }
+}  // namespace dumper_ci_ns
+
+bool UEDumper::Init(IGameProfile *profile, const UE_Pointers *knownPointers)
 {
-    UEVarsInitStatus initStatus = profile->InitUEVars();
+    TRACE_SCOPE("UEDumper::Init");
+
+    _cachePath.clear();
+    _cache = UEOffsetsCache();
+    _cacheHit = false;
+
+    bool cacheLoaded = false;
+    if (!_cacheDirectory.empty())
+    {
+        std::string key = UEOffsetsCache::GetBuildKey(profile->GetUnrealELF());
+        if (!key.empty())
+        {
+            _cachePath = _cacheDirectory + "/" + key + ".cache";
+            cacheLoaded = _cache.Load(_cachePath);
+        }
+    }
+
+    UEVarsInitStatus initStatus = profile->InitUEVars(cacheLoaded ? &_cache.Pointers : knownPointers);
     if (initStatus != UEVarsInitStatus::SUCCESS)
     {
         _lastError = UEVars::InitStatusToStr(initStatus);
         return false;
     }
     _profile = profile;
+
+    // a hit only if init kept the cached pointers
+    uintptr_t baseAddr = profile->GetUEVars()->GetBaseAddress();
+    _cacheHit = cacheLoaded &&
+                profile->GetUEVars()->GetNamesPtr() == baseAddr + _cache.Pointers.Names &&
+                profile->GetUEVars()->GetGUObjectsArrayPtr() == baseAddr + _cache.Pointers.UObjectArray;
+
+    if (_cacheHit && _cache.HasDiscovered)
+        UEWrappers::SetDiscoveredOffsets(_cache.Discovered);
+
+    _engineVersion = UEEngineVersion();
+    _engineVersionReady = false;
+
     return true;
 }
 
+const UEEngineVersion &UEDumper::GetEngineVersion() const
+{
+    if (!_engineVersionReady && _profile)
+    {
+        _engineVersion = (_cacheHit && _cache.EngineVersion.IsValid()) ? _cache.EngineVersion
+                                                                       : _profile->GetEngineVersion();
+        _engineVersionReady = true;
+    }
+    return _engineVersion;
+}
+
 bool UEDumper::Dump(std::unordered_map<std::string, BufferFmt> *outBuffersMap)
 {
+    TRACE_SCOPE("UEDumper::Dump");
+
     outBuffersMap->insert({"Logs.txt", BufferFmt()});
     BufferFmt &logsBufferFmt = outBuffersMap->at("Logs.txt");
 
+    // large outputs go to their file while they're generated, the caller closes the streams
+    auto streamedOutput = [this, outBuffersMap](const std::string &name) -> BufferFmt &
+    {
+        outBuffersMap->insert({name, BufferFmt()});
+        BufferFmt &bufferFmt = outBuffersMap->at(name);
+        if (!_outputDirectory.empty())
+            bufferFmt.openStream(_outputDirectory + "/" + name);
+        return bufferFmt;
+    };
+
     {
         if (_dumpExeInfoNotify) _dumpExeInfoNotify(false);
         DumpExecutableInfo(logsBufferFmt);
@@ -75,6 +256,18 @@ bool UEDumper::Dump(std::unordered_map<std::string, BufferFmt> *outBuffersMap)
         if (_dumpObjectsInfoNotify) _dumpObjectsInfoNotify(true);
     }
 
+    if (_discoverOffsets)
+    {
+        outBuffersMap->insert({"DiscoveredOffsets.hpp", BufferFmt()});
+        BufferFmt &profileBufferFmt = outBuffersMap->at("DiscoveredOffsets.hpp");
+        if (!DumpDiscoveredOffsets(logsBufferFmt, profileBufferFmt))
+        {
+            _lastError = "ERROR_DISCOVER_OFFSETS";
+            return false;
+        }
+        return true;
+    }
+
     {
         if (_dumpOffsetsInfoNotify) _dumpOffsetsInfoNotify(false);
         outBuffersMap->insert({"Offsets.hpp", BufferFmt()});
@@ -83,39 +276,65 @@ bool UEDumper::Dump(std::unordered_map<std::string, BufferFmt> *outBuffersMap)
         if (_dumpOffsetsInfoNotify) _dumpOffsetsInfoNotify(true);
     }
 
-    outBuffersMap->insert({"Objects.txt", BufferFmt()});
-    BufferFmt &objsBufferFmt = outBuffersMap->at("Objects.txt");
-    std::vector<std::pair<uint8_t *const, std::vector<UE_UObject>>> packages;
-    GatherUObjects(logsBufferFmt, objsBufferFmt, packages, _objectsProgressCallback);
+    if (_offsetsOnly)
+        return true;
 
-    if (packages.empty())
+    UEReflectionGraph graph;
+    if (!_rootTypes.empty())
     {
-        logsBufferFmt.append("Error: Packages are empty.\n");
-        logsBufferFmt.append("==========================\n");
-        _lastError = "ERROR_EMPTY_PACKAGES";
-        return false;
+        AcquireTypesClosure(logsBufferFmt, graph);
+
+        if (graph.Types.empty())
+        {
+            logsBufferFmt.append("Error: Root types not found.\n");
+            logsBufferFmt.append("==========================\n");
+            _lastError = "ERROR_ROOT_TYPES_NOT_FOUND";
+            return false;
+        }
     }
+    else
+    {
+        BufferFmt &objsBufferFmt = streamedOutput("Objects.txt");
+        UEPackagesArray packages;
+        GatherUObjects(logsBufferFmt, objsBufferFmt, packages, _objectsProgressCallback);
+
+        if (packages.empty())
+        {
+            logsBufferFmt.append("Error: Packages are empty.\n");
+            logsBufferFmt.append("==========================\n");
+            _lastError = "ERROR_EMPTY_PACKAGES";
+            return false;
+        }
 
-    outBuffersMap->insert({"AIOHeader.hpp", BufferFmt()});
-    BufferFmt &aioBufferFmt = outBuffersMap->at("AIOHeader.hpp");
-    DumpAIOHeader(logsBufferFmt, aioBufferFmt, packages, _dumpProgressCallback);
+        FilterPackages(logsBufferFmt, packages);
 
-    dumper_jf_ns::base_address = _profile->GetUnrealELF().base();
-    if (dumper_jf_ns::jsonFunctions.size())
+        AcquireReflectionGraph(logsBufferFmt, packages, graph, _dumpProgressCallback);
+    }
+
+    BufferFmt &aioBufferFmt = streamedOutput("AIOHeader.hpp");
+    BufferFmt &scriptBufferFmt = streamedOutput("script.json");
+    if (!_sdkDatabase)
     {
-        logsBufferFmt.append("Generating script json...\nFunctions: {}\n", dumper_jf_ns::jsonFunctions.size());
-        logsBufferFmt.append("==========================\n");
+        DumpAIOHeader(logsBufferFmt, aioBufferFmt, scriptBufferFmt, graph, nullptr);
+    }
+    else
+    {
+        SDKDatabaseWriter dbWriter;
+        DumpAIOHeader(logsBufferFmt, aioBufferFmt, scriptBufferFmt, graph, &dbWriter);
 
-        outBuffersMap->insert({"script.json", BufferFmt()});
-        BufferFmt &scriptBufferFmt = outBuffersMap->at("script.json");
+        TRACE_SCOPE("SDKDatabaseWriter::Write");
+        dbWriter.Write(streamedOutput("SDK.db"));
+    }
 
-        json js;
-        for (const auto &jf : dumper_jf_ns::jsonFunctions)
-        {
-            js["Functions"].push_back(jf);
-        }
+    if (_usmap)
+    {
+        TRACE_SCOPE("UsmapWriter::Write");
 
-        scriptBufferFmt.append("{}", js.dump(4));
+        BufferFmt &usmapBufferFmt = streamedOutput("Mappings.usmap");
+        auto stats = UsmapWriter::Write(graph, usmapBufferFmt);
+        logsBufferFmt.append("Generating usmap...\nNames: {}\nEnums: {}\nStructs: {}\nSize: {}\n",
+                             stats.Names, stats.Enums, stats.Structs, usmapBufferFmt.size());
+        logsBufferFmt.append("==========================\n");
     }
 
     return true;
@@ -123,6 +342,8 @@ bool UEDumper::Dump(std::unordered_map<std::string, BufferFmt> *outBuffersMap)
 
 void UEDumper::DumpExecutableInfo(BufferFmt &logsBufferFmt)
 {
+    TRACE_SCOPE("UEDumper::DumpExecutableInfo");
+
     auto ue_elf = _profile->GetUnrealELF();
     logsBufferFmt.append("e_machine: 0x{:X}\n", ue_elf.header().e_machine);
     logsBufferFmt.append("Library: {}\n", ue_elf.realPath().c_str());
@@ -131,11 +352,24 @@ void UEDumper::DumpExecutableInfo(BufferFmt &logsBufferFmt)
     for (const auto &it : ue_elf.segments())
         logsBufferFmt.append("{}\n", it.toString());
 
+    const UEEngineVersion &engineVersion = GetEngineVersion();
+    logsBufferFmt.append("Engine Version: {}\n", engineVersion.ToString());
+    if (const char *table = engineVersion.GetDefaultOffsetsName())
+    {
+        logsBufferFmt.append("Default Offsets: UE_DefaultOffsets::{}\n", table);
+
+        UE_Offsets defaults = engineVersion.GetDefaultOffsets(_profile->isUsingCasePreservingName(), _profile->isUsingOutlineNumberName());
+        if ((defaults.UStruct.ChildProperties != 0) != (_profile->GetOffsets()->UStruct.ChildProperties != 0))
+            logsBufferFmt.append("Warning: profile offsets and engine version disagree on FField properties\n");
+    }
+
     logsBufferFmt.append("==========================\n");
 }
 
 void UEDumper::DumpNamesInfo(BufferFmt &logsBufferFmt)
 {
+    TRACE_SCOPE("UEDumper::DumpNamesInfo");
+
     uintptr_t baseAddr = _profile->GetUEVars()->GetBaseAddress();
     uintptr_t namesPtr = _profile->GetUEVars()->GetNamesPtr();
 
@@ -161,6 +395,8 @@ void UEDumper::DumpNamesInfo(BufferFmt &logsBufferFmt)
 
 void UEDumper::DumpObjectsInfo(BufferFmt &logsBufferFmt)
 {
+    TRACE_SCOPE("UEDumper::DumpObjectsInfo");
+
     uintptr_t baseAddr = _profile->GetUEVars()->GetBaseAddress();
     uintptr_t objectArrayPtr = _profile->GetUEVars()->GetGUObjectsArrayPtr();
     uintptr_t objObjectsPtr = _profile->GetUEVars()->GetObjObjectsPtr();
@@ -179,8 +415,31 @@ void UEDumper::DumpObjectsInfo(BufferFmt &logsBufferFmt)
     logsBufferFmt.append("==========================\n");
 }
 
+bool UEDumper::DumpDiscoveredOffsets(BufferFmt &logsBufferFmt, BufferFmt &profileBufferFmt)
+{
+    TRACE_SCOPE("UEDumper::DumpDiscoveredOffsets");
+
+    UEOffsetsDiscovery discovery(_profile);
+    discovery.setEngineVersion(GetEngineVersion());
+    bool found = discovery.Run();
+
+    logsBufferFmt.append("Offsets discovery: {}\n", found ? "done" : "failed");
+    for (const auto &finding : discovery.GetFindings())
+    {
+        logsBufferFmt.append("{} = 0x{:X} ({}/{})\n", finding.Field, finding.Value, finding.Score, finding.Samples);
+    }
+    logsBufferFmt.append("==========================\n");
+
+    if (found)
+        discovery.WriteProfileCode(profileBufferFmt);
+
+    return found;
+}
+
 void UEDumper::DumpOffsetsInfo(BufferFmt &logsBufferFmt, BufferFmt &offsetsBufferFmt)
 {
+    TRACE_SCOPE("UEDumper::DumpOffsetsInfo");
+
     uintptr_t baseAddr = _profile->GetUEVars()->GetBaseAddress();
     uintptr_t namesPtr = _profile->GetUEVars()->GetNamesPtr();
     uintptr_t objectsArrayPtr = _profile->GetUEVars()->GetGUObjectsArrayPtr();
@@ -188,45 +447,62 @@ void UEDumper::DumpOffsetsInfo(BufferFmt &logsBufferFmt, BufferFmt &offsetsBuffe
     uintptr_t UEnginePtr = 0, UWorldPtr = 0, ProcessEventPtr = 0;
     int ProcessEventIndex = 0;
 
+    if (_cacheHit)
+        logsBufferFmt.append("Using cache {}\n", _cachePath);
+
     // Find UEngine & UWorld
     uint8_t *UEngineObj = nullptr, *UWorldObj = nullptr;
-    if (((UE_UObject)UEWrappers::GetObjects()->GetObjectPtr(1)).GetIndex() == 1)
+    if (_cacheHit && _cache.HasPointers && CheckCachedPointers(_cache.Pointers))
+    {
+        UEnginePtr = _cache.Pointers.Engine ? (baseAddr + _cache.Pointers.Engine) : 0;
+        UWorldPtr = _cache.Pointers.World ? (baseAddr + _cache.Pointers.World) : 0;
+        ProcessEventPtr = _cache.Pointers.ProcessEvent ? (baseAddr + _cache.Pointers.ProcessEvent) : 0;
+        ProcessEventIndex = int(_cache.Pointers.ProcessEventIndex);
+
+        logsBufferFmt.append("GEngine: [<Base> + 0x{:X}]\n", _cache.Pointers.Engine);
+        logsBufferFmt.append("GWorld: [<Base> + 0x{:X}]\n", _cache.Pointers.World);
+        logsBufferFmt.append("ProcessEvent: Index({}) | [<Base> + 0x{:X}]\n", ProcessEventIndex, _cache.Pointers.ProcessEvent);
+    }
+    else if (((UE_UObject)UEWrappers::GetObjects()->GetObjectPtr(1)).GetIndex() == 1)
     {
-        UE_UClass UEngineClass = UEWrappers::GetObjects()->FindObject("Class Engine.Engine").Cast<UE_UClass>();
-        UE_UClass UWorldClass = UEWrappers::GetObjects()->FindObject("Class Engine.World").Cast<UE_UClass>();
+        // classes are looked up in an index of the objects array built in one pass,
+        // instead of full name and IsA checks on every object
+        auto classIndex = dumper_ci_ns::BuildClassIndex();
+        UE_UClass UEngineClass = dumper_ci_ns::FindClass(classIndex, "Engine", "Class Engine.Engine");
+        UE_UClass UWorldClass = dumper_ci_ns::FindClass(classIndex, "World", "Class Engine.World");
 
         logsBufferFmt.append("Finding GEngine & GWorld...\n");
         logsBufferFmt.append("{} -> 0x{:X}\n", UEngineClass.GetFullName(), uintptr_t(UEngineClass.GetAddress()));
         logsBufferFmt.append("{} -> 0x{:X}\n", UWorldClass.GetFullName(), uintptr_t(UWorldClass.GetAddress()));
 
-        if (UEngineClass || UWorldClass)
+        UEngineObj = dumper_ci_ns::FindFirstInstance(classIndex, UEngineClass);
+        UWorldObj = dumper_ci_ns::FindFirstInstance(classIndex, UWorldClass);
+
+        std::vector<KittyMemoryEx::ProcMap> ueSegs;
+        for (const auto &it : _profile->GetUnrealELF().segments())
         {
-            UEWrappers::GetObjects()->ForEachObject([&UEngineClass, &UWorldClass, &UEngineObj, &UWorldObj](UE_UObject object) -> bool
-            {
-                if (!object.HasFlags(EObjectFlags::ClassDefaultObject))
-                {
-                    bool isUEngine = UEngineClass && object.IsA(UEngineClass);
-                    bool isUWorld = UWorldClass && object.IsA(UWorldClass);
-                    if (isUEngine) UEngineObj = object.GetAddress();
-                    if (isUWorld) UWorldObj = object.GetAddress();
-                }
-                return ((!UEngineClass || UEngineObj != nullptr) && (!UWorldClass || UWorldObj != nullptr));
-            });
+            if (it.is_rw && it.startAddress != baseAddr)
+                ueSegs.push_back(it);
         }
 
-        auto ueSegs = _profile->GetUnrealELF().segments();
-
-        // reverse search, start with .bss
-        for (auto it = ueSegs.begin(); it != ueSegs.end(); ++it)
+        // segments are searched concurrently, first segment with a hit wins like a serial search would
+        std::vector<std::pair<uintptr_t, uintptr_t>> segsRefs(ueSegs.size(), {0, 0});
+        ThreadPool::Get().parallelFor(0, ueSegs.size(), 1, [&](size_t begin, size_t end)
         {
-            if (!it->is_rw || it->startAddress == baseAddr)
-                continue;
+            for (size_t i = begin; i < end; i++)
+            {
+                std::vector<char> buffer(ueSegs[i].length, 0);
+                vm_rpm_ptr((void *)ueSegs[i].startAddress, buffer.data(), buffer.size());
 
-            std::vector<char> buffer(it->length, 0);
-            vm_rpm_ptr((void *)it->startAddress, buffer.data(), buffer.size());
+                segsRefs[i].first = FindAlignedPointerRefrence(ueSegs[i].startAddress, buffer, (uintptr_t)UEngineObj);
+                segsRefs[i].second = FindAlignedPointerRefrence(ueSegs[i].startAddress, buffer, (uintptr_t)UWorldObj);
+            }
+        });
 
-            UEnginePtr = FindAlignedPointerRefrence(it->startAddress, buffer, (uintptr_t)UEngineObj);
-            UWorldPtr = FindAlignedPointerRefrence(it->startAddress, buffer, (uintptr_t)UWorldObj);
+        for (const auto &it : segsRefs)
+        {
+            UEnginePtr = it.first;
+            UWorldPtr = it.second;
 
             if (UEnginePtr != 0 || UWorldPtr != 0)
                 break;
@@ -259,14 +535,61 @@ void UEDumper::DumpOffsetsInfo(BufferFmt &logsBufferFmt, BufferFmt &offsetsBuffe
     uEPointers.ProcessEvent = ProcessEventPtr ? (ProcessEventPtr - baseAddr) : 0;
     uEPointers.ProcessEventIndex = ProcessEventIndex;
 
-    offsetsBufferFmt.append("#pragma once\n\n#include <cstdint>\n\n\n");
-    offsetsBufferFmt.append("{}\n\n{}", _profile->GetOffsets()->ToString(), uEPointers.ToString());
+    offsetsBufferFmt.append("#pragma once\n\n#include <cstdint>\n\n");
+    offsetsBufferFmt.append("// Engine: {}\n\n", GetEngineVersion().ToString());
+    offsetsBufferFmt.append("{}\n\n{}\n\n{}", _profile->GetOffsets()->ToString(), uEPointers.ToString(),
+                            UEWrappers::GetDiscoveredOffsets()->ToString());
+
+    if (!_cachePath.empty())
+    {
+        UEOffsetsCache cache;
+        cache.Pointers = uEPointers;
+        cache.HasPointers = uEPointers.Engine || uEPointers.World || uEPointers.ProcessEvent;
+        cache.Discovered = *UEWrappers::GetDiscoveredOffsets();
+        // a failed probe is left out so the next run of this build probes again
+        cache.EngineVersion = GetEngineVersion();
+        cache.HasDiscovered = cache.Discovered.FPropertySubBase && cache.Discovered.FEnumPropertyUnderlyingProp && cache.Discovered.FEnumPropertyEnum;
+        if (!cache.Save(_cachePath))
+            logsBufferFmt.append("Couldn't save cache {}\n", _cachePath);
+    }
 
     logsBufferFmt.append("==========================\n");
 }
 
+bool UEDumper::CheckCachedPointers(const UE_Pointers &pointers) const
+{
+    uintptr_t baseAddr = _profile->GetUEVars()->GetBaseAddress();
+
+    // a pointer to an object that's where its index says, GWorld can be empty between levels
+    auto objectAt = [baseAddr](uintptr_t offset, bool canBeNull) -> bool
+    {
+        if (!offset) return true;
+
+        UE_UObject object = vm_rpm_ptr<uint8_t *>((void *)(baseAddr + offset));
+        if (!object) return canBeNull;
+
+        return UEWrappers::GetObjects()->GetObjectPtr(object.GetIndex()) == object.GetAddress();
+    };
+
+    if (!objectAt(pointers.Engine, false) || !objectAt(pointers.World, true))
+        return false;
+
+    if (pointers.ProcessEvent && pointers.Engine)
+    {
+        uint8_t *engine = vm_rpm_ptr<uint8_t *>((void *)(baseAddr + pointers.Engine));
+        uint8_t *vft = vm_rpm_ptr<uint8_t *>(engine);
+        uintptr_t pe = vm_rpm_ptr<uintptr_t>(vft + pointers.ProcessEventIndex * sizeof(uintptr_t));
+        if (pe != baseAddr + pointers.ProcessEvent)
+            return false;
+    }
+
+    return true;
+}
+
 void UEDumper::GatherUObjects(BufferFmt &logsBufferFmt, BufferFmt &objsBufferFmt, UEPackagesArray &packages, const ProgressCallback &progressCallback)
 {
+    TRACE_SCOPE("UEDumper::GatherUObjects");
+
     logsBufferFmt.append("Gathering UObjects...\n");
 
     if (UEWrappers::GetObjects()->GetNumElements() <= 0)
@@ -288,150 +611,558 @@ void UEDumper::GatherUObjects(BufferFmt &logsBufferFmt, BufferFmt &objsBufferFmt
     if (progressCallback)
         progressCallback(objectsProgress);
 
-    for (int i = 0; i < objectsCount; i++)
+    // objects are gathered in index-range shards, each with its own package buckets
+    // and Objects.txt fragment, then merged in index order to match a serial pass
+    struct GatherShard
     {
-        UE_UObject object = UEWrappers::GetObjects()->GetObjectPtr(i);
-        if (object)
+        int32_t begin = 0, end = 0;
+        BufferFmt objsBufferFmt;
+        UEPackagesArray packages;
+    };
+
+    const int32_t kShardSize = 2048;
+    std::vector<GatherShard> shards((objectsCount + kShardSize - 1) / kShardSize);
+    for (size_t i = 0; i < shards.size(); i++)
+    {
+        shards[i].begin = int32_t(i) * kShardSize;
+        shards[i].end = std::min(shards[i].begin + kShardSize, objectsCount);
+    }
+
+    std::atomic<int> objectsDone{0};
+
+    auto gatherShard = [&objectsDone](GatherShard &shard)
+    {
+        // package object -> index in shard packages, which keeps first-seen order
+        std::unordered_map<uint8_t *, size_t> packagesIndexMap;
+
+        for (int32_t i = shard.begin; i < shard.end; i++)
         {
-            if (object.IsA<UE_UFunction>() || object.IsA<UE_UStruct>() || object.IsA<UE_UEnum>())
+            UE_UObject object = UEWrappers::GetObjects()->GetObjectPtr(i);
+            if (object)
             {
-                bool found = false;
-                auto packageObj = object.GetPackageObject();
-                for (auto &pkg : packages)
+                uint8_t *packageObj = nullptr;
+                if (object.IsA<UE_UFunction>() || object.IsA<UE_UStruct>() || object.IsA<UE_UEnum>())
+                    packageObj = object.GetPackageObject();
+
+                // no package for broken outer chains
+                if (packageObj)
                 {
-                    if (pkg.first == packageObj)
+                    auto it = packagesIndexMap.find(packageObj);
+                    if (it != packagesIndexMap.end())
                     {
-                        pkg.second.push_back(object);
-                        found = true;
-                        break;
+                        shard.packages[it->second].second.push_back(i);
+                    }
+                    else
+                    {
+                        packagesIndexMap.emplace(packageObj, shard.packages.size());
+                        shard.packages.emplace_back(packageObj, std::vector<int32_t>(1, i));
                     }
                 }
-                if (!found)
-                {
-                    packages.push_back(std::make_pair(packageObj, std::vector<UE_UObject>(1, object)));
-                }
+
+                shard.objsBufferFmt.append("[{:010}]: {}\n", object.GetIndex(), object.GetFullName());
             }
 
-            objsBufferFmt.append("[{:010}]: {}\n", object.GetIndex(), object.GetFullName());
+            objectsDone++;
         }
+    };
+
+    TaskGroup gatherTasks;
+    for (auto &shard : shards)
+    {
+        gatherTasks.run([&gatherShard, &shard]
+        { gatherShard(shard); });
+    }
 
-        objectsProgress++;
+    // progress is only reported from this thread
+    while (!gatherTasks.waitFor(std::chrono::milliseconds(50)))
+    {
+        objectsProgress.setCurrent(objectsDone.load());
         if (progressCallback)
             progressCallback(objectsProgress);
     }
+    gatherTasks.wait();
+
+    objectsProgress.setCurrent(objectsCount);
+    if (progressCallback)
+        progressCallback(objectsProgress);
+
+    std::unordered_map<uint8_t *, size_t> packagesIndexMap;
+    for (auto &shard : shards)
+    {
+        objsBufferFmt.append("{}", shard.objsBufferFmt.readView());
+
+        for (auto &pkg : shard.packages)
+        {
+            auto it = packagesIndexMap.find(pkg.first);
+            if (it != packagesIndexMap.end())
+            {
+                auto &indices = packages[it->second].second;
+                indices.insert(indices.end(), pkg.second.begin(), pkg.second.end());
+            }
+            else
+            {
+                packagesIndexMap.emplace(pkg.first, packages.size());
+                packages.emplace_back(pkg.first, std::move(pkg.second));
+            }
+        }
+
+        shard = GatherShard();
+    }
 
     logsBufferFmt.append("Gathered {} Objects (Packages {})\n", objectsCount, packages.size());
     logsBufferFmt.append("==========================\n");
 }
 
-void UEDumper::DumpAIOHeader(BufferFmt &logsBufferFmt, BufferFmt &aioBufferFmt, UEPackagesArray &packages, const ProgressCallback &progressCallback)
+UEDumpFilter UEDumper::MakeDumpFilter(BufferFmt &logsBufferFmt) const
 {
-    int packages_saved = 0;
-    std::string packages_unsaved{};
+    UEDumpFilter filter = _dumpFilter;
 
-    int classes_saved = 0;
-    int structs_saved = 0;
-    int enums_saved = 0;
+    std::string error;
+    for (const auto &rule : _profile->GetDumpFilterRules())
+    {
+        if (!filter.AddRule(rule, &error))
+            logsBufferFmt.append("Filter: {}\n", error);
+    }
 
-    static bool processInternal_once = false;
+    for (const auto &fullName : _profile->GetExcludedObjects())
+        filter.AddRule("-full:" + fullName);
 
-    aioBufferFmt.append("#pragma once\n\n#include <cstdio>\n#include <string>\n#include <cstdint>\n\n\n");
+    return filter;
+}
 
-    SimpleProgressBar dumpProgress(int(packages.size()));
-    if (progressCallback)
-        progressCallback(dumpProgress);
+void UEDumper::FilterPackages(BufferFmt &logsBufferFmt, UEPackagesArray &packages)
+{
+    TRACE_SCOPE("UEDumper::FilterPackages");
 
-    auto excludedObjects = _profile->GetExcludedObjects();
+    UEDumpFilter filter = MakeDumpFilter(logsBufferFmt);
+    if (filter.Empty())
+        return;
 
-    for (UE_UPackage package : packages)
-    {
-        package.Process();
+    logsBufferFmt.append("Filtering packages...\n");
 
-        dumpProgress++;
-        if (progressCallback)
-            progressCallback(dumpProgress);
+    // done on GUObjectArray indices so filtered out types are never acquired
+    size_t packagesCount = packages.size();
+    std::vector<char> packagesKept(packagesCount, 0);
+    std::atomic<size_t> typesExcluded{0};
 
-        if (package.Classes.size() || package.Structures.size() || package.Enums.size())
+    TaskGroup filterTasks;
+    for (size_t i = 0; i < packagesCount; i++)
+    {
+        filterTasks.run([&filter, &packages, &packagesKept, &typesExcluded, i]
         {
-            aioBufferFmt.append("// Package: {}\n// Enums: {}\n// Structs: {}\n// Classes: {}\n\n",
-                                package.GetObject().GetName(), package.Enums.size(), package.Structures.size(), package.Classes.size());
+            auto &pkg = packages[i];
+            if (!filter.IsPackageIncluded(UE_UObject(pkg.first).GetName()))
+                return;
 
-            if (package.Enums.size())
+            packagesKept[i] = 1;
+            if (!filter.HasTypeRules())
+                return;
+
+            auto &indices = pkg.second;
+            size_t kept = 0;
+            for (int32_t index : indices)
             {
-                auto pkgEnums = package.Enums;
+                UE_UObject object = UEWrappers::GetObjects()->GetObjectPtr(index);
+                // functions go with their owner
+                bool keep = !object || object.IsA<UE_UFunction>() || filter.IsTypeIncluded(object.GetName(), object.GetFullName());
+                if (keep)
+                    indices[kept++] = index;
+            }
 
-                if (excludedObjects.size())
-                {
-                    pkgEnums.erase(
-                        std::remove_if(pkgEnums.begin(), pkgEnums.end(),
-                                       [&excludedObjects](const UE_UPackage::Enum &it)
-                    { return kVECTOR_CONTAINS(excludedObjects, it.FullName); }),
-                        pkgEnums.end());
-                }
+            typesExcluded += indices.size() - kept;
+            indices.resize(kept);
+        });
+    }
+    filterTasks.wait();
+
+    UEPackagesArray filtered;
+    for (size_t i = 0; i < packagesCount; i++)
+    {
+        if (packagesKept[i])
+            filtered.emplace_back(packages[i].first, std::move(packages[i].second));
+    }
+    packages.swap(filtered);
+
+    logsBufferFmt.append("Packages: {}/{}\nExcluded types: {}\n", packages.size(), packagesCount, typesExcluded.load());
+    logsBufferFmt.append("==========================\n");
+}
+
+void UEDumper::AcquireTypesClosure(BufferFmt &logsBufferFmt, UEReflectionGraph &graph)
+{
+    TRACE_SCOPE("UEDumper::AcquireTypesClosure");
+
+    logsBufferFmt.append("Acquiring root types...\n");
+
+    UEDumpFilter filter = MakeDumpFilter(logsBufferFmt);
+
+    std::vector<int32_t> roots = dumper_ci_ns::FindObjects(_rootTypes);
+    for (size_t i = 0; i < roots.size(); i++)
+    {
+        if (roots[i] < 0)
+            logsBufferFmt.append("Couldn't find {}\n", _rootTypes[i]);
+    }
+
+    // only the roots and what they need by value are read, a round at a time,
+    // each round is acquired per package and the next one is made of the new references
+    struct ClosurePart
+    {
+        uint8_t *Package = nullptr;
+        uint32_t Round = 0;
+        UEReflectionGraph Graph;
+    };
+    std::vector<ClosurePart> parts;
+
+    std::unordered_set<uint8_t *> visited;
+    // package object -> lowest object index of its types, packages are appended in that order
+    std::unordered_map<uint8_t *, int32_t> packagesFirstIndex;
+
+    std::vector<int32_t> pending;
+    for (int32_t index : roots)
+    {
+        if (index >= 0 && visited.insert(UEWrappers::GetObjects()->GetObjectPtr(index)).second)
+            pending.push_back(index);
+    }
+
+    uint32_t round = 0;
+    for (; !pending.empty(); round++)
+    {
+        UEPackagesArray packages;
+        std::unordered_map<uint8_t *, size_t> packagesIndexMap;
+        for (int32_t index : pending)
+        {
+            uint8_t *packageObj = UE_UObject(UEWrappers::GetObjects()->GetObjectPtr(index)).GetPackageObject();
+            if (!packageObj)
+                continue;
 
-                UE_UPackage::AppendEnumsToBuffer(pkgEnums, &aioBufferFmt);
+            auto it = packagesIndexMap.find(packageObj);
+            if (it != packagesIndexMap.end())
+            {
+                packages[it->second].second.push_back(index);
+            }
+            else
+            {
+                packagesIndexMap.emplace(packageObj, packages.size());
+                packages.emplace_back(packageObj, std::vector<int32_t>(1, index));
             }
 
-            if (package.Structures.size())
+            auto first = packagesFirstIndex.emplace(packageObj, index).first;
+            first->second = std::min(first->second, index);
+        }
+
+        const size_t partsBase = parts.size();
+        parts.resize(partsBase + packages.size());
+
+        TaskGroup acquireTasks;
+        for (size_t i = 0; i < packages.size(); i++)
+        {
+            std::sort(packages[i].second.begin(), packages[i].second.end());
+            acquireTasks.run([&packages, &parts, partsBase, round, typeTrees = _usmap, i]
             {
-                auto pkgStructs = package.Structures;
+                auto &part = parts[partsBase + i];
+                part.Package = packages[i].first;
+                part.Round = round;
 
-                if (excludedObjects.size())
+                TRACE_SCOPE_DETAIL("UEReflectionGraph::AcquirePackage", UE_UObject(packages[i].first).GetName());
+                part.Graph = UEReflectionGraph::AcquirePackage(packages[i].first, packages[i].second, typeTrees);
+            });
+        }
+        acquireTasks.wait();
+
+        pending.clear();
+        for (size_t i = partsBase; i < parts.size(); i++)
+        {
+            const auto &part = parts[i].Graph;
+            for (uint32_t t = 0; t < uint32_t(part.Types.size()); t++)
+            {
+                for (uint8_t *ref : part.GetValueReferences(t))
                 {
-                    pkgStructs.erase(
-                        std::remove_if(pkgStructs.begin(), pkgStructs.end(),
-                                       [&excludedObjects](const UE_UPackage::Struct &it)
-                    { return kVECTOR_CONTAINS(excludedObjects, it.FullName); }),
-                        pkgStructs.end());
-                }
+                    if (!visited.insert(ref).second)
+                        continue;
 
-                UE_UPackage::AppendStructsToBuffer(pkgStructs, &aioBufferFmt);
+                    UE_UObject object = ref;
+                    if (!filter.Empty() && (!filter.IsPackageIncluded(object.GetPackageObject().GetName()) ||
+                                            !filter.IsTypeIncluded(object.GetName(), object.GetFullName())))
+                        continue;
+
+                    pending.push_back(object.GetIndex());
+                }
             }
+        }
+    }
+
+    std::stable_sort(parts.begin(), parts.end(), [&packagesFirstIndex](const ClosurePart &a, const ClosurePart &b)
+    {
+        int32_t ia = packagesFirstIndex[a.Package], ib = packagesFirstIndex[b.Package];
+        return ia != ib ? ia < ib : a.Round < b.Round;
+    });
+
+    for (auto &part : parts)
+        graph.Append(std::move(part.Graph));
+
+    logsBufferFmt.append("Roots: {}\nRounds: {}\nPackages: {}\n", _rootTypes.size(), round, graph.Packages.size());
+    logsBufferFmt.append("Types: {}\nMembers: {}\nFunctions: {}\nNames: {}\n",
+                         graph.Types.size(), graph.Members.size(), graph.Functions.size(), graph.GetNamesCount());
+    logsBufferFmt.append("==========================\n");
+}
+
+void UEDumper::AcquireReflectionGraph(BufferFmt &logsBufferFmt, UEPackagesArray &packages, UEReflectionGraph &graph, const ProgressCallback &progressCallback)
+{
+    TRACE_SCOPE("UEDumper::AcquireReflectionGraph");
 
-            if (package.Classes.size())
+    logsBufferFmt.append("Acquiring reflection data...\n");
+
+    SimpleProgressBar acquireProgress(int(packages.size()));
+    if (progressCallback)
+        progressCallback(acquireProgress);
+
+    // packages are read concurrently into their own graphs, then appended in the original order
+    std::vector<UEReflectionGraph> parts(packages.size());
+    std::atomic<int> packagesDone{0};
+
+    TaskGroup acquireTasks;
+    for (size_t i = 0; i < packages.size(); i++)
+    {
+        acquireTasks.run([&packages, &parts, &packagesDone, typeTrees = _usmap, i]
+        {
             {
-                auto pkgClasses = package.Classes;
+                TRACE_SCOPE_DETAIL("UEReflectionGraph::AcquirePackage", UE_UObject(packages[i].first).GetName());
+                parts[i] = UEReflectionGraph::AcquirePackage(packages[i].first, packages[i].second, typeTrees);
+            }
+            packagesDone++;
+        });
+    }
+
+    // progress is only reported from this thread
+    while (!acquireTasks.waitFor(std::chrono::milliseconds(50)))
+    {
+        acquireProgress.setCurrent(packagesDone.load());
+        if (progressCallback)
+            progressCallback(acquireProgress);
+    }
+    acquireTasks.wait();
+
+    acquireProgress.setCurrent(int(packages.size()));
+    if (progressCallback)
+        progressCallback(acquireProgress);
+
+    for (auto &part : parts)
+        graph.Append(std::move(part));
+
+    logsBufferFmt.append("Types: {}\nMembers: {}\nFunctions: {}\nNames: {}\n",
+                         graph.Types.size(), graph.Members.size(), graph.Functions.size(), graph.GetNamesCount());
+    logsBufferFmt.append("==========================\n");
+}
+
+void UEDumper::DumpAIOHeader(BufferFmt &logsBufferFmt, BufferFmt &aioBufferFmt, BufferFmt &scriptBufferFmt, const UEReflectionGraph &graph, SDKDatabaseWriter *dbWriter)
+{
+    TRACE_SCOPE("UEDumper::DumpAIOHeader");
+
+    int packages_saved = 0;
+    std::string packages_unsaved{};
+
+    int classes_saved = 0;
+    int structs_saved = 0;
+    int enums_saved = 0;
+
+    aioBufferFmt.append("#pragma once\n\n#include <cstdio>\n#include <string>\n#include <cstdint>\n\n\n");
+
+    // sdk layout, each package header includes the packages it depends on that come before it
+    // in dependency order, SDK.hpp includes them all in that order
+    const std::string sdkDirectory = _outputDirectory + "/SDK";
+    bool sdkLayout = _sdkLayout && !_outputDirectory.empty();
+    if (sdkLayout && IOUtils::mkdir_recursive(sdkDirectory, 0777) == -1)
+    {
+        logsBufferFmt.append("Couldn't create SDK directory.\n");
+        sdkLayout = false;
+    }
 
-                if (excludedObjects.size())
+    std::vector<std::vector<uint32_t>> sdkDependencies;
+    std::vector<uint32_t> sdkOrder, sdkOrderPos;
+    std::vector<std::string> sdkFileNames;
+    if (sdkLayout)
+    {
+        sdkDependencies = graph.GetPackagesDependencies();
+        sdkOrder = UEReflectionGraph::TopologicalOrder(sdkDependencies);
+
+        sdkOrderPos.resize(sdkOrder.size());
+        for (uint32_t i = 0; i < uint32_t(sdkOrder.size()); i++)
+            sdkOrderPos[sdkOrder[i]] = i;
+
+        std::unordered_map<std::string, int> fileNamesCount;
+        for (const auto &pkg : graph.Packages)
+        {
+            std::string fileName = IOUtils::replace_specials(graph.GetName(pkg.Name), '_');
+            int n = fileNamesCount[fileName]++;
+            if (n > 0)
+                fileName += "_" + std::to_string(n);
+            sdkFileNames.push_back(fileName + ".hpp");
+        }
+    }
+
+    const uintptr_t baseAddress = _profile->GetUnrealELF().base();
+
+    // types are emitted in dependency order across packages so supers, by value structs & enums are always
+    // defined before use. each package is one run of types unless it's in a cycle with other packages,
+    // then it's split into several runs where the cycle needs the other package's types first
+    std::vector<UEReflectionGraph::PackageRun> runs;
+    std::vector<uint32_t> packagesRunsCount(graph.Packages.size(), 0);
+    {
+        const auto typesPackages = graph.GetTypesPackages();
+        const auto typesDependencies = graph.GetTypesDependencies();
+
+        std::vector<std::vector<uint32_t>> packagesDependencies(graph.Packages.size());
+        std::vector<uint32_t> lastAdded(graph.Packages.size(), UINT32_MAX);
+        for (uint32_t p = 0; p < uint32_t(graph.Packages.size()); p++)
+        {
+            const auto &pkg = graph.Packages[p];
+            for (uint32_t t = pkg.FirstType; t < pkg.FirstType + pkg.TypesCount; t++)
+            {
+                for (uint32_t dep : typesDependencies[t])
                 {
-                    pkgClasses.erase(
-                        std::remove_if(pkgClasses.begin(), pkgClasses.end(),
-                                       [&excludedObjects](const UE_UPackage::Struct &it)
-                    { return kVECTOR_CONTAINS(excludedObjects, it.FullName); }),
-                        pkgClasses.end());
+                    uint32_t depPackage = typesPackages[dep];
+                    if (depPackage != p && lastAdded[depPackage] != p)
+                    {
+                        lastAdded[depPackage] = p;
+                        packagesDependencies[p].push_back(depPackage);
+                    }
                 }
+            }
+        }
+
+        const auto packagesOrder = UEReflectionGraph::TopologicalOrder(packagesDependencies);
+        runs = UEReflectionGraph::PackageRuns(typesDependencies, typesPackages, packagesOrder);
 
-                UE_UPackage::AppendStructsToBuffer(package.Classes, &aioBufferFmt);
+        // packages without types get an empty run so they're still reported
+        for (const auto &run : runs)
+            packagesRunsCount[run.Package]++;
+        for (uint32_t p : packagesOrder)
+        {
+            if (packagesRunsCount[p] == 0)
+            {
+                runs.push_back({p, {}});
+                packagesRunsCount[p] = 1;
             }
         }
-        else
+
+        std::string splitPackages;
+        for (uint32_t p : packagesOrder)
+        {
+            if (packagesRunsCount[p] > 1)
+                splitPackages += fmt::format("\t{} ({} parts),\n", graph.GetName(graph.Packages[p].Name), packagesRunsCount[p]);
+        }
+
+        if (!splitPackages.empty())
+        {
+            logsBufferFmt.append("Packages split by cycles in the AIO header:\n[\n{}]\n", splitPackages);
+            logsBufferFmt.append("==========================\n");
+        }
+    }
+
+    // runs are generated concurrently, each into its own buffer,
+    // then concatenated in runs order to keep the output reproducible
+    struct RunResult
+    {
+        std::string Name;
+        bool Saved = false;
+        size_t Classes = 0, Structs = 0, Enums = 0;
+        BufferFmt Buffer;
+        std::vector<dumper_jf_ns::JsonFunction> JsonFunctions;
+        // UObject::ProcessInternal candidate in JsonFunctions, only the first run's one is kept
+        int ProcessInternalIndex = -1;
+        SDKDatabaseWriter::Fragment Database;
+    };
+
+    std::vector<RunResult> results(runs.size());
+
+    // part of each run in its package, 1 based
+    std::vector<uint32_t> runsPart(runs.size());
+    {
+        std::vector<uint32_t> partsSeen(graph.Packages.size(), 0);
+        for (size_t i = 0; i < runs.size(); i++)
+            runsPart[i] = ++partsSeen[runs[i].Package];
+    }
+
+    auto writePackageHeader = [&](size_t index, std::string_view content)
+    {
+        BufferFmt headerBufferFmt;
+        headerBufferFmt.append("#pragma once\n\n#include <cstdio>\n#include <string>\n#include <cstdint>\n\n");
+
+        for (uint32_t dep : sdkDependencies[index])
         {
-            packages_unsaved += "\t";
-            packages_unsaved += (package.GetObject().GetName() + ",\n");
-            continue;
+            if (sdkOrderPos[dep] < sdkOrderPos[index])
+                headerBufferFmt.append("#include \"{}\"\n", sdkFileNames[dep]);
+            else
+                headerBufferFmt.append("// cyclic: {}\n", sdkFileNames[dep]);
         }
 
-        packages_saved++;
-        classes_saved += package.Classes.size();
-        structs_saved += package.Structures.size();
-        enums_saved += package.Enums.size();
+        headerBufferFmt.append("\n\n{}", content);
+        return headerBufferFmt.writeBufferToFile(sdkDirectory + "/" + sdkFileNames[index]);
+    };
+
+    std::atomic<int> sdkHeadersFailed{0};
+
+    auto processRun = [&graph, &runs, &results, &runsPart, &packagesRunsCount, &sdkLayout, &writePackageHeader, &sdkHeadersFailed, dbWriter, baseAddress](size_t index)
+    {
+        const auto &run = runs[index];
+        UE_UPackage package(graph, run.Package);
+        RunResult &result = results[index];
+
+        {
+            TRACE_SCOPE_DETAIL("UE_UPackage::Process", package.GetName());
+            package.Process(run.Types);
+        }
+
+        result.Name = package.GetName();
+
+        if (!package.Classes.size() && !package.Structures.size() && !package.Enums.size())
+            return;
+
+        result.Saved = true;
+        result.Classes = package.Classes.size();
+        result.Structs = package.Structures.size();
+        result.Enums = package.Enums.size();
+
+        BufferFmt *pkgBufferFmt = &result.Buffer;
+
+        if (packagesRunsCount[run.Package] > 1)
+            pkgBufferFmt->append("// Package: {} (part {} of {})\n", result.Name, runsPart[index], packagesRunsCount[run.Package]);
+        else
+            pkgBufferFmt->append("// Package: {}\n", result.Name);
+
+        pkgBufferFmt->append("// Enums: {}\n// Structs: {}\n// Classes: {}\n\n",
+                             package.Enums.size(), package.Structures.size(), package.Classes.size());
+
+        if (package.Enums.size())
+            UE_UPackage::AppendEnumsToBuffer(package.Enums, pkgBufferFmt);
+
+        if (package.Structures.size())
+            UE_UPackage::AppendStructsToBuffer(package.Structures, pkgBufferFmt);
+
+        if (package.Classes.size())
+            UE_UPackage::AppendStructsToBuffer(package.Classes, pkgBufferFmt);
+
+        if (dbWriter)
+        {
+            TRACE_SCOPE("SDKDatabaseWriter::BuildFragment");
+            result.Database = SDKDatabaseWriter::BuildFragment(result.Name, package.Enums, package.Structures, package.Classes, baseAddress);
+        }
 
         for (const auto &cls : package.Classes)
         {
             for (const auto &func : cls.Functions)
             {
                 // UObject::ProcessInternal for blueprint functions
-                if (!processInternal_once && (func.EFlags & FUNC_BlueprintEvent) && func.Func)
+                if (result.ProcessInternalIndex < 0 && (func.EFlags & FUNC_BlueprintEvent) && func.Func)
                 {
-                    dumper_jf_ns::jsonFunctions.push_back({"UObject", "ProcessInternal", func.Func});
-                    processInternal_once = true;
+                    result.ProcessInternalIndex = int(result.JsonFunctions.size());
+                    result.JsonFunctions.push_back({"UObject", "ProcessInternal", func.Func});
                 }
 
                 if ((func.EFlags & FUNC_Native) && func.Func)
                 {
                     std::string execFuncName = "exec";
                     execFuncName += func.Name;
-                    dumper_jf_ns::jsonFunctions.push_back({cls.Name, execFuncName, func.Func});
+                    result.JsonFunctions.push_back({cls.Name, execFuncName, func.Func});
                 }
             }
         }
@@ -444,10 +1175,154 @@ void UEDumper::DumpAIOHeader(BufferFmt &logsBufferFmt, BufferFmt &aioBufferFmt,
                 {
                     std::string execFuncName = "exec";
                     execFuncName += func.Name;
-                    dumper_jf_ns::jsonFunctions.push_back({st.Name, execFuncName, func.Func});
+                    result.JsonFunctions.push_back({st.Name, execFuncName, func.Func});
                 }
             }
         }
+
+        // split packages are put back together as their runs are committed
+        if (sdkLayout && packagesRunsCount[run.Package] == 1 && !writePackageHeader(run.Package, result.Buffer.readView()))
+            sdkHeadersFailed++;
+    };
+
+    bool processInternal_once = false;
+
+    // script.json functions are written as runs are committed
+    size_t jsonFunctionsCount = 0;
+    JsonWriter scriptJson(scriptBufferFmt);
+    scriptJson.beginObject();
+    scriptJson.key("Functions");
+    scriptJson.beginArray();
+
+    // per package, whether any of its runs was saved & what's kept of it until its last run is committed
+    std::vector<bool> packagesSaved(graph.Packages.size(), false);
+    std::vector<uint32_t> packagesRunsCommitted(graph.Packages.size(), 0);
+    std::unordered_map<uint32_t, BufferFmt> splitPackagesBuffers;
+    std::unordered_map<uint32_t, std::vector<SDKDatabaseWriter::Fragment>> splitPackagesDatabase;
+
+    auto commitResult = [&](size_t index)
+    {
+        TRACE_SCOPE("CommitPackage");
+
+        const uint32_t pkg = runs[index].Package;
+        RunResult &result = results[index];
+        const bool split = packagesRunsCount[pkg] > 1;
+        const bool lastRun = ++packagesRunsCommitted[pkg] == packagesRunsCount[pkg];
+
+        if (result.Saved)
+        {
+            packagesSaved[pkg] = true;
+
+            aioBufferFmt.append("{}", result.Buffer.readView());
+
+            classes_saved += result.Classes;
+            structs_saved += result.Structs;
+            enums_saved += result.Enums;
+
+            for (size_t i = 0; i < result.JsonFunctions.size(); i++)
+            {
+                if (int(i) == result.ProcessInternalIndex)
+                {
+                    if (processInternal_once)
+                        continue;
+
+                    processInternal_once = true;
+                }
+
+                if (dumper_jf_ns::WriteJsonFunction(scriptJson, result.JsonFunctions[i], baseAddress))
+                    jsonFunctionsCount++;
+            }
+
+            if (split)
+            {
+                if (sdkLayout)
+                    splitPackagesBuffers[pkg].append("{}", result.Buffer.readView());
+                if (dbWriter)
+                    splitPackagesDatabase[pkg].push_back(std::move(result.Database));
+            }
+            else if (dbWriter)
+            {
+                dbWriter->Append(std::move(result.Database));
+            }
+        }
+
+        if (lastRun)
+        {
+            if (packagesSaved[pkg])
+            {
+                packages_saved++;
+            }
+            else
+            {
+                packages_unsaved += "\t";
+                packages_unsaved += (result.Name + ",\n");
+            }
+
+            // a split package stays one package in the SDK headers & database
+            if (split && packagesSaved[pkg])
+            {
+                if (sdkLayout && !writePackageHeader(pkg, splitPackagesBuffers[pkg].readView()))
+                    sdkHeadersFailed++;
+
+                if (dbWriter)
+                {
+                    auto &fragments = splitPackagesDatabase[pkg];
+                    for (size_t i = 0; i < fragments.size(); i++)
+                        dbWriter->Append(std::move(fragments[i]), i > 0);
+                }
+            }
+
+            splitPackagesBuffers.erase(pkg);
+            splitPackagesDatabase.erase(pkg);
+        }
+
+        result.Buffer = BufferFmt();
+        std::vector<dumper_jf_ns::JsonFunction>().swap(result.JsonFunctions);
+    };
+
+    // generation works on the local graph only, finished results are committed
+    // in runs order while the rest is generating so they don't pile up in memory
+    std::vector<std::atomic<bool>> resultsDone(results.size());
+    size_t nextResult = 0;
+
+    auto commitReady = [&]()
+    {
+        while (nextResult < runs.size() && resultsDone[nextResult].load())
+            commitResult(nextResult++);
+    };
+
+    TaskGroup dumpTasks;
+    for (size_t i = 0; i < runs.size(); i++)
+    {
+        dumpTasks.run([&processRun, &resultsDone, i]
+        {
+            processRun(i);
+            resultsDone[i] = true;
+        });
+    }
+
+    while (!dumpTasks.waitFor(std::chrono::milliseconds(50)))
+        commitReady();
+    dumpTasks.wait();
+    commitReady();
+
+    scriptJson.endArray();
+    scriptJson.endObject();
+
+    if (sdkLayout)
+    {
+        BufferFmt sdkBufferFmt;
+        sdkBufferFmt.append("#pragma once\n\n");
+        for (uint32_t index : sdkOrder)
+        {
+            if (packagesSaved[index])
+                sdkBufferFmt.append("#include \"{}\"\n", sdkFileNames[index]);
+        }
+
+        if (!sdkBufferFmt.writeBufferToFile(sdkDirectory + "/SDK.hpp"))
+            sdkHeadersFailed++;
+
+        logsBufferFmt.append("SDK headers: {} (failed {})\n", packages_saved, sdkHeadersFailed.load());
     }
 
     logsBufferFmt.append("Saved packages: {}\nSaved classes: {}\nSaved structs: {}\nSaved enums: {}\n", packages_saved, classes_saved, structs_saved, enums_saved);
@@ -458,5 +1333,7 @@ void UEDumper::DumpAIOHeader(BufferFmt &logsBufferFmt, BufferFmt &aioBufferFmt,
         logsBufferFmt.append("Unsaved packages: [\n{}\n]\n", packages_unsaved);
     }
 
+    logsBufferFmt.append("Script json functions: {}\n", jsonFunctionsCount);
+
     logsBufferFmt.append("==========================\n");
 }
@@ -7,17 +7,37 @@
 
 #include "UE/UEGameProfile.hpp"
 #include "UE/UEWrappers.hpp"
+#include "UE/UEReflectionGraph.hpp"
+#include "UE/UEDumpFilter.hpp"
+#include "UE/UEOffsetsCache.hpp"
+#include "UE/UEEngineVersion.hpp"
 
 #include "Utils/BufferFmt.hpp"
 #include "Utils/ProgressUtils.hpp"
 
 using ProgressCallback = std::function<void(const SimpleProgressBar &)>;
-using UEPackagesArray = std::vector<std::pair<uint8_t *const, std::vector<UE_UObject>>>;
+// package object -> GUObjectArray indices of its structs, classes, functions & enums
+using UEPackagesArray = std::vector<std::pair<uint8_t *const, std::vector<int32_t>>>;
 
 class UEDumper
 {
     IGameProfile const *_profile;
     std::string _lastError;
+    std::string _outputDirectory;
+    bool _sdkLayout = false;
+    bool _sdkDatabase = false;
+    bool _usmap = false;
+    bool _offsetsOnly = false;
+    bool _discoverOffsets = false;
+    UEDumpFilter _dumpFilter;
+    std::vector<std::string> _rootTypes;
+    std::string _cacheDirectory;
+    std::string _cachePath;
+    UEOffsetsCache _cache;
+    bool _cacheHit = false;
+    // fingerprinted on first use, or taken from the cache
+    mutable UEEngineVersion _engineVersion;
+    mutable bool _engineVersionReady = false;
     std::function<void(bool)> _dumpExeInfoNotify;
     std::function<void(bool)> _dumpNamesInfoNotify;
     std::function<void(bool)> _dumpObjectsInfoNotify;
@@ -28,14 +48,47 @@ class UEDumper
 public:
     UEDumper() : _profile(nullptr), _dumpExeInfoNotify(nullptr), _dumpNamesInfoNotify(nullptr), _dumpObjectsInfoNotify(nullptr), _objectsProgressCallback(nullptr), _dumpProgressCallback(nullptr) {}
 
-    bool Init(IGameProfile *profile);
+    // set the cache directory before it to reuse the pointers resolved for the same library build,
+    // knownPointers are used like cached ones when there's no cache, e.g. from profile detection
+    bool Init(IGameProfile *profile, const UE_Pointers *knownPointers = nullptr);
 
     bool Dump(std::unordered_map<std::string, BufferFmt> *outBuffersMap);
 
     const IGameProfile *GetProfile() const { return _profile; }
 
+    // read from the cache of the library build, or fingerprinted from the library the first time it's asked for
+    const UEEngineVersion &GetEngineVersion() const;
+
     std::string GetLastError() const { return _lastError; }
 
+    // Objects.txt & AIOHeader.hpp are streamed into this directory while dumping instead of being kept in memory
+    inline void setOutputDirectory(const std::string &dir) { _outputDirectory = dir; }
+
+    // Also write one header per package and an umbrella SDK.hpp into <output directory>/SDK
+    inline void setSDKLayout(bool enable) { _sdkLayout = enable; }
+
+    // Also write SDK.db, see SDKDatabase.hpp
+    inline void setSDKDatabase(bool enable) { _sdkDatabase = enable; }
+
+    // Also write Mappings.usmap, property type trees are read for it
+    inline void setUsmap(bool enable) { _usmap = enable; }
+
+    // Offsets caches are kept here, one file per UE library build
+    inline void setCacheDirectory(const std::string &dir) { _cacheDirectory = dir; }
+
+    // Stop after Offsets.hpp, objects aren't gathered
+    inline void setOffsetsOnly(bool enable) { _offsetsOnly = enable; }
+
+    // Infer the UObject, UStruct, UFunction & property offsets from the core objects and stop,
+    // a GetOffsets() to paste in the profile is written as DiscoveredOffsets.hpp
+    inline void setDiscoverOffsets(bool enable) { _discoverOffsets = enable; }
+
+    // Applied together with the profile rules before reading reflection data
+    inline void setDumpFilter(const UEDumpFilter &filter) { _dumpFilter = filter; }
+
+    // Only dump these types, by full name, and the supers, structs & enums they need by value
+    inline void setRootTypes(const std::vector<std::string> &fullNames) { _rootTypes = fullNames; }
+
     inline void setDumpExeInfoNotify(const std::function<void(bool)> &f) { _dumpExeInfoNotify = f; }
     inline void setDumpNamesInfoNotify(const std::function<void(bool)> &f) { _dumpNamesInfoNotify = f; }
     inline void setDumpObjectsInfoNotify(const std::function<void(bool)> &f) { _dumpObjectsInfoNotify = f; }
@@ -53,7 +106,22 @@ private:
 
     void DumpOffsetsInfo(BufferFmt &logsBufferFmt, BufferFmt &offsetsBufferFmt);
 
+    bool DumpDiscoveredOffsets(BufferFmt &logsBufferFmt, BufferFmt &profileBufferFmt);
+
+    // cheap reads to tell if cached Engine, World & ProcessEvent still hold
+    bool CheckCachedPointers(const UE_Pointers &pointers) const;
+
     void GatherUObjects(BufferFmt &logsBufferFmt, BufferFmt &objsBufferFmt, UEPackagesArray &packages, const ProgressCallback &progressCallback);
 
-    void DumpAIOHeader(BufferFmt &logsBufferFmt, BufferFmt &aioBufferFmt, UEPackagesArray &packages, const ProgressCallback &progressCallback);
+    // dump filter with the profile rules & excluded objects
+    UEDumpFilter MakeDumpFilter(BufferFmt &logsBufferFmt) const;
+
+    void FilterPackages(BufferFmt &logsBufferFmt, UEPackagesArray &packages);
+
+    void AcquireTypesClosure(BufferFmt &logsBufferFmt, UEReflectionGraph &graph);
+
+    void AcquireReflectionGraph(BufferFmt &logsBufferFmt, UEPackagesArray &packages, UEReflectionGraph &graph, const ProgressCallback &progressCallback);
+
+    // dbWriter is optional, it gets the same generated packages as the header
+    void DumpAIOHeader(BufferFmt &logsBufferFmt, BufferFmt &aioBufferFmt, BufferFmt &scriptBufferFmt, const UEReflectionGraph &graph, class SDKDatabaseWriter *dbWriter);
 };
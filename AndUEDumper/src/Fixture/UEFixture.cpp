@@ -0,0 +1,1096 @@
+// Synthetic UE world for running the dumper on a Linux host without a phone or a game.
+// Names, GUObjectArray and the reflection graph are laid out in this process with the
+// UE_DefaultOffsets table of the chosen engine version, then it waits to be dumped.
+//
+// build, from src:
+//   g++ -std=c++17 -O2 -rdynamic -I. Fixture/UEFixture.cpp UE/UEDefaultOffsets.cpp -o UEFixture
+// or both the fixture and the host dumper, from AndUEDumper:
+//   cmake -S . -B build-host -DCMAKE_BUILD_TYPE=Release && cmake --build build-host
+//
+// run, the file must be named UEFixture so the dumper can find it:
+//   ./UEFixture --engine 4.27 --classes 20000
+//   ./UEDump3r_x86_64 -p UEFixture -o /tmp/out
+//
+// AndUEDumper/fixture.sh does both and checks the dumped objects & types counts against the fixture's
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <getopt.h>
+#include <map>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+#include "UEFixtureConfig.hpp"
+#include "../UE/UEOffsets.hpp"
+
+#define FIXTURE_EXPORT __attribute__((visibility("default"), used))
+
+namespace
+{
+    constexpr size_t kArenaChunkSize = 64 << 20;
+    // slack after each chunk, the dumper reads objects in fixed size blocks
+    constexpr size_t kArenaGuard = 0x1000;
+
+    constexpr size_t kMaxNameBlocks = 8192;
+    constexpr size_t kNameBlocksDataSize = 0x100 + kMaxNameBlocks * sizeof(void *);
+    constexpr int32_t kGNamesPerChunk = 16384;
+    constexpr int32_t kGNamesMaxChunks = (2 * 1024 * 1024) / kGNamesPerChunk;
+
+    constexpr size_t kVTableSize = 0x80;
+    constexpr size_t kProcessEventIndex = 0x44;
+
+    // EObjectFlags
+    constexpr uint32_t kObjectFlagsNative = 0x1 | 0x4;
+    constexpr uint32_t kObjectFlagsDefault = 0x1 | 0x10 | 0x20;
+
+    // EPropertyFlags
+    constexpr uint64_t kPropertyFlagsMember = 0x1 | 0x4;
+    constexpr uint64_t kPropertyFlagsZeroConstructor = 0x200;
+    constexpr uint64_t kPropertyFlagsParm = 0x80;
+    constexpr uint64_t kPropertyFlagsReturnParm = 0x80 | 0x100 | 0x400;
+
+    // EFunctionFlags
+    constexpr uint32_t kFunctionFlagsNative = 0x1 | 0x400 | 0x20000 | 0x4000000;
+
+    const char *const kMemberWords[] = {"Health", "Speed", "Target", "Owner", "Mesh", "Ammo", "Level", "Score",
+                                        "Team", "Location", "Rotation", "Tags", "Mode", "State", "Count", "Scale",
+                                        "Damage", "Radius", "Weapon", "Item", "Skill", "Cooldown", "Timer", "Color"};
+
+    const char *const kFunctionVerbs[] = {"Get", "Set", "On", "Server", "Client", "Is", "Apply", "Reset"};
+}  // namespace
+
+// looked up by the Fixture profile, like the symbols some real UE libraries export
+extern "C"
+{
+    FIXTURE_EXPORT UEFixtureConfig GFixtureConfig = {};
+    alignas(16) FIXTURE_EXPORT uint8_t GUObjectArray[0x100] = {};
+    alignas(16) FIXTURE_EXPORT uint8_t NamePoolData[kNameBlocksDataSize] = {};
+    FIXTURE_EXPORT uint8_t **GNameBlocksDebug = nullptr;
+    FIXTURE_EXPORT uint8_t **GFNameTableForDebuggerVisualizers_MT = nullptr;
+}
+
+// UObject::ProcessEvent(UFunction*, void*), IGameProfile::findProcessEvent matches it in the vtable
+FIXTURE_EXPORT void FixtureProcessEvent(void *object, void *function, void *params) __asm__("_ZN7UObject12ProcessEventEP9UFunctionPv");
+
+namespace
+{
+    // distinct side effects so the linker doesn't fold them into one address
+    volatile int gVirtualCalls = 0;
+    volatile int gNativeCalls = 0;
+    volatile int gProcessEventCalls = 0;
+
+    __attribute__((noinline)) void FixtureVirtual(void *) { gVirtualCalls = gVirtualCalls + 1; }
+    __attribute__((noinline)) void FixtureNative(void *, void *, void *) { gNativeCalls = gNativeCalls + 1; }
+
+    void *gVTable[kVTableSize] = {};
+}  // namespace
+
+void FixtureProcessEvent(void *, void *, void *) { gProcessEventCalls = gProcessEventCalls + 1; }
+
+namespace
+{
+    template <typename T>
+    inline void Put(uint8_t *base, uintptr_t offset, T value)
+    {
+        memcpy(base + offset, &value, sizeof(T));
+    }
+
+    inline size_t AlignUp(size_t value, size_t align)
+    {
+        return (value + align - 1) & ~(align - 1);
+    }
+
+    void *CheckedCalloc(size_t count, size_t size)
+    {
+        void *p = calloc(count, size);
+        if (!p)
+        {
+            fprintf(stderr, "Out of memory.\n");
+            exit(1);
+        }
+        return p;
+    }
+
+    // bump allocator, objects end up packed in a few big heap regions like a real UObject allocator
+    class FixtureArena
+    {
+    public:
+        uint8_t *Alloc(size_t size, size_t align = 16)
+        {
+            size_t at = AlignUp(_used, align);
+            if (!_chunk || at + size > _chunkSize)
+            {
+                _chunkSize = std::max(kArenaChunkSize, size);
+                _chunk = (uint8_t *)CheckedCalloc(1, _chunkSize + kArenaGuard);
+                at = 0;
+            }
+            _used = at + size;
+            return _chunk + at;
+        }
+
+    private:
+        uint8_t *_chunk = nullptr;
+        size_t _chunkSize = 0;
+        size_t _used = 0;
+    };
+
+    // FNamePool blocks for UE 4.23 and above, GNames chunks before
+    class FixtureNames
+    {
+    public:
+        FixtureNames(const UE_Offsets &offsets, FixtureArena &arena) : _offsets(offsets), _arena(arena)
+        {
+            if (_offsets.Config.IsUsingFNamePool)
+                _blockBytes = _offsets.FNamePool.Stride << _offsets.FNamePool.BlocksBit;
+            else
+                _gnames = (uint8_t **)CheckedCalloc(kGNamesMaxChunks + 1, sizeof(void *));
+
+            // id 0
+            Add("None");
+        }
+
+        int32_t Add(const std::string &name)
+        {
+            auto it = _ids.find(name);
+            if (it != _ids.end())
+                return it->second;
+
+            int32_t id = _offsets.Config.IsUsingFNamePool ? addPoolEntry(name) : addGNamesEntry(name);
+            _ids.emplace(name, id);
+            return id;
+        }
+
+        void PutName(uint8_t *at, const std::string &name)
+        {
+            int32_t id = Add(name);
+            Put<int32_t>(at, _offsets.FName.ComparisonIndex, id);
+            if (_offsets.Config.isUsingCasePreservingName)
+                Put<int32_t>(at, _offsets.FName.DisplayIndex, id);
+            if (!_offsets.Config.isUsingOutlineNumberName)
+                Put<int32_t>(at, _offsets.FName.Number, 0);
+        }
+
+        size_t Count() const { return _ids.size(); }
+
+        void Publish()
+        {
+            if (_offsets.Config.IsUsingFNamePool)
+            {
+                // FNameEntryAllocator: CurrentBlock & CurrentByteCursor right before Blocks
+                Put<uint32_t>(NamePoolData, _offsets.FNamePool.BlocksOff - sizeof(uint32_t) * 2, _currentBlock);
+                Put<uint32_t>(NamePoolData, _offsets.FNamePool.BlocksOff - sizeof(uint32_t), uint32_t(_cursor));
+                GNameBlocksDebug = (uint8_t **)(NamePoolData + _offsets.FNamePool.BlocksOff);
+            }
+            else
+            {
+                // TStaticIndirectArrayThreadSafeRead: Chunks, NumElements, NumChunks
+                int32_t count = int32_t(_ids.size());
+                int32_t counts[2] = {count, (count + kGNamesPerChunk - 1) / kGNamesPerChunk};
+                memcpy(&_gnames[kGNamesMaxChunks], counts, sizeof(counts));
+                GFNameTableForDebuggerVisualizers_MT = _gnames;
+            }
+        }
+
+    private:
+        int32_t addPoolEntry(const std::string &name)
+        {
+            const size_t stride = _offsets.FNamePool.Stride;
+            const size_t len = std::min<size_t>(name.size(), 1023);
+            const size_t entryBytes = AlignUp(_offsets.FNamePoolEntry.Header + sizeof(uint16_t) + len, stride);
+
+            uint8_t **blocks = (uint8_t **)(NamePoolData + _offsets.FNamePool.BlocksOff);
+            if (!blocks[_currentBlock] || _cursor + entryBytes > _blockBytes)
+            {
+                if (blocks[_currentBlock])
+                    _currentBlock++;
+                if (_currentBlock >= kMaxNameBlocks)
+                {
+                    fprintf(stderr, "Names pool is full.\n");
+                    exit(1);
+                }
+                blocks[_currentBlock] = (uint8_t *)CheckedCalloc(1, _blockBytes + kArenaGuard);
+                _cursor = 0;
+            }
+
+            uint8_t *entry = blocks[_currentBlock] + _cursor;
+            int32_t id = int32_t((_currentBlock << _offsets.FNamePool.BlocksBit) | (_cursor / stride));
+
+            // case preserving entries start with their ComparisonId
+            if (_offsets.FNamePoolEntry.Header >= sizeof(int32_t))
+                Put<int32_t>(entry, 0, id);
+
+            uint16_t header = _offsets.Config.isUsingCasePreservingName ? uint16_t(len << 1) : uint16_t(len << 6);
+            Put<uint16_t>(entry, _offsets.FNamePoolEntry.Header, header);
+            memcpy(entry + _offsets.FNamePoolEntry.Header + sizeof(uint16_t), name.data(), len);
+
+            _cursor += entryBytes;
+            return id;
+        }
+
+        int32_t addGNamesEntry(const std::string &name)
+        {
+            int32_t id = int32_t(_ids.size());
+            int32_t chunk = id / kGNamesPerChunk;
+            if (chunk >= kGNamesMaxChunks)
+            {
+                fprintf(stderr, "GNames is full.\n");
+                exit(1);
+            }
+            if (!_gnames[chunk])
+                _gnames[chunk] = (uint8_t *)CheckedCalloc(kGNamesPerChunk, sizeof(void *));
+
+            // FNameEntry: HashNext, Index (id << 1, bit 0 is wide) and the null terminated name
+            uint8_t *entry = _arena.Alloc(_offsets.FNameEntry.Name + name.size() + 1, sizeof(void *));
+            Put<int32_t>(entry, _offsets.FNameEntry.Index, id << 1);
+            memcpy(entry + _offsets.FNameEntry.Name, name.c_str(), name.size() + 1);
+
+            ((uint8_t **)_gnames[chunk])[id % kGNamesPerChunk] = entry;
+            return id;
+        }
+
+        const UE_Offsets &_offsets;
+        FixtureArena &_arena;
+        std::unordered_map<std::string, int32_t> _ids;
+
+        size_t _blockBytes = 0;
+        uint32_t _currentBlock = 0;
+        size_t _cursor = 0;
+
+        uint8_t **_gnames = nullptr;
+    };
+
+    enum class EPropKind : uint8_t
+    {
+        Int,
+        Int64,
+        Float,
+        Double,
+        Bool,
+        BitBool,
+        Byte,
+        Enum,
+        Name,
+        Str,
+        Object,
+        Class,
+        Struct,
+        Array,
+    };
+
+    const char *PropertyClassName(EPropKind kind)
+    {
+        switch (kind)
+        {
+        case EPropKind::Int: return "IntProperty";
+        case EPropKind::Int64: return "Int64Property";
+        case EPropKind::Float: return "FloatProperty";
+        case EPropKind::Double: return "DoubleProperty";
+        case EPropKind::Bool:
+        case EPropKind::BitBool: return "BoolProperty";
+        case EPropKind::Byte: return "ByteProperty";
+        case EPropKind::Enum: return "EnumProperty";
+        case EPropKind::Name: return "NameProperty";
+        case EPropKind::Str: return "StrProperty";
+        case EPropKind::Object: return "ObjectProperty";
+        case EPropKind::Class: return "ClassProperty";
+        case EPropKind::Struct: return "StructProperty";
+        case EPropKind::Array: return "ArrayProperty";
+        }
+        return "Property";
+    }
+
+    struct PropSpec
+    {
+        EPropKind Kind = EPropKind::Int;
+        std::string Name;
+        uint64_t Flags = kPropertyFlagsMember;
+        // struct, property class or enum
+        uint8_t *Sub = nullptr;
+        EPropKind InnerKind = EPropKind::Int;
+        uint8_t *InnerSub = nullptr;
+    };
+
+    // FProperty and UProperty have the same fields at different offsets
+    struct PropertyFields
+    {
+        uintptr_t ArrayDim, ElementSize, PropertyFlags, Offset_Internal, Size;
+    };
+
+    struct FixtureOptions
+    {
+        int EngineMajor = 4;
+        int EngineMinor = 27;
+        bool CasePreservingName = false;
+        bool OutlineNumberName = false;
+        int Classes = 2000;
+        int Structs = 400;
+        int Enums = 200;
+        int Properties = 10;
+        int Functions = 3;
+        uint32_t Seed = 1;
+        int ExitAfter = 0;
+    };
+
+    class FixtureWorld
+    {
+    public:
+        FixtureWorld(const UE_Offsets &offsets, FixtureNames &names, FixtureArena &arena, const FixtureOptions &options)
+            : _offsets(offsets), _names(names), _arena(arena), _options(options), _rng(options.Seed)
+        {
+            _useFField = _offsets.UStruct.ChildProperties > 0;
+            _largeWorld = options.EngineMajor >= 5;
+
+            const auto &props = _useFField ? PropertyFields{_offsets.FProperty.ArrayDim, _offsets.FProperty.ElementSize, _offsets.FProperty.PropertyFlags, _offsets.FProperty.Offset_Internal, _offsets.FProperty.Size}
+                                           : PropertyFields{_offsets.UProperty.ArrayDim, _offsets.UProperty.ElementSize, _offsets.UProperty.PropertyFlags, _offsets.UProperty.Offset_Internal, _offsets.UProperty.Size};
+            _props = props;
+
+            _structObjectSize = AlignUp(std::max({_offsets.UFunction.Func, _offsets.UFunction.ParamSize, _offsets.UStruct.PropertiesSize}) + 0x40, 0x10);
+        }
+
+        void Build()
+        {
+            buildCore();
+            buildEngine();
+            buildGame();
+
+            // Default__ objects last, they need the final class sizes
+            for (uint8_t *cls : _classes)
+            {
+                const auto &info = _structs[cls];
+                newObject(cls, _outers[cls], "Default__" + _classNames[cls], kObjectFlagsDefault, std::max<size_t>(info.Size, _offsets.UField.Next));
+            }
+        }
+
+        // GUObjectArray: FUObjectArray header then TUObjectArray, chunked since UE 4.20
+        void Publish(uint8_t *objectArray) const
+        {
+            const int32_t count = int32_t(_objects.size());
+            const size_t itemSize = _offsets.FUObjectItem.Size;
+            uint8_t *objObjects = objectArray + _offsets.FUObjectArray.ObjObjects;
+
+            // ObjFirstGCIndex, ObjLastNonGCIndex, MaxObjectsNotConsideredByGC, OpenForDisregardForGC
+            Put<int32_t>(objectArray, 0, 0);
+            Put<int32_t>(objectArray, sizeof(int32_t), count - 1);
+            Put<int32_t>(objectArray, sizeof(int32_t) * 2, count);
+
+            auto fillItem = [&](uint8_t *item, int32_t index)
+            {
+                Put<uint8_t *>(item, _offsets.FUObjectItem.Object, _objects[index]);
+            };
+
+            const int32_t perChunk = int32_t(_offsets.TUObjectArray.NumElementsPerChunk);
+            if (perChunk <= 0)
+            {
+                uint8_t *items = (uint8_t *)CheckedCalloc(count, itemSize);
+                for (int32_t i = 0; i < count; i++)
+                    fillItem(items + i * itemSize, i);
+
+                Put<uint8_t *>(objObjects, _offsets.TUObjectArray.Objects, items);
+                Put<int32_t>(objObjects, _offsets.TUObjectArray.NumElements - sizeof(int32_t), count);
+            }
+            else
+            {
+                const int32_t numChunks = (count + perChunk - 1) / perChunk;
+                uint8_t **chunks = (uint8_t **)CheckedCalloc(numChunks, sizeof(void *));
+                for (int32_t c = 0; c < numChunks; c++)
+                {
+                    chunks[c] = (uint8_t *)CheckedCalloc(perChunk, itemSize);
+                    for (int32_t i = c * perChunk; i < std::min(count, (c + 1) * perChunk); i++)
+                        fillItem(chunks[c] + (i - c * perChunk) * itemSize, i);
+                }
+
+                // Objects, PreAllocatedObjects, MaxElements, NumElements, MaxChunks, NumChunks
+                Put<uint8_t **>(objObjects, _offsets.TUObjectArray.Objects, chunks);
+                Put<int32_t>(objObjects, _offsets.TUObjectArray.NumElements - sizeof(int32_t), numChunks * perChunk);
+                Put<int32_t>(objObjects, _offsets.TUObjectArray.NumElements + sizeof(int32_t), numChunks);
+                Put<int32_t>(objObjects, _offsets.TUObjectArray.NumElements + sizeof(int32_t) * 2, numChunks);
+            }
+
+            Put<int32_t>(objObjects, _offsets.TUObjectArray.NumElements, count);
+        }
+
+        size_t Count() const { return _objects.size(); }
+        size_t FieldsCount() const { return _fieldsCount; }
+        // classes, script structs & enums
+        size_t TypesCount() const { return _classes.size() + _scriptStructs.size() + _enums.size(); }
+
+    private:
+        struct StructInfo
+        {
+            int32_t Size = 0;
+            int32_t Align = 1;
+        };
+
+        uint8_t *newObject(uint8_t *objectClass, uint8_t *outer, const std::string &name, uint32_t flags, size_t size)
+        {
+            uint8_t *object = _arena.Alloc(std::max<size_t>(size, _offsets.UField.Next));
+            Put<void **>(object, 0, gVTable);
+            Put<uint32_t>(object, _offsets.UObject.ObjectFlags, flags);
+            Put<int32_t>(object, _offsets.UObject.InternalIndex, int32_t(_objects.size()));
+            Put<uint8_t *>(object, _offsets.UObject.ClassPrivate, objectClass);
+            _names.PutName(object + _offsets.UObject.NamePrivate, name);
+            Put<uint8_t *>(object, _offsets.UObject.OuterPrivate, outer);
+            _objects.push_back(object);
+            return object;
+        }
+
+        void setClass(uint8_t *object, uint8_t *objectClass)
+        {
+            Put<uint8_t *>(object, _offsets.UObject.ClassPrivate, objectClass);
+        }
+
+        // class, script struct or function, members follow the super's
+        uint8_t *newStruct(uint8_t *structClass, uint8_t *super, uint8_t *outer, const std::string &name)
+        {
+            uint8_t *object = newObject(structClass, outer, name, kObjectFlagsNative, _structObjectSize);
+            Put<uint8_t *>(object, _offsets.UStruct.SuperStruct, super);
+
+            StructInfo info = super ? _structs[super] : StructInfo{};
+            setStructInfo(object, info);
+            return object;
+        }
+
+        uint8_t *newClass(uint8_t *super, uint8_t *package, const std::string &name)
+        {
+            uint8_t *cls = newStruct(_classClass, super, package, name);
+            _classes.push_back(cls);
+            _classNames[cls] = name;
+            _outers[cls] = package;
+            return cls;
+        }
+
+        void setStructInfo(uint8_t *object, const StructInfo &info)
+        {
+            _structs[object] = info;
+            Put<int32_t>(object, _offsets.UStruct.PropertiesSize, info.Size);
+            // MinAlignment
+            Put<int32_t>(object, _offsets.UStruct.PropertiesSize + sizeof(int32_t), info.Align);
+        }
+
+        void link(uint8_t *owner, uintptr_t headOffset, uintptr_t nextOffset, uint8_t *field)
+        {
+            uint8_t *&last = _lastLinked[{owner, headOffset}];
+            if (last)
+                Put<uint8_t *>(last, nextOffset, field);
+            else
+                Put<uint8_t *>(owner, headOffset, field);
+            last = field;
+        }
+
+        std::pair<int32_t, int32_t> kindLayout(EPropKind kind, uint8_t *sub)
+        {
+            switch (kind)
+            {
+            case EPropKind::Int:
+            case EPropKind::Float:
+                return {4, 4};
+            case EPropKind::Int64:
+            case EPropKind::Double:
+            case EPropKind::Object:
+            case EPropKind::Class:
+                return {8, 8};
+            case EPropKind::Bool:
+            case EPropKind::BitBool:
+            case EPropKind::Byte:
+            case EPropKind::Enum:
+                return {1, 1};
+            case EPropKind::Name:
+                return {int32_t(_offsets.FName.Size), 4};
+            case EPropKind::Str:
+            case EPropKind::Array:
+                return {16, 8};
+            case EPropKind::Struct:
+            {
+                const auto &info = _structs[sub];
+                return {info.Size, info.Align};
+            }
+            }
+            return {4, 4};
+        }
+
+        uint8_t *newPropertyClass(const char *name, const char *super)
+        {
+            if (_useFField)
+            {
+                // FFieldClass: Name, Id, CastFlags, ClassFlags, SuperClass, DefaultObject
+                const size_t nameSize = AlignUp(_offsets.FName.Size, sizeof(void *));
+                uint8_t *fieldClass = _arena.Alloc(nameSize + sizeof(uint64_t) * 3 + sizeof(void *) * 2, sizeof(void *));
+                _names.PutName(fieldClass, name);
+                Put<uint64_t>(fieldClass, nameSize, _propertyClasses.size() + 1);
+                Put<uint8_t *>(fieldClass, nameSize + sizeof(uint64_t) * 3, super ? _propertyClasses[super] : nullptr);
+                _propertyClasses[name] = fieldClass;
+                return fieldClass;
+            }
+
+            uint8_t *cls = newClass(super ? _propertyClasses[super] : _fieldClass, _corePackage, name);
+            setStructInfo(cls, {int32_t(_props.Size + sizeof(void *) * 2), int32_t(sizeof(void *))});
+            _propertyClasses[name] = cls;
+            return cls;
+        }
+
+        uint8_t *newProperty(uint8_t *owner, bool ownerIsObject, const PropSpec &spec, int32_t offset, uint8_t fieldMask)
+        {
+            const char *className = PropertyClassName(spec.Kind);
+            const size_t propertySize = _props.Size + sizeof(void *) * 2;
+
+            uint8_t *prop = nullptr;
+            if (_useFField)
+            {
+                prop = _arena.Alloc(propertySize, sizeof(void *));
+                Put<void **>(prop, 0, gVTable);
+                Put<uint8_t *>(prop, _offsets.FField.ClassPrivate, _propertyClasses[className]);
+
+                // Owner FFieldVariant, with bIsUObject before UE 5.3
+                Put<uint8_t *>(prop, _offsets.FField.ClassPrivate + sizeof(void *), owner);
+                if (_offsets.FField.Next - _offsets.FField.ClassPrivate >= sizeof(void *) * 3)
+                    Put<uint8_t>(prop, _offsets.FField.ClassPrivate + sizeof(void *) * 2, ownerIsObject);
+
+                _names.PutName(prop + _offsets.FField.NamePrivate, spec.Name);
+                Put<uint32_t>(prop, _offsets.FField.FlagsPrivate, kObjectFlagsNative);
+            }
+            else
+            {
+                prop = newObject(_propertyClasses[className], owner, spec.Name, kObjectFlagsNative, propertySize);
+            }
+            _fieldsCount++;
+
+            int32_t elementSize = kindLayout(spec.Kind, spec.Sub).first;
+            uint64_t flags = spec.Flags;
+            if (spec.Kind != EPropKind::Str && spec.Kind != EPropKind::Array && spec.Kind != EPropKind::Struct)
+                flags |= kPropertyFlagsZeroConstructor;
+
+            Put<int32_t>(prop, _props.ArrayDim, 1);
+            Put<int32_t>(prop, _props.ElementSize, elementSize);
+            Put<uint64_t>(prop, _props.PropertyFlags, flags);
+            Put<int32_t>(prop, _props.Offset_Internal, offset);
+
+            const uintptr_t sub = _props.Size;
+            switch (spec.Kind)
+            {
+            case EPropKind::Struct:
+            case EPropKind::Object:
+            case EPropKind::Byte:
+                Put<uint8_t *>(prop, sub, spec.Sub);
+                break;
+            case EPropKind::Class:
+                Put<uint8_t *>(prop, sub, _classClass);
+                Put<uint8_t *>(prop, sub + sizeof(void *), spec.Sub);
+                break;
+            case EPropKind::Bool:
+            case EPropKind::BitBool:
+                // FieldSize, ByteOffset, ByteMask, FieldMask
+                Put<uint8_t>(prop, sub, 1);
+                Put<uint8_t>(prop, sub + 1, 0);
+                Put<uint8_t>(prop, sub + 2, fieldMask);
+                Put<uint8_t>(prop, sub + 3, fieldMask);
+                break;
+            case EPropKind::Enum:
+            {
+                PropSpec underlying;
+                underlying.Kind = EPropKind::Byte;
+                underlying.Name = "UnderlyingType";
+                underlying.Flags = 0;
+                Put<uint8_t *>(prop, sub, newProperty(prop, !_useFField, underlying, 0, 0));
+                Put<uint8_t *>(prop, sub + sizeof(void *), spec.Sub);
+                break;
+            }
+            case EPropKind::Array:
+            {
+                PropSpec inner;
+                inner.Kind = spec.InnerKind;
+                inner.Name = spec.Name;
+                inner.Flags = 0;
+                inner.Sub = spec.InnerSub;
+                Put<uint8_t *>(prop, sub, newProperty(prop, !_useFField, inner, 0, 0xFF));
+                break;
+            }
+            default:
+                break;
+            }
+
+            return prop;
+        }
+
+        void addProperties(uint8_t *owner, const std::vector<PropSpec> &specs)
+        {
+            StructInfo info = _structs[owner];
+            int32_t offset = info.Size;
+            int32_t bitfieldOffset = -1;
+            int bitfieldBit = 8;
+
+            const uintptr_t head = _useFField ? _offsets.UStruct.ChildProperties : _offsets.UStruct.Children;
+            const uintptr_t next = _useFField ? _offsets.FField.Next : _offsets.UField.Next;
+
+            for (const auto &spec : specs)
+            {
+                int32_t at = 0;
+                uint8_t mask = 0xFF;
+                if (spec.Kind == EPropKind::BitBool && bitfieldOffset >= 0 && bitfieldBit < 8)
+                {
+                    at = bitfieldOffset;
+                    mask = uint8_t(1 << bitfieldBit++);
+                }
+                else
+                {
+                    auto layout = kindLayout(spec.Kind, spec.Sub);
+                    at = int32_t(AlignUp(offset, layout.second));
+                    offset = at + layout.first;
+                    info.Align = std::max(info.Align, layout.second);
+
+                    if (spec.Kind == EPropKind::BitBool)
+                    {
+                        bitfieldOffset = at;
+                        bitfieldBit = 1;
+                        mask = 1;
+                    }
+                    else
+                    {
+                        bitfieldOffset = -1;
+                    }
+                }
+
+                link(owner, head, next, newProperty(owner, true, spec, at, mask));
+            }
+
+            info.Size = int32_t(AlignUp(offset, info.Align));
+            setStructInfo(owner, info);
+        }
+
+        uint8_t *newScriptStruct(uint8_t *package, const std::string &name, const std::vector<PropSpec> &members)
+        {
+            uint8_t *st = newStruct(_scriptStructClass, nullptr, package, name);
+            addProperties(st, members);
+            _scriptStructs.push_back(st);
+            return st;
+        }
+
+        uint8_t *newFunction(uint8_t *owner, const std::string &name, const std::vector<PropSpec> &params)
+        {
+            uint8_t *fn = newStruct(_functionClass, nullptr, owner, name);
+            addProperties(fn, params);
+
+            Put<uint32_t>(fn, _offsets.UFunction.EFunctionFlags, kFunctionFlagsNative);
+            Put<uint8_t>(fn, _offsets.UFunction.NumParams, uint8_t(params.size()));
+            Put<uint16_t>(fn, _offsets.UFunction.ParamSize, uint16_t(_structs[fn].Size));
+            Put<void *>(fn, _offsets.UFunction.Func, (void *)&FixtureNative);
+
+            // functions are UFields in Children, with the UProperties before UE 4.25
+            link(owner, _offsets.UStruct.Children, _offsets.UField.Next, fn);
+            return fn;
+        }
+
+        // values are full names, "EFoo::Bar" for enum classes
+        uint8_t *newEnum(uint8_t *package, const std::string &name, const std::vector<std::string> &values)
+        {
+            uint8_t *e = newObject(_enumClass, package, name, kObjectFlagsNative, _offsets.UEnum.Names + sizeof(void *) * 4);
+
+            // TArray<TPair<FName, int64>>
+            const size_t nameSize = AlignUp(_offsets.FName.Size, sizeof(void *));
+            const size_t pairSize = nameSize + sizeof(int64_t);
+            uint8_t *pairs = _arena.Alloc(pairSize * values.size(), sizeof(void *));
+            for (size_t i = 0; i < values.size(); i++)
+            {
+                _names.PutName(pairs + i * pairSize, values[i]);
+                Put<int64_t>(pairs, i * pairSize + nameSize, int64_t(i));
+            }
+
+            Put<uint8_t *>(e, _offsets.UEnum.Names, pairs);
+            Put<int32_t>(e, _offsets.UEnum.Names + sizeof(void *), int32_t(values.size()));
+            Put<int32_t>(e, _offsets.UEnum.Names + sizeof(void *) + sizeof(int32_t), int32_t(values.size()));
+
+            _enums.push_back(e);
+            return e;
+        }
+
+        PropSpec member(EPropKind kind, const std::string &name, uint8_t *sub = nullptr)
+        {
+            PropSpec spec;
+            spec.Kind = kind;
+            spec.Name = name;
+            spec.Sub = sub;
+            return spec;
+        }
+
+        void buildCore()
+        {
+            // CoreUObject objects come first like in a real GUObjectArray, classes are set once Class & Package exist
+            _corePackage = newObject(nullptr, nullptr, "/Script/CoreUObject", 0x1, _offsets.UField.Next + 0x40);
+
+            _objectClass = newClass(nullptr, _corePackage, "Object");
+            setStructInfo(_objectClass, {int32_t(_offsets.UField.Next), int32_t(sizeof(void *))});
+
+            _fieldClass = newClass(_objectClass, _corePackage, "Field");
+            setStructInfo(_fieldClass, {int32_t(_offsets.UField.Next + sizeof(void *)), int32_t(sizeof(void *))});
+
+            uint8_t *structClass = newClass(_fieldClass, _corePackage, "Struct");
+            setStructInfo(structClass, {int32_t(_structObjectSize), int32_t(sizeof(void *))});
+
+            _classClass = newClass(structClass, _corePackage, "Class");
+            _scriptStructClass = newClass(structClass, _corePackage, "ScriptStruct");
+            _functionClass = newClass(structClass, _corePackage, "Function");
+            _enumClass = newClass(_fieldClass, _corePackage, "Enum");
+            _packageClass = newClass(_objectClass, _corePackage, "Package");
+            newClass(_objectClass, _corePackage, "Interface");
+
+            setClass(_corePackage, _packageClass);
+            for (uint8_t *cls : _classes)
+                setClass(cls, _classClass);
+
+            // property classes, FFieldClass since UE 4.25
+            newPropertyClass(_useFField ? "Field" : "Property", _useFField ? nullptr : "");
+            if (_useFField)
+                newPropertyClass("Property", "Field");
+            newPropertyClass("NumericProperty", "Property");
+            for (const char *name : {"IntProperty", "Int64Property", "FloatProperty", "DoubleProperty", "ByteProperty"})
+                newPropertyClass(name, "NumericProperty");
+            for (const char *name : {"BoolProperty", "EnumProperty", "NameProperty", "StrProperty", "StructProperty", "ArrayProperty", "ObjectPropertyBase"})
+                newPropertyClass(name, "Property");
+            newPropertyClass("ObjectProperty", "ObjectPropertyBase");
+            newPropertyClass("ClassProperty", "ObjectProperty");
+
+            // large world coordinates since UE 5.0
+            EPropKind real = _largeWorld ? EPropKind::Double : EPropKind::Float;
+
+            _vectorStruct = newScriptStruct(_corePackage, "Vector", {member(real, "X"), member(real, "Y"), member(real, "Z")});
+            newScriptStruct(_corePackage, "Vector2D", {member(real, "X"), member(real, "Y")});
+            newScriptStruct(_corePackage, "Rotator", {member(real, "Pitch"), member(real, "Yaw"), member(real, "Roll")});
+            newScriptStruct(_corePackage, "Guid", {member(EPropKind::Int, "A"), member(EPropKind::Int, "B"), member(EPropKind::Int, "C"), member(EPropKind::Int, "D")});
+            newScriptStruct(_corePackage, "Color", {member(EPropKind::Byte, "B"), member(EPropKind::Byte, "G"), member(EPropKind::Byte, "R"), member(EPropKind::Byte, "A")});
+            newScriptStruct(_corePackage, "LinearColor", {member(EPropKind::Float, "R"), member(EPropKind::Float, "G"), member(EPropKind::Float, "B"), member(EPropKind::Float, "A")});
+            newScriptStruct(_corePackage, "Box", {member(EPropKind::Struct, "Min", _vectorStruct), member(EPropKind::Struct, "Max", _vectorStruct), member(EPropKind::Byte, "IsValid")});
+        }
+
+        void buildEngine()
+        {
+            uint8_t *engine = newObject(_packageClass, nullptr, "/Script/Engine", 0x1, _offsets.UField.Next + 0x40);
+
+            uint8_t *netRole = newEnum(engine, "ENetRole", {"ROLE_None", "ROLE_SimulatedProxy", "ROLE_AutonomousProxy", "ROLE_Authority", "ROLE_MAX"});
+
+            _actorClass = newClass(_objectClass, engine, "Actor");
+            PropSpec tags = member(EPropKind::Array, "Tags");
+            tags.InnerKind = EPropKind::Name;
+            addProperties(_actorClass, {member(EPropKind::BitBool, "bHidden"), member(EPropKind::BitBool, "bCanBeDamaged"),
+                                        member(EPropKind::Byte, "Role", netRole), member(EPropKind::Object, "Owner", _actorClass),
+                                        member(EPropKind::Float, "InitialLifeSpan"), tags});
+
+            PropSpec location = member(EPropKind::Struct, "ReturnValue", _vectorStruct);
+            location.Flags = kPropertyFlagsReturnParm;
+            newFunction(_actorClass, "K2_GetActorLocation", {location});
+
+            PropSpec hidden = member(EPropKind::Bool, "bNewHidden");
+            hidden.Flags = kPropertyFlagsParm;
+            newFunction(_actorClass, "SetActorHiddenInGame", {hidden});
+
+            uint8_t *pawn = newClass(_actorClass, engine, "Pawn");
+            addProperties(pawn, {member(EPropKind::Float, "BaseEyeHeight"), member(EPropKind::Object, "Controller", _actorClass)});
+
+            uint8_t *character = newClass(pawn, engine, "Character");
+            addProperties(character, {member(EPropKind::Object, "Mesh", _objectClass), member(EPropKind::Int, "JumpMaxCount")});
+        }
+
+        template <typename T>
+        T pick(const std::vector<T> &from)
+        {
+            return from[std::uniform_int_distribution<size_t>(0, from.size() - 1)(_rng)];
+        }
+
+        int randomCount(int average)
+        {
+            if (average <= 0)
+                return 0;
+            return std::uniform_int_distribution<int>(std::max(1, average / 2), average + average / 2)(_rng);
+        }
+
+        PropSpec randomProperty(const std::string &word, const std::vector<EPropKind> &kinds)
+        {
+            PropSpec spec;
+            spec.Kind = pick(kinds);
+            if ((spec.Kind == EPropKind::Enum || spec.Kind == EPropKind::Byte) && !_enums.empty())
+                spec.Sub = pick(_enums);
+            else if (spec.Kind == EPropKind::Enum)
+                spec.Kind = EPropKind::Int;
+
+            if (spec.Kind == EPropKind::Struct)
+                spec.Sub = pick(_scriptStructs);
+            else if (spec.Kind == EPropKind::Object || spec.Kind == EPropKind::Class)
+                spec.Sub = pick(_classes);
+            else if (spec.Kind == EPropKind::Array)
+            {
+                spec.InnerKind = pick(std::vector<EPropKind>{EPropKind::Int, EPropKind::Float, EPropKind::Name, EPropKind::Object, EPropKind::Struct});
+                if (spec.InnerKind == EPropKind::Object)
+                    spec.InnerSub = pick(_classes);
+                else if (spec.InnerKind == EPropKind::Struct)
+                    spec.InnerSub = pick(_scriptStructs);
+            }
+
+            spec.Name = (spec.Kind == EPropKind::Bool || spec.Kind == EPropKind::BitBool) ? "b" + word : word;
+            return spec;
+        }
+
+        std::vector<PropSpec> randomMembers(int count)
+        {
+            static const std::vector<EPropKind> kinds = {EPropKind::Int, EPropKind::Int, EPropKind::Float, EPropKind::Float, EPropKind::Bool,
+                                                         EPropKind::BitBool, EPropKind::BitBool, EPropKind::Byte, EPropKind::Enum, EPropKind::Name,
+                                                         EPropKind::Str, EPropKind::Object, EPropKind::Object, EPropKind::Class, EPropKind::Struct,
+                                                         EPropKind::Struct, EPropKind::Array, EPropKind::Int64, EPropKind::Double};
+
+            const size_t numWords = sizeof(kMemberWords) / sizeof(kMemberWords[0]);
+            std::vector<PropSpec> members;
+            for (int i = 0; i < count; i++)
+            {
+                std::string word = kMemberWords[i % numWords];
+                if (size_t(i) >= numWords)
+                    word += std::to_string(i / numWords);
+                members.push_back(randomProperty(word, kinds));
+            }
+            return members;
+        }
+
+        void buildGame()
+        {
+            static const std::vector<EPropKind> paramKinds = {EPropKind::Int, EPropKind::Float, EPropKind::Bool, EPropKind::Name,
+                                                              EPropKind::Str, EPropKind::Object, EPropKind::Struct};
+
+            uint8_t *game = newObject(_packageClass, nullptr, "/Script/FixtureGame", 0x1, _offsets.UField.Next + 0x40);
+
+            for (int i = 0; i < _options.Enums; i++)
+            {
+                std::string name = "EFixtureEnum_" + std::to_string(i);
+                std::vector<std::string> values;
+                int count = 2 + int(_rng() % 10);
+                for (int v = 0; v < count; v++)
+                    values.push_back(name + "::Value" + std::to_string(v));
+                values.push_back(name + "::" + name + "_MAX");
+                newEnum(game, name, values);
+            }
+
+            for (int i = 0; i < _options.Structs; i++)
+                newScriptStruct(game, "FixtureStruct_" + std::to_string(i), randomMembers(randomCount(_options.Properties / 2 + 1)));
+
+            const size_t firstGenerated = _classes.size();
+            const size_t numVerbs = sizeof(kFunctionVerbs) / sizeof(kFunctionVerbs[0]);
+            const size_t numWords = sizeof(kMemberWords) / sizeof(kMemberWords[0]);
+            for (int i = 0; i < _options.Classes; i++)
+            {
+                // a few roots then deeper chains on earlier generated classes
+                uint8_t *super = nullptr;
+                size_t generated = _classes.size() - firstGenerated;
+                if (generated < 8 || _rng() % 4 == 0)
+                    super = (i % 2) ? _actorClass : _objectClass;
+                else
+                    super = _classes[firstGenerated + _rng() % generated];
+
+                uint8_t *cls = newClass(super, game, "FixtureClass_" + std::to_string(i));
+                addProperties(cls, randomMembers(randomCount(_options.Properties)));
+
+                int functions = randomCount(_options.Functions);
+                for (int f = 0; f < functions; f++)
+                {
+                    std::string name = std::string(kFunctionVerbs[_rng() % numVerbs]) + kMemberWords[_rng() % numWords] + std::to_string(f);
+
+                    std::vector<PropSpec> params;
+                    int numParams = int(_rng() % 4);
+                    for (int p = 0; p < numParams; p++)
+                    {
+                        params.push_back(randomProperty("Param" + std::to_string(p), paramKinds));
+                        params.back().Flags = kPropertyFlagsParm;
+                    }
+                    if (_rng() % 2)
+                    {
+                        params.push_back(randomProperty("ReturnValue", paramKinds));
+                        params.back().Name = "ReturnValue";
+                        params.back().Flags = kPropertyFlagsReturnParm;
+                    }
+
+                    newFunction(cls, name, params);
+                }
+            }
+        }
+
+        const UE_Offsets &_offsets;
+        FixtureNames &_names;
+        FixtureArena &_arena;
+        const FixtureOptions &_options;
+        std::mt19937 _rng;
+
+        bool _useFField = false;
+        bool _largeWorld = false;
+        PropertyFields _props{};
+        size_t _structObjectSize = 0;
+        size_t _fieldsCount = 0;
+
+        std::vector<uint8_t *> _objects;
+        std::vector<uint8_t *> _classes, _scriptStructs, _enums;
+        std::unordered_map<uint8_t *, std::string> _classNames;
+        std::unordered_map<uint8_t *, uint8_t *> _outers;
+        std::unordered_map<uint8_t *, StructInfo> _structs;
+        std::unordered_map<std::string, uint8_t *> _propertyClasses;
+        std::map<std::pair<uint8_t *, uintptr_t>, uint8_t *> _lastLinked;
+
+        uint8_t *_corePackage = nullptr, *_packageClass = nullptr;
+        uint8_t *_objectClass = nullptr, *_fieldClass = nullptr, *_classClass = nullptr;
+        uint8_t *_scriptStructClass = nullptr, *_functionClass = nullptr, *_enumClass = nullptr;
+        uint8_t *_actorClass = nullptr, *_vectorStruct = nullptr;
+    };
+
+    // the dumper finds processes by name like package IDs on Android, run again with argv[0] as the bare name
+    void RunAsProcessName(char **argv)
+    {
+        if (strcmp(argv[0], kUEFIXTURE_PROCESS_NAME) == 0)
+            return;
+
+        char exePath[PATH_MAX] = {};
+        if (readlink("/proc/self/exe", exePath, sizeof(exePath) - 1) <= 0)
+            return;
+
+        const char *fileName = strrchr(exePath, '/');
+        fileName = fileName ? fileName + 1 : exePath;
+        if (strcmp(fileName, kUEFIXTURE_PROCESS_NAME) != 0)
+        {
+            fprintf(stderr, "Executable should be named %s for the dumper to find it.\n", kUEFIXTURE_PROCESS_NAME);
+            return;
+        }
+
+        argv[0] = const_cast<char *>(kUEFIXTURE_PROCESS_NAME);
+        execv(exePath, argv);
+        perror("execv");
+    }
+
+    void PrintUsage()
+    {
+        printf("Usage: %s [options]\n", kUEFIXTURE_PROCESS_NAME);
+        printf("  -v, --engine <major.minor>  engine version layout, default 4.27\n");
+        printf("  -C, --case-preserving       WITH_CASE_PRESERVING_NAME names\n");
+        printf("  -O, --outline-number        FNAME_OUTLINE_NUMBER names, UE 5 only\n");
+        printf("  -c, --classes <count>       generated classes, default 2000\n");
+        printf("  -s, --structs <count>       generated script structs, default 400\n");
+        printf("  -e, --enums <count>         generated enums, default 200\n");
+        printf("  -p, --properties <count>    average properties per class, default 10\n");
+        printf("  -f, --functions <count>     average functions per class, default 3\n");
+        printf("  -r, --seed <seed>           generator seed, default 1\n");
+        printf("  -t, --exit-after <seconds>  exit instead of waiting forever\n");
+    }
+
+    bool ParseOptions(int argc, char **argv, FixtureOptions *options)
+    {
+        static const struct option longOptions[] = {
+            {"engine", required_argument, nullptr, 'v'},
+            {"case-preserving", no_argument, nullptr, 'C'},
+            {"outline-number", no_argument, nullptr, 'O'},
+            {"classes", required_argument, nullptr, 'c'},
+            {"structs", required_argument, nullptr, 's'},
+            {"enums", required_argument, nullptr, 'e'},
+            {"properties", required_argument, nullptr, 'p'},
+            {"functions", required_argument, nullptr, 'f'},
+            {"seed", required_argument, nullptr, 'r'},
+            {"exit-after", required_argument, nullptr, 't'},
+            {"help", no_argument, nullptr, 'h'},
+            {nullptr, 0, nullptr, 0},
+        };
+
+        int opt = 0;
+        while ((opt = getopt_long(argc, argv, "v:COc:s:e:p:f:r:t:h", longOptions, nullptr)) != -1)
+        {
+            switch (opt)
+            {
+            case 'v':
+                if (sscanf(optarg, "%d.%d", &options->EngineMajor, &options->EngineMinor) != 2)
+                    return false;
+                break;
+            case 'C': options->CasePreservingName = true; break;
+            case 'O': options->OutlineNumberName = true; break;
+            case 'c': options->Classes = std::max(0, atoi(optarg)); break;
+            case 's': options->Structs = std::max(0, atoi(optarg)); break;
+            case 'e': options->Enums = std::max(0, atoi(optarg)); break;
+            case 'p': options->Properties = std::max(0, atoi(optarg)); break;
+            case 'f': options->Functions = std::max(0, atoi(optarg)); break;
+            case 'r': options->Seed = uint32_t(strtoul(optarg, nullptr, 0)); break;
+            case 't': options->ExitAfter = std::max(0, atoi(optarg)); break;
+            default: return false;
+            }
+        }
+
+        if (!UE_DefaultOffsets::TableNameForEngineVersion(options->EngineMajor, options->EngineMinor))
+        {
+            fprintf(stderr, "No offsets table for UE %d.%d.\n", options->EngineMajor, options->EngineMinor);
+            return false;
+        }
+
+        if (options->OutlineNumberName && options->EngineMajor < 5)
+        {
+            fprintf(stderr, "Outline number names need UE 5.\n");
+            return false;
+        }
+
+        return true;
+    }
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    setbuf(stdout, nullptr);
+
+    RunAsProcessName(argv);
+
+    FixtureOptions options;
+    if (!ParseOptions(argc, argv, &options))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    for (size_t i = 0; i < kVTableSize; i++)
+        gVTable[i] = (void *)&FixtureVirtual;
+    gVTable[kProcessEventIndex] = (void *)&FixtureProcessEvent;
+
+    auto buildStart = std::chrono::steady_clock::now();
+
+    UE_Offsets offsets = UE_DefaultOffsets::ForEngineVersion(options.EngineMajor, options.EngineMinor, options.CasePreservingName, options.OutlineNumberName);
+
+    FixtureArena arena;
+    FixtureNames names(offsets, arena);
+    FixtureWorld world(offsets, names, arena, options);
+    world.Build();
+
+    names.Publish();
+    world.Publish(GUObjectArray);
+
+    GFixtureConfig.EngineMajor = options.EngineMajor;
+    GFixtureConfig.EngineMinor = options.EngineMinor;
+    GFixtureConfig.CasePreservingName = options.CasePreservingName;
+    GFixtureConfig.OutlineNumberName = options.OutlineNumberName;
+    GFixtureConfig.FNamePool = offsets.Config.IsUsingFNamePool;
+    GFixtureConfig.NumObjects = int32_t(world.Count());
+    GFixtureConfig.NumNames = int32_t(names.Count());
+    std::atomic_thread_fence(std::memory_order_release);
+    GFixtureConfig.Magic = kUEFIXTURE_MAGIC;
+
+    auto buildMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - buildStart).count();
+
+    printf("PID: %d\n", getpid());
+    printf("Layout: UE %d.%d (%s)%s%s\n", options.EngineMajor, options.EngineMinor,
+           UE_DefaultOffsets::TableNameForEngineVersion(options.EngineMajor, options.EngineMinor),
+           options.CasePreservingName ? ", case preserving names" : "", options.OutlineNumberName ? ", outline number names" : "");
+    printf("Names: %zu in %s\n", names.Count(), offsets.Config.IsUsingFNamePool ? "FNamePool" : "GNames");
+    printf("Objects: %zu, %s fields: %zu\n", world.Count(), offsets.UStruct.ChildProperties ? "FField" : "UProperty", world.FieldsCount());
+    printf("Types: %zu\n", world.TypesCount());
+    printf("Built in %lld ms, waiting to be dumped.\n", (long long)buildMs);
+
+    if (options.ExitAfter > 0)
+    {
+        sleep(unsigned(options.ExitAfter));
+        return 0;
+    }
+
+    for (;;)
+        pause();
+}
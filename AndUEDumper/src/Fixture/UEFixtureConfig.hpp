@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+#define kUEFIXTURE_PROCESS_NAME "UEFixture"
+#define kUEFIXTURE_MAGIC 0x46455546  // "FUEF"
+
+// Exported by the fixture process as GFixtureConfig, Magic is set last once the world is laid out.
+// Shared with the Fixture profile so both use the same UE_DefaultOffsets table.
+struct UEFixtureConfig
+{
+    uint32_t Magic;
+    int32_t EngineMajor;
+    int32_t EngineMinor;
+    uint8_t CasePreservingName;
+    uint8_t OutlineNumberName;
+    uint8_t FNamePool;
+    uint8_t Reserved;
+    int32_t NumObjects;
+    int32_t NumNames;
+};
@@ -0,0 +1,240 @@
+#pragma once
+
+// SDK.db format & reader, standalone so tools can copy this header alone.
+//
+// Little-endian, every table is an array of fixed size records at an 8 aligned file offset,
+// records refer to each other by index and to strings by byte offset in the strings table.
+// A string is stored as uint32_t length, chars, '\0'.
+//
+//  int fd = open("SDK.db", O_RDONLY); fstat(fd, &st);
+//  void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+//  SDKDatabase::Reader db;
+//  if (db.Open(data, st.st_size))
+//      for (const auto &type : db.Types())
+//          printf("%s 0x%X\n", db.GetString(type.CppName).data(), type.Size);
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "SDK.db is little-endian only"
+#endif
+
+namespace SDKDatabase
+{
+    constexpr char kMagic[8] = {'U', 'E', 'S', 'D', 'K', 'D', 'B', '\0'};
+    constexpr uint32_t kVersion = 1;
+
+    using StringRef = uint32_t;
+
+    struct TableRef
+    {
+        uint32_t Offset;
+        uint32_t Count;
+    };
+
+    struct Header
+    {
+        char Magic[8];
+        uint32_t Version;
+        uint32_t HeaderSize;
+        TableRef Packages;
+        TableRef Types;
+        TableRef Members;
+        TableRef Functions;
+        TableRef Enums;
+        TableRef EnumValues;
+        // Count is the size in bytes
+        TableRef Strings;
+    };
+
+    struct Package
+    {
+        StringRef Name;
+        uint32_t FirstType;
+        uint32_t TypesCount;
+        uint32_t FirstEnum;
+        uint32_t EnumsCount;
+        uint32_t Reserved;
+    };
+
+    enum ETypeFlags : uint32_t
+    {
+        TYPE_Class = 1 << 0,
+        TYPE_Struct = 1 << 1,
+    };
+
+    struct Type
+    {
+        StringRef Name;
+        StringRef FullName;
+        StringRef CppName;
+        uint32_t Flags;
+        uint32_t Size;
+        uint32_t Inherited;
+        uint32_t FirstMember;
+        uint32_t MembersCount;
+        uint32_t FirstFunction;
+        uint32_t FunctionsCount;
+    };
+
+    enum EMemberFlags : uint32_t
+    {
+        MEMBER_Padding = 1 << 0,
+        MEMBER_BitField = 1 << 1,
+    };
+
+    struct Member
+    {
+        StringRef Type;
+        StringRef Name;
+        StringRef Extra;
+        uint32_t Offset;
+        uint32_t Size;
+        uint32_t Flags;
+    };
+
+    struct Function
+    {
+        StringRef Name;
+        StringRef FullName;
+        // return type & name
+        StringRef CppName;
+        StringRef Params;
+        StringRef Flags;
+        uint32_t EFlags;
+        // from the library base, 0 if unknown
+        uint64_t Offset;
+        int32_t NumParams;
+        int32_t ParamSize;
+    };
+
+    struct Enum
+    {
+        StringRef FullName;
+        StringRef CppName;
+        uint32_t FirstValue;
+        uint32_t ValuesCount;
+    };
+
+    struct EnumValue
+    {
+        StringRef Name;
+        uint32_t Reserved;
+        uint64_t Value;
+    };
+
+    template <typename T>
+    class Table
+    {
+        const T *_data = nullptr;
+        uint32_t _count = 0;
+
+    public:
+        Table() = default;
+        Table(const T *data, uint32_t count) : _data(data), _count(count) {}
+
+        inline const T *begin() const { return _data; }
+        inline const T *end() const { return _data + _count; }
+        inline uint32_t size() const { return _count; }
+        inline const T &operator[](uint32_t i) const { return _data[i]; }
+
+        inline Table<T> slice(uint32_t first, uint32_t count) const
+        {
+            if (first > _count || count > _count - first) return {};
+            return {_data + first, count};
+        }
+    };
+
+    // Reads a mapped or loaded SDK.db in place, data must outlive the reader
+    class Reader
+    {
+        const uint8_t *_data = nullptr;
+        size_t _size = 0;
+        Header _header{};
+
+        template <typename T>
+        bool checkTable(const TableRef &ref, size_t recordSize) const
+        {
+            if (ref.Offset % alignof(T) != 0) return false;
+            return ref.Offset <= _size && uint64_t(ref.Count) * recordSize <= _size - ref.Offset;
+        }
+
+        template <typename T>
+        inline Table<T> table(const TableRef &ref) const
+        {
+            return {reinterpret_cast<const T *>(_data + ref.Offset), ref.Count};
+        }
+
+    public:
+        bool Open(const void *data, size_t size)
+        {
+            _data = nullptr;
+            _size = 0;
+
+            if (!data || size < sizeof(Header)) return false;
+            memcpy(&_header, data, sizeof(Header));
+
+            if (memcmp(_header.Magic, kMagic, sizeof(kMagic)) != 0) return false;
+            if (_header.Version != kVersion || _header.HeaderSize < sizeof(Header)) return false;
+
+            _data = static_cast<const uint8_t *>(data);
+            _size = size;
+
+            bool valid = checkTable<Package>(_header.Packages, sizeof(Package)) &&
+                         checkTable<Type>(_header.Types, sizeof(Type)) &&
+                         checkTable<Member>(_header.Members, sizeof(Member)) &&
+                         checkTable<Function>(_header.Functions, sizeof(Function)) &&
+                         checkTable<Enum>(_header.Enums, sizeof(Enum)) &&
+                         checkTable<EnumValue>(_header.EnumValues, sizeof(EnumValue)) &&
+                         checkTable<char>(_header.Strings, 1);
+            if (!valid)
+            {
+                _data = nullptr;
+                _size = 0;
+            }
+            return valid;
+        }
+
+        inline bool IsOpen() const { return _data != nullptr; }
+
+        inline Table<Package> Packages() const { return table<Package>(_header.Packages); }
+        inline Table<Type> Types() const { return table<Type>(_header.Types); }
+        inline Table<Member> Members() const { return table<Member>(_header.Members); }
+        inline Table<Function> Functions() const { return table<Function>(_header.Functions); }
+        inline Table<Enum> Enums() const { return table<Enum>(_header.Enums); }
+        inline Table<EnumValue> EnumValues() const { return table<EnumValue>(_header.EnumValues); }
+
+        inline Table<Type> TypesOf(const Package &p) const { return Types().slice(p.FirstType, p.TypesCount); }
+        inline Table<Enum> EnumsOf(const Package &p) const { return Enums().slice(p.FirstEnum, p.EnumsCount); }
+        inline Table<Member> MembersOf(const Type &t) const { return Members().slice(t.FirstMember, t.MembersCount); }
+        inline Table<Function> FunctionsOf(const Type &t) const { return Functions().slice(t.FirstFunction, t.FunctionsCount); }
+        inline Table<EnumValue> ValuesOf(const Enum &e) const { return EnumValues().slice(e.FirstValue, e.ValuesCount); }
+
+        // empty if ref is out of range
+        std::string_view GetString(StringRef ref) const
+        {
+            const TableRef &strings = _header.Strings;
+            if (uint64_t(ref) + sizeof(uint32_t) > strings.Count) return {};
+
+            uint32_t len = 0;
+            memcpy(&len, _data + strings.Offset + ref, sizeof(len));
+            if (uint64_t(ref) + sizeof(uint32_t) + len > strings.Count) return {};
+
+            return {reinterpret_cast<const char *>(_data + strings.Offset + ref + sizeof(uint32_t)), len};
+        }
+
+        // by object name, linear
+        const Type *FindType(std::string_view name) const
+        {
+            for (const auto &type : Types())
+            {
+                if (GetString(type.Name) == name)
+                    return &type;
+            }
+            return nullptr;
+        }
+    };
+}  // namespace SDKDatabase
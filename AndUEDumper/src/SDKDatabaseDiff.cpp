@@ -0,0 +1,312 @@
+#include "SDKDatabaseDiff.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string_view>
+#include <unordered_map>
+
+namespace
+{
+    class MappedFile
+    {
+        void *_data = MAP_FAILED;
+        size_t _size = 0;
+
+    public:
+        MappedFile() = default;
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        ~MappedFile()
+        {
+            if (_data != MAP_FAILED)
+                munmap(_data, _size);
+        }
+
+        bool Open(const std::string &path)
+        {
+            int fd = open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                return false;
+
+            struct stat st{};
+            if (fstat(fd, &st) == 0 && st.st_size > 0)
+            {
+                _size = size_t(st.st_size);
+                _data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            }
+            close(fd);
+            return _data != MAP_FAILED;
+        }
+
+        inline const void *data() const { return _data; }
+        inline size_t size() const { return _size; }
+    };
+
+    struct Hasher
+    {
+        uint64_t value = 14695981039346656037ull;
+
+        void Add(const void *data, size_t size)
+        {
+            const uint8_t *bytes = static_cast<const uint8_t *>(data);
+            for (size_t i = 0; i < size; i++)
+                value = (value ^ bytes[i]) * 1099511628211ull;
+        }
+
+        void Add(std::string_view str)
+        {
+            Add(str.data(), str.size());
+            Add("\0", 1);
+        }
+
+        template <typename T>
+        void AddValue(T v) { Add(&v, sizeof(T)); }
+    };
+
+    inline bool IsPadding(const SDKDatabase::Member &m)
+    {
+        return (m.Flags & SDKDatabase::MEMBER_Padding) != 0;
+    }
+
+    uint64_t LayoutHash(const SDKDatabase::Reader &db, const SDKDatabase::Type &type)
+    {
+        Hasher h;
+        h.AddValue(type.Size);
+        h.AddValue(type.Inherited);
+        h.Add(db.GetString(type.CppName));
+        for (const auto &m : db.MembersOf(type))
+        {
+            // padding follows the real members
+            if (IsPadding(m))
+                continue;
+
+            h.Add(db.GetString(m.Type));
+            h.Add(db.GetString(m.Name));
+            h.AddValue(m.Offset);
+            h.AddValue(m.Size);
+        }
+        return h.value;
+    }
+
+    uint64_t FunctionsHash(const SDKDatabase::Reader &db, const SDKDatabase::Type &type)
+    {
+        Hasher h;
+        for (const auto &f : db.FunctionsOf(type))
+        {
+            h.Add(db.GetString(f.Name));
+            h.AddValue(f.Offset);
+        }
+        return h.value;
+    }
+
+    uint64_t EnumHash(const SDKDatabase::Reader &db, const SDKDatabase::Enum &e)
+    {
+        Hasher h;
+        h.Add(db.GetString(e.CppName));
+        for (const auto &v : db.ValuesOf(e))
+        {
+            h.Add(db.GetString(v.Name));
+            h.AddValue(v.Value);
+        }
+        return h.value;
+    }
+
+    template <typename T, typename F>
+    std::unordered_map<std::string_view, const T *> IndexByName(const SDKDatabase::Table<T> &table, F getName)
+    {
+        std::unordered_map<std::string_view, const T *> map;
+        map.reserve(table.size());
+        for (const auto &it : table)
+            map.emplace(getName(it), &it);
+        return map;
+    }
+}  // namespace
+
+SDKDatabaseDiff::Stats SDKDatabaseDiff::Compare(const SDKDatabase::Reader &oldDb, const SDKDatabase::Reader &newDb, BufferFmt &report)
+{
+    Stats stats;
+
+    auto newTypes = IndexByName(newDb.Types(), [&newDb](const SDKDatabase::Type &t) { return newDb.GetString(t.FullName); });
+    std::vector<char> newTypesMatched(newDb.Types().size(), 0);
+
+    for (const auto &oldType : oldDb.Types())
+    {
+        std::string_view fullName = oldDb.GetString(oldType.FullName);
+        auto it = newTypes.find(fullName);
+        if (it == newTypes.end())
+        {
+            report.append("- {}\n", fullName);
+            stats.TypesRemoved++;
+            continue;
+        }
+
+        const SDKDatabase::Type &newType = *it->second;
+        newTypesMatched[&newType - newDb.Types().begin()] = 1;
+
+        bool layoutChanged = LayoutHash(oldDb, oldType) != LayoutHash(newDb, newType);
+        bool functionsChanged = FunctionsHash(oldDb, oldType) != FunctionsHash(newDb, newType);
+        if (!layoutChanged && !functionsChanged)
+            continue;
+
+        stats.TypesChanged++;
+        report.append("~ {}", fullName);
+        if (oldType.Size != newType.Size)
+            report.append(" size 0x{:X} -> 0x{:X}", oldType.Size, newType.Size);
+        if (oldType.Inherited != newType.Inherited)
+            report.append(" inherited 0x{:X} -> 0x{:X}", oldType.Inherited, newType.Inherited);
+        report.append("\n");
+
+        if (layoutChanged)
+        {
+            auto newMembers = IndexByName(newDb.MembersOf(newType), [&newDb](const SDKDatabase::Member &m) { return newDb.GetString(m.Name); });
+            std::unordered_map<std::string_view, char> seen;
+
+            for (const auto &oldMember : oldDb.MembersOf(oldType))
+            {
+                if (IsPadding(oldMember))
+                    continue;
+
+                std::string_view name = oldDb.GetString(oldMember.Name);
+                auto mit = newMembers.find(name);
+                if (mit == newMembers.end())
+                {
+                    report.append("\t- {} 0x{:X}\n", name, oldMember.Offset);
+                    stats.MembersChanged++;
+                    continue;
+                }
+                seen.emplace(name, 1);
+
+                const SDKDatabase::Member &newMember = *mit->second;
+                std::string_view oldTypeName = oldDb.GetString(oldMember.Type), newTypeName = newDb.GetString(newMember.Type);
+                if (oldMember.Offset == newMember.Offset && oldMember.Size == newMember.Size && oldTypeName == newTypeName)
+                    continue;
+
+                report.append("\t~ {} 0x{:X}(0x{:X}) -> 0x{:X}(0x{:X})", name, oldMember.Offset, oldMember.Size, newMember.Offset, newMember.Size);
+                if (oldTypeName != newTypeName)
+                    report.append(" {} -> {}", oldTypeName, newTypeName);
+                report.append("\n");
+                stats.MembersChanged++;
+            }
+
+            for (const auto &newMember : newDb.MembersOf(newType))
+            {
+                std::string_view name = newDb.GetString(newMember.Name);
+                if (IsPadding(newMember) || seen.count(name))
+                    continue;
+
+                report.append("\t+ {} 0x{:X}(0x{:X}) {}\n", name, newMember.Offset, newMember.Size, newDb.GetString(newMember.Type));
+                stats.MembersChanged++;
+            }
+        }
+
+        if (functionsChanged)
+        {
+            auto newFunctions = IndexByName(newDb.FunctionsOf(newType), [&newDb](const SDKDatabase::Function &f) { return newDb.GetString(f.Name); });
+            std::unordered_map<std::string_view, char> seen;
+
+            for (const auto &oldFunction : oldDb.FunctionsOf(oldType))
+            {
+                std::string_view name = oldDb.GetString(oldFunction.Name);
+                auto fit = newFunctions.find(name);
+                if (fit == newFunctions.end())
+                {
+                    report.append("\tfn - {}\n", name);
+                    stats.FunctionsChanged++;
+                    continue;
+                }
+                seen.emplace(name, 1);
+
+                if (oldFunction.Offset != fit->second->Offset)
+                {
+                    report.append("\tfn ~ {} 0x{:X} -> 0x{:X}\n", name, oldFunction.Offset, fit->second->Offset);
+                    stats.FunctionsChanged++;
+                }
+            }
+
+            for (const auto &newFunction : newDb.FunctionsOf(newType))
+            {
+                std::string_view name = newDb.GetString(newFunction.Name);
+                if (seen.count(name))
+                    continue;
+
+                report.append("\tfn + {} 0x{:X}\n", name, newFunction.Offset);
+                stats.FunctionsChanged++;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < newDb.Types().size(); i++)
+    {
+        if (newTypesMatched[i])
+            continue;
+
+        const auto &newType = newDb.Types()[i];
+        report.append("+ {} size 0x{:X}\n", newDb.GetString(newType.FullName), newType.Size);
+        stats.TypesAdded++;
+    }
+
+    auto newEnums = IndexByName(newDb.Enums(), [&newDb](const SDKDatabase::Enum &e) { return newDb.GetString(e.FullName); });
+    std::vector<char> newEnumsMatched(newDb.Enums().size(), 0);
+
+    for (const auto &oldEnum : oldDb.Enums())
+    {
+        std::string_view fullName = oldDb.GetString(oldEnum.FullName);
+        auto it = newEnums.find(fullName);
+        if (it == newEnums.end())
+        {
+            report.append("- {}\n", fullName);
+            stats.EnumsRemoved++;
+            continue;
+        }
+
+        newEnumsMatched[it->second - newDb.Enums().begin()] = 1;
+        if (EnumHash(oldDb, oldEnum) != EnumHash(newDb, *it->second))
+        {
+            report.append("~ {} values {} -> {}\n", fullName, oldEnum.ValuesCount, it->second->ValuesCount);
+            stats.EnumsChanged++;
+        }
+    }
+
+    for (uint32_t i = 0; i < newDb.Enums().size(); i++)
+    {
+        if (!newEnumsMatched[i])
+        {
+            report.append("+ {}\n", newDb.GetString(newDb.Enums()[i].FullName));
+            stats.EnumsAdded++;
+        }
+    }
+
+    report.append("\nTypes: +{} -{} ~{}\nMembers changed: {}\nFunctions changed: {}\nEnums: +{} -{} ~{}\n",
+                  stats.TypesAdded, stats.TypesRemoved, stats.TypesChanged,
+                  stats.MembersChanged, stats.FunctionsChanged,
+                  stats.EnumsAdded, stats.EnumsRemoved, stats.EnumsChanged);
+
+    return stats;
+}
+
+bool SDKDatabaseDiff::CompareFiles(const std::string &oldPath, const std::string &newPath, BufferFmt &report, Stats *stats, std::string *error)
+{
+    MappedFile oldFile, newFile;
+    SDKDatabase::Reader oldDb, newDb;
+
+    if (!oldFile.Open(oldPath) || !oldDb.Open(oldFile.data(), oldFile.size()))
+    {
+        if (error) *error = "couldn't load " + oldPath;
+        return false;
+    }
+
+    if (!newFile.Open(newPath) || !newDb.Open(newFile.data(), newFile.size()))
+    {
+        if (error) *error = "couldn't load " + newPath;
+        return false;
+    }
+
+    report.append("# {} -> {}\n", oldPath, newPath);
+    Stats result = Compare(oldDb, newDb, report);
+    if (stats) *stats = result;
+    return true;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "SDKDatabase.hpp"
+
+#include "Utils/BufferFmt.hpp"
+
+// Structural diff of two SDK.db files.
+// Types & enums are matched by full name, members & functions are only compared
+// for types whose layout or functions hash differs.
+class SDKDatabaseDiff
+{
+public:
+    struct Stats
+    {
+        size_t TypesAdded = 0, TypesRemoved = 0, TypesChanged = 0;
+        size_t MembersChanged = 0, FunctionsChanged = 0;
+        size_t EnumsAdded = 0, EnumsRemoved = 0, EnumsChanged = 0;
+    };
+
+    static Stats Compare(const SDKDatabase::Reader &oldDb, const SDKDatabase::Reader &newDb, BufferFmt &report);
+
+    // Map both files and compare them, false with error set if one couldn't be loaded
+    static bool CompareFiles(const std::string &oldPath, const std::string &newPath, BufferFmt &report, Stats *stats, std::string *error);
+};
@@ -0,0 +1,238 @@
+#include "SDKDatabaseWriter.hpp"
+
+namespace
+{
+    // local string index in a fragment
+    struct FragmentStrings
+    {
+        std::vector<std::string> &strings;
+        std::unordered_map<std::string, uint32_t> map;
+
+        uint32_t operator()(const std::string &str)
+        {
+            auto it = map.find(str);
+            if (it != map.end())
+                return it->second;
+
+            uint32_t id = uint32_t(strings.size());
+            map.emplace(str, id);
+            strings.push_back(str);
+            return id;
+        }
+    };
+
+    uint32_t MemberFlags(const UE_UPackage::Member &m)
+    {
+        uint32_t flags = 0;
+        if (m.Name.compare(0, 4, "Pad_") == 0 || m.Name.compare(0, 7, "BitPad_") == 0)
+            flags |= SDKDatabase::MEMBER_Padding;
+        if (m.Name.find(" : ") != std::string::npos)
+            flags |= SDKDatabase::MEMBER_BitField;
+        return flags;
+    }
+
+    size_t AlignUp(size_t value, size_t align)
+    {
+        return (value + align - 1) / align * align;
+    }
+}  // namespace
+
+SDKDatabaseWriter::Fragment SDKDatabaseWriter::BuildFragment(const std::string &packageName,
+                                                             const std::vector<UE_UPackage::Enum> &enums,
+                                                             const std::vector<UE_UPackage::Struct> &structs,
+                                                             const std::vector<UE_UPackage::Struct> &classes,
+                                                             uintptr_t baseAddress)
+{
+    Fragment fragment;
+    FragmentStrings str{fragment.Strings, {}};
+
+    fragment.Package.Name = str(packageName);
+    fragment.Package.TypesCount = uint32_t(structs.size() + classes.size());
+    fragment.Package.EnumsCount = uint32_t(enums.size());
+
+    for (const auto &e : enums)
+    {
+        SDKDatabase::Enum rec{};
+        rec.FullName = str(e.FullName);
+        rec.CppName = str(e.CppName);
+        rec.FirstValue = uint32_t(fragment.EnumValues.size());
+        rec.ValuesCount = uint32_t(e.Members.size());
+        fragment.Enums.push_back(rec);
+
+        for (const auto &value : e.Members)
+            fragment.EnumValues.push_back({str(value.first), 0, value.second});
+    }
+
+    auto addStruct = [&](const UE_UPackage::Struct &s, uint32_t flags)
+    {
+        SDKDatabase::Type rec{};
+        rec.Name = str(s.Name);
+        rec.FullName = str(s.FullName);
+        rec.CppName = str(s.CppName);
+        rec.Flags = flags;
+        rec.Size = s.Size;
+        rec.Inherited = s.Inherited;
+        rec.FirstMember = uint32_t(fragment.Members.size());
+        rec.MembersCount = uint32_t(s.Members.size());
+        rec.FirstFunction = uint32_t(fragment.Functions.size());
+        rec.FunctionsCount = uint32_t(s.Functions.size());
+        fragment.Types.push_back(rec);
+
+        for (const auto &m : s.Members)
+            fragment.Members.push_back({str(m.Type), str(m.Name), str(m.extra), m.Offset, m.Size, MemberFlags(m)});
+
+        for (const auto &f : s.Functions)
+        {
+            SDKDatabase::Function fn{};
+            fn.Name = str(f.Name);
+            fn.FullName = str(f.FullName);
+            fn.CppName = str(f.CppName);
+            fn.Params = str(f.Params);
+            fn.Flags = str(f.Flags);
+            fn.EFlags = f.EFlags;
+            fn.Offset = f.Func > baseAddress ? uint64_t(f.Func - baseAddress) : 0;
+            fn.NumParams = f.NumParams;
+            fn.ParamSize = f.ParamSize;
+            fragment.Functions.push_back(fn);
+        }
+    };
+
+    for (const auto &s : structs)
+        addStruct(s, SDKDatabase::TYPE_Struct);
+    for (const auto &c : classes)
+        addStruct(c, SDKDatabase::TYPE_Class);
+
+    return fragment;
+}
+
+SDKDatabase::StringRef SDKDatabaseWriter::intern(const std::string &str)
+{
+    auto it = _stringsMap.find(str);
+    if (it != _stringsMap.end())
+        return it->second;
+
+    SDKDatabase::StringRef ref = SDKDatabase::StringRef(_strings.size());
+    uint32_t len = uint32_t(str.size());
+    _strings.append(reinterpret_cast<const char *>(&len), sizeof(len));
+    _strings.append(str);
+    _strings.push_back('\0');
+
+    _stringsMap.emplace(str, ref);
+    return ref;
+}
+
+void SDKDatabaseWriter::Append(Fragment &&fragment, bool extendLast)
+{
+    std::vector<SDKDatabase::StringRef> refs(fragment.Strings.size());
+    for (size_t i = 0; i < fragment.Strings.size(); i++)
+        refs[i] = intern(fragment.Strings[i]);
+
+    const uint32_t typesBase = uint32_t(_types.size());
+    const uint32_t membersBase = uint32_t(_members.size());
+    const uint32_t functionsBase = uint32_t(_functions.size());
+    const uint32_t enumsBase = uint32_t(_enums.size());
+    const uint32_t enumValuesBase = uint32_t(_enumValues.size());
+
+    if (extendLast && !_packages.empty())
+    {
+        _packages.back().TypesCount += fragment.Package.TypesCount;
+        _packages.back().EnumsCount += fragment.Package.EnumsCount;
+    }
+    else
+    {
+        SDKDatabase::Package package = fragment.Package;
+        package.Name = refs[package.Name];
+        package.FirstType = typesBase;
+        package.FirstEnum = enumsBase;
+        _packages.push_back(package);
+    }
+
+    for (auto it : fragment.Types)
+    {
+        it.Name = refs[it.Name];
+        it.FullName = refs[it.FullName];
+        it.CppName = refs[it.CppName];
+        it.FirstMember += membersBase;
+        it.FirstFunction += functionsBase;
+        _types.push_back(it);
+    }
+
+    for (auto it : fragment.Members)
+    {
+        it.Type = refs[it.Type];
+        it.Name = refs[it.Name];
+        it.Extra = refs[it.Extra];
+        _members.push_back(it);
+    }
+
+    for (auto it : fragment.Functions)
+    {
+        it.Name = refs[it.Name];
+        it.FullName = refs[it.FullName];
+        it.CppName = refs[it.CppName];
+        it.Params = refs[it.Params];
+        it.Flags = refs[it.Flags];
+        _functions.push_back(it);
+    }
+
+    for (auto it : fragment.Enums)
+    {
+        it.FullName = refs[it.FullName];
+        it.CppName = refs[it.CppName];
+        it.FirstValue += enumValuesBase;
+        _enums.push_back(it);
+    }
+
+    for (auto it : fragment.EnumValues)
+    {
+        it.Name = refs[it.Name];
+        _enumValues.push_back(it);
+    }
+
+    fragment = Fragment();
+}
+
+void SDKDatabaseWriter::Write(BufferFmt &out) const
+{
+    SDKDatabase::Header header{};
+    memcpy(header.Magic, SDKDatabase::kMagic, sizeof(header.Magic));
+    header.Version = SDKDatabase::kVersion;
+    header.HeaderSize = sizeof(header);
+
+    // layout: header, then each table 8 aligned
+    size_t offset = sizeof(header);
+    auto place = [&offset](SDKDatabase::TableRef &ref, size_t count, size_t recordSize)
+    {
+        offset = AlignUp(offset, 8);
+        ref.Offset = uint32_t(offset);
+        ref.Count = uint32_t(count);
+        offset += count * recordSize;
+    };
+
+    place(header.Packages, _packages.size(), sizeof(SDKDatabase::Package));
+    place(header.Types, _types.size(), sizeof(SDKDatabase::Type));
+    place(header.Members, _members.size(), sizeof(SDKDatabase::Member));
+    place(header.Functions, _functions.size(), sizeof(SDKDatabase::Function));
+    place(header.Enums, _enums.size(), sizeof(SDKDatabase::Enum));
+    place(header.EnumValues, _enumValues.size(), sizeof(SDKDatabase::EnumValue));
+    place(header.Strings, _strings.size(), 1);
+
+    size_t written = 0;
+    auto write = [&out, &written](const void *data, size_t size, size_t at)
+    {
+        static const char zeros[8] = {};
+        if (at > written)
+            out.appendRaw(zeros, at - written);
+        out.appendRaw(data, size);
+        written = at + size;
+    };
+
+    write(&header, sizeof(header), 0);
+    write(_packages.data(), _packages.size() * sizeof(SDKDatabase::Package), header.Packages.Offset);
+    write(_types.data(), _types.size() * sizeof(SDKDatabase::Type), header.Types.Offset);
+    write(_members.data(), _members.size() * sizeof(SDKDatabase::Member), header.Members.Offset);
+    write(_functions.data(), _functions.size() * sizeof(SDKDatabase::Function), header.Functions.Offset);
+    write(_enums.data(), _enums.size() * sizeof(SDKDatabase::Enum), header.Enums.Offset);
+    write(_enumValues.data(), _enumValues.size() * sizeof(SDKDatabase::EnumValue), header.EnumValues.Offset);
+    write(_strings.data(), _strings.size(), header.Strings.Offset);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "SDKDatabase.hpp"
+#include "UPackageGenerator.hpp"
+
+#include "Utils/BufferFmt.hpp"
+
+// Builds SDK.db from the same generated package data as AIOHeader.hpp.
+// Packages are converted concurrently into fragments, then appended in output order.
+class SDKDatabaseWriter
+{
+public:
+    // one package, strings are indices in Strings until appended
+    struct Fragment
+    {
+        SDKDatabase::Package Package{};
+        std::vector<SDKDatabase::Type> Types;
+        std::vector<SDKDatabase::Member> Members;
+        std::vector<SDKDatabase::Function> Functions;
+        std::vector<SDKDatabase::Enum> Enums;
+        std::vector<SDKDatabase::EnumValue> EnumValues;
+        std::vector<std::string> Strings;
+    };
+
+    static Fragment BuildFragment(const std::string &packageName,
+                                  const std::vector<UE_UPackage::Enum> &enums,
+                                  const std::vector<UE_UPackage::Struct> &structs,
+                                  const std::vector<UE_UPackage::Struct> &classes,
+                                  uintptr_t baseAddress);
+
+    // extendLast appends the fragment to the last appended package, for packages generated in parts
+    void Append(Fragment &&fragment, bool extendLast = false);
+
+    // Write the whole database to out
+    void Write(BufferFmt &out) const;
+
+private:
+    std::vector<SDKDatabase::Package> _packages;
+    std::vector<SDKDatabase::Type> _types;
+    std::vector<SDKDatabase::Member> _members;
+    std::vector<SDKDatabase::Function> _functions;
+    std::vector<SDKDatabase::Enum> _enums;
+    std::vector<SDKDatabase::EnumValue> _enumValues;
+
+    std::string _strings;
+    std::unordered_map<std::string, SDKDatabase::StringRef> _stringsMap;
+
+    SDKDatabase::StringRef intern(const std::string &str);
+};
@@ -0,0 +1,222 @@
+#include "UEDumpFilter.hpp"
+
+#include <cstring>
+
+namespace
+{
+    bool StartsWith(const std::string &str, const char *prefix, size_t *prefixLen)
+    {
+        size_t len = strlen(prefix);
+        if (str.compare(0, len, prefix) != 0)
+            return false;
+
+        *prefixLen = len;
+        return true;
+    }
+
+    std::string GlobToRegex(const std::string &glob)
+    {
+        std::string re;
+        re.reserve(glob.size() * 2);
+        for (char c : glob)
+        {
+            switch (c)
+            {
+            case '*':
+                re += ".*";
+                break;
+            case '?':
+                re += '.';
+                break;
+            case '.': case '^': case '$': case '|': case '(': case ')':
+            case '[': case ']': case '{': case '}': case '+': case '\\':
+                re += '\\';
+                re += c;
+                break;
+            default:
+                re += c;
+                break;
+            }
+        }
+        return re;
+    }
+}  // namespace
+
+void UEDumpFilter::PrefixTrie::Insert(const std::string &prefix)
+{
+    uint32_t node = 0;
+    for (char c : prefix)
+    {
+        auto it = _nodes[node].Children.find(c);
+        if (it != _nodes[node].Children.end())
+        {
+            node = it->second;
+            continue;
+        }
+
+        uint32_t child = uint32_t(_nodes.size());
+        _nodes[node].Children.emplace(c, child);
+        _nodes.emplace_back();
+        node = child;
+    }
+    _nodes[node].Terminal = true;
+}
+
+bool UEDumpFilter::PrefixTrie::MatchPrefix(const std::string &str) const
+{
+    uint32_t node = 0;
+    if (_nodes[node].Terminal)
+        return true;
+
+    for (char c : str)
+    {
+        auto it = _nodes[node].Children.find(c);
+        if (it == _nodes[node].Children.end())
+            return false;
+
+        node = it->second;
+        if (_nodes[node].Terminal)
+            return true;
+    }
+    return false;
+}
+
+bool UEDumpFilter::RuleSet::Match(const std::string &str) const
+{
+    if (Exact.count(str) || Prefixes.MatchPrefix(str))
+        return true;
+
+    for (const auto &re : Patterns)
+    {
+        if (std::regex_match(str, re))
+            return true;
+    }
+    return false;
+}
+
+bool UEDumpFilter::AddRule(const std::string &rule, std::string *error)
+{
+    std::string pattern = rule;
+    bool include = false;
+
+    if (!pattern.empty() && (pattern[0] == '+' || pattern[0] == '-'))
+    {
+        include = pattern[0] == '+';
+        pattern.erase(0, 1);
+    }
+
+    EScope scope = EScope::FullName;
+    size_t len = 0;
+    if (StartsWith(pattern, "package:", &len))
+        scope = EScope::Package;
+    else if (StartsWith(pattern, "class:", &len))
+        scope = EScope::Class;
+    else if (StartsWith(pattern, "full:", &len))
+        scope = EScope::FullName;
+    pattern.erase(0, len);
+
+    bool isRegex = false;
+    len = 0;
+    if (StartsWith(pattern, "re:", &len))
+    {
+        isRegex = true;
+        pattern.erase(0, len);
+    }
+
+    if (pattern.empty())
+    {
+        if (error) *error = "empty pattern in rule \"" + rule + "\"";
+        return false;
+    }
+
+    RuleSet &set = include ? _includes[size_t(scope)] : _excludes[size_t(scope)];
+
+    if (!isRegex)
+    {
+        size_t wildcard = pattern.find_first_of("*?");
+        if (wildcard == std::string::npos)
+        {
+            set.Exact.insert(pattern);
+            return true;
+        }
+
+        if (wildcard == pattern.size() - 1 && pattern.back() == '*')
+        {
+            set.Prefixes.Insert(pattern.substr(0, wildcard));
+            return true;
+        }
+
+        pattern = GlobToRegex(pattern);
+    }
+
+    try
+    {
+        set.Patterns.emplace_back(pattern, std::regex::ECMAScript | std::regex::optimize);
+    }
+    catch (const std::regex_error &e)
+    {
+        if (error) *error = "bad regex in rule \"" + rule + "\": " + e.what();
+        return false;
+    }
+
+    return true;
+}
+
+bool UEDumpFilter::AddRules(const std::string &rules, char separator, char defaultSign, std::string *error)
+{
+    size_t start = 0;
+    while (start <= rules.size())
+    {
+        size_t end = rules.find(separator, start);
+        if (end == std::string::npos)
+            end = rules.size();
+
+        if (end > start)
+        {
+            std::string rule = rules.substr(start, end - start);
+            if (rule[0] != '+' && rule[0] != '-')
+                rule.insert(rule.begin(), defaultSign);
+
+            if (!AddRule(rule, error))
+                return false;
+        }
+
+        start = end + 1;
+    }
+    return true;
+}
+
+bool UEDumpFilter::Empty() const
+{
+    for (size_t i = 0; i < size_t(EScope::Count); i++)
+    {
+        if (!_includes[i].Empty() || !_excludes[i].Empty())
+            return false;
+    }
+    return true;
+}
+
+bool UEDumpFilter::HasTypeRules() const
+{
+    return !includes(EScope::Class).Empty() || !excludes(EScope::Class).Empty() ||
+           !includes(EScope::FullName).Empty() || !excludes(EScope::FullName).Empty();
+}
+
+bool UEDumpFilter::IsPackageIncluded(const std::string &packageName) const
+{
+    if (excludes(EScope::Package).Match(packageName))
+        return false;
+
+    return includes(EScope::Package).Empty() || includes(EScope::Package).Match(packageName);
+}
+
+bool UEDumpFilter::IsTypeIncluded(const std::string &name, const std::string &fullName) const
+{
+    if (excludes(EScope::Class).Match(name) || excludes(EScope::FullName).Match(fullName))
+        return false;
+
+    if (includes(EScope::Class).Empty() && includes(EScope::FullName).Empty())
+        return true;
+
+    return includes(EScope::Class).Match(name) || includes(EScope::FullName).Match(fullName);
+}
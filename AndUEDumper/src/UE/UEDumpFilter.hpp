@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <regex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Include/exclude rules that scope a dump, compiled once when added.
+// Rule format: [+|-][package:|class:|full:]pattern
+//  + include, - exclude (default)
+// Names are matched as the dumper reads them, without the path before the last '/'
+//  package: package name, Engine
+//  class: object name, Vector
+//  full: object full name, ScriptStruct CoreUObject.Vector (default)
+// Pattern is an exact name, a glob with * and ?, or an ECMAScript regex with "re:" prefix.
+// Examples: -package:Niagara*  +class:re:^(Actor|Pawn)$  -full:ScriptStruct CoreUObject.Vector
+class UEDumpFilter
+{
+public:
+    enum class EScope : uint8_t
+    {
+        Package,
+        Class,
+        FullName,
+        Count
+    };
+
+    UEDumpFilter() = default;
+
+    // false if the rule couldn't be parsed, error is set
+    bool AddRule(const std::string &rule, std::string *error = nullptr);
+
+    // Add rules split by separator, rules without a sign get defaultSign. Stops at the first bad one
+    bool AddRules(const std::string &rules, char separator, char defaultSign, std::string *error = nullptr);
+
+    bool Empty() const;
+
+    // any class or full name rules
+    bool HasTypeRules() const;
+
+    bool IsPackageIncluded(const std::string &packageName) const;
+
+    bool IsTypeIncluded(const std::string &name, const std::string &fullName) const;
+
+private:
+    // "abc*" globs, matches if any pattern is a prefix of the string
+    class PrefixTrie
+    {
+        struct Node
+        {
+            std::unordered_map<char, uint32_t> Children;
+            bool Terminal = false;
+        };
+        std::vector<Node> _nodes;
+
+    public:
+        PrefixTrie() : _nodes(1) {}
+
+        void Insert(const std::string &prefix);
+        bool MatchPrefix(const std::string &str) const;
+        inline bool Empty() const { return _nodes.size() == 1 && !_nodes[0].Terminal; }
+    };
+
+    // rules of one scope, split by how they're matched
+    struct RuleSet
+    {
+        std::unordered_set<std::string> Exact;
+        PrefixTrie Prefixes;
+        std::vector<std::regex> Patterns;
+
+        inline bool Empty() const { return Exact.empty() && Prefixes.Empty() && Patterns.empty(); }
+        bool Match(const std::string &str) const;
+    };
+
+    RuleSet _includes[size_t(EScope::Count)];
+    RuleSet _excludes[size_t(EScope::Count)];
+
+    inline const RuleSet &includes(EScope scope) const { return _includes[size_t(scope)]; }
+    inline const RuleSet &excludes(EScope scope) const { return _excludes[size_t(scope)]; }
+};
@@ -0,0 +1,211 @@
+#include "UEEngineVersion.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <fmt/format.h>
+
+using namespace UEMemory;
+
+namespace
+{
+    constexpr size_t kReadChunkSize = 0x100000;
+    // longest "Major.Minor" after a branch marker
+    constexpr size_t kMaxMajorMinorChars = 8;
+
+    const char *const kBranchMarkers[] = {"++UE4+Release-", "++UE5+Release-"};
+
+    struct CachedSegment
+    {
+        uintptr_t Start = 0;
+        std::vector<uint8_t> Data;
+    };
+
+    std::vector<CachedSegment> CacheSegments(const ElfScanner &elf)
+    {
+        std::vector<KittyMemoryEx::ProcMap> maps;
+        for (const auto &seg : elf.segments())
+        {
+            if (seg.readable && !seg.writeable && !seg.executable)
+                maps.push_back(seg);
+        }
+        if (maps.empty())
+        {
+            for (const auto &seg : elf.segments())
+            {
+                if (seg.readable && !seg.writeable)
+                    maps.push_back(seg);
+            }
+        }
+
+        std::vector<CachedSegment> cached(maps.size());
+        for (size_t i = 0; i < maps.size(); i++)
+        {
+            cached[i].Start = maps[i].startAddress;
+            cached[i].Data.resize(maps[i].length);
+
+            for (size_t off = 0; off < cached[i].Data.size(); off += kReadChunkSize)
+            {
+                size_t len = std::min(kReadChunkSize, cached[i].Data.size() - off);
+                if (!vm_rpm_ptr((void *)(maps[i].startAddress + off), cached[i].Data.data() + off, len))
+                    memset(cached[i].Data.data() + off, 0, len);
+            }
+        }
+        return cached;
+    }
+
+    // ASCII as is, width 2 is TCHAR on Android, UTF-16LE
+    std::string Encode(const char *s, size_t width)
+    {
+        std::string encoded;
+        for (; *s; s++)
+        {
+            encoded.push_back(*s);
+            if (width == 2)
+                encoded.push_back('\0');
+        }
+        return encoded;
+    }
+
+    char CharAt(const uint8_t *p, size_t width)
+    {
+        if (width == 2 && p[1] != 0)
+            return 0;
+
+        return char(p[0]);
+    }
+
+    inline bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+    // digits ending right before p, moves p to their start
+    bool ReadNumberBack(const uint8_t *begin, const uint8_t *&p, size_t width, uint64_t *value)
+    {
+        const uint8_t *end = p;
+        while (p - begin >= ptrdiff_t(width) && IsDigit(CharAt(p - width, width)))
+            p -= width;
+
+        if (p == end || (end - p) / width > 10)
+            return false;
+
+        *value = 0;
+        for (const uint8_t *c = p; c < end; c += width)
+            *value = *value * 10 + uint64_t(CharAt(c, width) - '0');
+        return true;
+    }
+
+    bool ExpectBack(const uint8_t *begin, const uint8_t *&p, size_t width, char c)
+    {
+        if (p - begin < ptrdiff_t(width) || CharAt(p - width, width) != c)
+            return false;
+
+        p -= width;
+        return true;
+    }
+
+    // "4.27" following the branch marker
+    bool ParseMajorMinor(const uint8_t *p, const uint8_t *end, size_t width, int *major, int *minor)
+    {
+        std::string text;
+        for (; p + width <= end && text.size() < kMaxMajorMinorChars; p += width)
+        {
+            char c = CharAt(p, width);
+            if (!IsDigit(c) && c != '.')
+                break;
+            text.push_back(c);
+        }
+
+        if (sscanf(text.c_str(), "%d.%d", major, minor) != 2)
+            return false;
+
+        return *major >= 4 && *major <= 5 && *minor >= 0 && *minor < 100;
+    }
+
+    // "4.27.2-18319896+" right before the branch marker
+    bool ParseVersionPrefix(const uint8_t *begin, const uint8_t *marker, size_t width, UEEngineVersion *version)
+    {
+        const uint8_t *p = marker;
+        uint64_t major = 0, minor = 0, patch = 0, changelist = 0;
+
+        if (!ExpectBack(begin, p, width, '+') ||
+            !ReadNumberBack(begin, p, width, &changelist) || !ExpectBack(begin, p, width, '-') ||
+            !ReadNumberBack(begin, p, width, &patch) || !ExpectBack(begin, p, width, '.') ||
+            !ReadNumberBack(begin, p, width, &minor) || !ExpectBack(begin, p, width, '.') ||
+            !ReadNumberBack(begin, p, width, &major))
+            return false;
+
+        if (int(major) != version->Major || int(minor) != version->Minor || patch > 99 || changelist > UINT32_MAX)
+            return false;
+
+        version->Patch = int(patch);
+        version->Changelist = uint32_t(changelist);
+        return true;
+    }
+}  // namespace
+
+std::string UEEngineVersion::ToString() const
+{
+    if (!IsValid())
+        return "Unknown";
+
+    if (Patch < 0)
+        return fmt::format("{}.{} ({})", Major, Minor, Branch);
+
+    return fmt::format("{}.{}.{}-{}+{}", Major, Minor, Patch, Changelist, Branch);
+}
+
+const char *UEEngineVersion::GetDefaultOffsetsName() const
+{
+    return IsValid() ? UE_DefaultOffsets::TableNameForEngineVersion(Major, Minor) : nullptr;
+}
+
+UE_Offsets UEEngineVersion::GetDefaultOffsets(bool bWITH_CASE_PRESERVING_NAME, bool bFNAME_OUTLINE_NUMBER) const
+{
+    return UE_DefaultOffsets::ForEngineVersion(Major, Minor, bWITH_CASE_PRESERVING_NAME, bFNAME_OUTLINE_NUMBER);
+}
+
+UEEngineVersion UEEngineVersion::Detect(const ElfScanner &elf)
+{
+    UEEngineVersion best;
+    if (!elf.isValid())
+        return best;
+
+    std::vector<CachedSegment> segments = CacheSegments(elf);
+
+    for (size_t width : {size_t(1), size_t(2)})
+    {
+        for (const char *marker : kBranchMarkers)
+        {
+            std::string needle = Encode(marker, width);
+            for (const auto &seg : segments)
+            {
+                const uint8_t *data = seg.Data.data(), *end = data + seg.Data.size();
+                for (const uint8_t *p = data; p < end; p += needle.size())
+                {
+                    p = (const uint8_t *)memmem(p, size_t(end - p), needle.data(), needle.size());
+                    if (!p)
+                        break;
+
+                    UEEngineVersion found;
+                    if (!ParseMajorMinor(p + needle.size(), end, width, &found.Major, &found.Minor))
+                        continue;
+
+                    found.Branch = fmt::format("{}{}.{}", marker, found.Major, found.Minor);
+                    ParseVersionPrefix(data, p, width, &found);
+
+                    // the full version string wins over a bare branch name
+                    if (!best.IsValid() || (best.Patch < 0 && found.Patch >= 0))
+                        best = found;
+
+                    if (best.Patch >= 0)
+                        return best;
+                }
+            }
+        }
+    }
+
+    // a bare FEngineVersionBase { Major, Minor, Patch, Changelist } is too common a pattern among small
+    // constants to be told apart, the patch is left unknown rather than guessed
+    return best;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "UEMemory.hpp"
+#include "UEOffsets.hpp"
+
+// Engine version read from the UE library's constant data: the branch name "++UE4+Release-4.27"
+// and the version string "4.27.2-18319896+++UE4+Release-4.27" around it.
+struct UEEngineVersion
+{
+    int Major = 0;
+    int Minor = 0;
+    // -1 if the full version string wasn't found
+    int Patch = -1;
+    uint32_t Changelist = 0;
+    std::string Branch;
+
+    inline bool IsValid() const { return Major > 0; }
+
+    std::string ToString() const;
+
+    // UE_DefaultOffsets table name, nullptr if not valid or unknown
+    const char *GetDefaultOffsetsName() const;
+    UE_Offsets GetDefaultOffsets(bool bWITH_CASE_PRESERVING_NAME, bool bFNAME_OUTLINE_NUMBER) const;
+
+    // Read-only segments are copied once into a local cache and every marker, ASCII & UTF-16,
+    // is searched in it, falls back to all non-writable segments when .rodata is merged into text
+    static UEEngineVersion Detect(const ElfScanner &elf);
+};
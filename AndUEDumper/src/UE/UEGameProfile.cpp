@@ -1,13 +1,29 @@
 #include "UEGameProfile.hpp"
 
+#include <atomic>
+
 #include "UEMemory.hpp"
 #include "UEWrappers.hpp"
 
+#include "../Utils/ThreadPool.hpp"
+#include "../Utils/TraceUtils.hpp"
+
 using namespace UEMemory;
 
-UEVarsInitStatus IGameProfile::InitUEVars()
+UEVarsInitStatus IGameProfile::InitUEVars(const UE_Pointers *cached)
 {
-    bool is32Bit = KittyMemoryEx::getMaps(kMgr.processID(), EProcMapFilter::EndWith, "/linker64").empty();
+    TRACE_SCOPE("IGameProfile::InitUEVars");
+
+    // 64bit loaders of Android and of Linux hosts running the fixture
+    bool is32Bit = true;
+    for (const char *loader : {"/linker64", "/ld-linux-x86-64.so.2", "/ld-linux-aarch64.so.1"})
+    {
+        if (!KittyMemoryEx::getMaps(kMgr.processID(), EProcMapFilter::EndWith, loader).empty())
+        {
+            is32Bit = false;
+            break;
+        }
+    }
     if (is32Bit)
     {
         if (sizeof(void *) != 4)
@@ -63,7 +79,11 @@ UEVarsInitStatus IGameProfile::InitUEVars()
 
     _UEVars.Offsets = pOffsets;
 
-    _UEVars.NamesPtr = GetNamesPtr();
+    bool useCached = cached && cached->Names && cached->UObjectArray &&
+                     kPtrValidator.isPtrReadable(_UEVars.BaseAddress + cached->Names) &&
+                     kPtrValidator.isPtrReadable(_UEVars.BaseAddress + cached->UObjectArray);
+
+    _UEVars.NamesPtr = useCached ? (_UEVars.BaseAddress + cached->Names) : GetNamesPtr();
     if (IsUsingFNamePool())
     {
         if (!kPtrValidator.isPtrReadable(_UEVars.NamesPtr))
@@ -73,6 +93,10 @@ UEVarsInitStatus IGameProfile::InitUEVars()
     {
         if (!kPtrValidator.isPtrReadable(_UEVars.NamesPtr))
             return UEVarsInitStatus::ERROR_INIT_GNAMES;
+
+        _UEVars.GNamesTable = vm_rpm_ptr<uintptr_t>((void *)_UEVars.NamesPtr);
+        if (!kPtrValidator.isPtrReadable(_UEVars.GNamesTable))
+            return useCached ? InitUEVars(nullptr) : UEVarsInitStatus::ERROR_INIT_GNAMES;
     }
 
     _UEVars.pGetNameByID = [this](int32_t id) -> std::string
@@ -80,7 +104,7 @@ UEVarsInitStatus IGameProfile::InitUEVars()
         return GetNameByID(id);
     };
 
-    _UEVars.GUObjectsArrayPtr = GetGUObjectArrayPtr();
+    _UEVars.GUObjectsArrayPtr = useCached ? (_UEVars.BaseAddress + cached->UObjectArray) : GetGUObjectArrayPtr();
     if (!kPtrValidator.isPtrReadable(_UEVars.GUObjectsArrayPtr))
         return UEVarsInitStatus::ERROR_INIT_GUOBJECTARRAY;
 
@@ -88,13 +112,109 @@ UEVarsInitStatus IGameProfile::InitUEVars()
 
     if (!vm_rpm_ptr((void *)(_UEVars.ObjObjectsPtr + pOffsets->TUObjectArray.Objects),
                     &_UEVars.ObjObjects_Objects, sizeof(uintptr_t)))
-        return UEVarsInitStatus::ERROR_INIT_OBJOBJECTS;
+        return useCached ? InitUEVars(nullptr) : UEVarsInitStatus::ERROR_INIT_OBJOBJECTS;
 
     UEWrappers::Init(GetUEVars());
 
+    // cheap sanity check of cached pointers, scan again if the names or the first object are off
+    if (useCached)
+    {
+        UE_UObject firstObject = UEWrappers::GetObjects()->GetObjectPtr(0);
+        if (GetNameByID(0) != "None" || !firstObject || firstObject.GetIndex() != 0)
+        {
+            LOGW("Cached pointers are invalid, scanning again.");
+            return InitUEVars(nullptr);
+        }
+    }
+
     return UEVarsInitStatus::SUCCESS;
 }
 
+int IGameProfile::ProbeTarget(UE_Pointers *found) const
+{
+    auto ue_elf = GetUnrealELF();
+    if (!ue_elf.isValid())
+        return 0;
+
+    if (!ArchSupprted() && ue_elf.header().e_machine > 0 && !ue_elf.isFixedBySoInfo())
+        return 0;
+
+    UE_Offsets *offsets = GetOffsets();
+    if (!offsets)
+        return 0;
+
+    int score = 1;
+    uintptr_t baseAddr = ue_elf.base();
+
+    uintptr_t namesPtr = GetNamesPtr();
+    if (namesPtr && kPtrValidator.isPtrReadable(namesPtr))
+    {
+        score++;
+
+        // first names block for FNamePool, the chunks table for GNames
+        uintptr_t names = IsUsingFNamePool() ? vm_rpm_ptr<uintptr_t>((void *)(namesPtr + offsets->FNamePool.BlocksOff))
+                                             : vm_rpm_ptr<uintptr_t>((void *)namesPtr);
+        if (names && kPtrValidator.isPtrReadable(names))
+            score++;
+    }
+
+    uintptr_t objectArrayPtr = GetGUObjectArrayPtr();
+    if (objectArrayPtr && kPtrValidator.isPtrReadable(objectArrayPtr))
+    {
+        score++;
+
+        uintptr_t objObjectsPtr = objectArrayPtr + offsets->FUObjectArray.ObjObjects;
+        uintptr_t objects = vm_rpm_ptr<uintptr_t>((void *)(objObjectsPtr + offsets->TUObjectArray.Objects));
+        int32_t numElements = vm_rpm_ptr<int32_t>((void *)(objObjectsPtr + offsets->TUObjectArray.NumElements));
+        if (objects && kPtrValidator.isPtrReadable(objects) && numElements > 0 && numElements < 0x2000000)
+            score++;
+    }
+
+    if (found)
+    {
+        found->Names = namesPtr ? namesPtr - baseAddr : 0;
+        found->UObjectArray = objectArrayPtr ? objectArrayPtr - baseAddr : 0;
+        found->ObjObjects = objectArrayPtr ? found->UObjectArray + offsets->FUObjectArray.ObjObjects : 0;
+    }
+
+    return score;
+}
+
+UE_Offsets *IGameProfile::GetOffsets() const
+{
+    std::lock_guard<std::mutex> lock(_defaultOffsetsMtx);
+
+    if (!_defaultOffsetsReady)
+    {
+        const UEEngineVersion &version = GetEngineVersion();
+        if (!version.GetDefaultOffsetsName())
+            return nullptr;
+
+        _defaultOffsets = version.GetDefaultOffsets(isUsingCasePreservingName(), isUsingOutlineNumberName());
+        _defaultOffsetsReady = true;
+    }
+
+    return &_defaultOffsets;
+}
+
+const UEEngineVersion &IGameProfile::GetEngineVersion() const
+{
+    std::lock_guard<std::mutex> lock(_engineVersionMtx);
+
+    // not cached until the library is there
+    if (!_engineVersionReady)
+    {
+        auto ue_elf = GetUnrealELF();
+        if (ue_elf.isValid())
+        {
+            _engineVersion = UEEngineVersion::Detect(ue_elf);
+            _engineVersionReady = true;
+        }
+    }
+
+    return _engineVersion;
+}
+
 uint8_t *IGameProfile::GetNameEntry(int32_t id) const
 {
     if (id < 0)
@@ -106,11 +226,9 @@ uint8_t *IGameProfile::GetNameEntry(int32_t id) const
 
     if (!IsUsingFNamePool())
     {
-        static uintptr_t gNames = 0;
+        uintptr_t gNames = _UEVars.GNamesTable;
         if (gNames == 0)
-        {
-            gNames = vm_rpm_ptr<uintptr_t>((void *)namesPtr);
-        }
+            return nullptr;
 
         const int32_t ElementsPerChunk = 16384;
         const int32_t ChunkIndex = id / ElementsPerChunk;
@@ -395,6 +513,8 @@ uintptr_t IGameProfile::findIdaPattern(PATTERN_MAP_TYPE map_type,
                                        const int step,
                                        uint32_t skip_result) const
 {
+    TRACE_SCOPE_DETAIL("IGameProfile::findIdaPattern", pattern);
+
     ElfScanner ue_elf = GetUnrealELF();
     std::vector<KittyMemoryEx::ProcMap> search_segments;
     bool hasBSS = ue_elf.bssSegments().size() > 0;
@@ -425,24 +545,44 @@ uintptr_t IGameProfile::findIdaPattern(PATTERN_MAP_TYPE map_type,
 
     LOGD("search_segments count = %p", (void *)search_segments.size());
 
-    uintptr_t insn_address = 0;
-
-    for (auto &it : search_segments)
+    // segments are scanned concurrently, result of the first segment in order is kept,
+    // segments after the first one with a hit so far aren't scanned
+    std::vector<uintptr_t> segs_results(search_segments.size(), 0);
+    std::atomic<size_t> first_hit{SIZE_MAX};
+    ThreadPool::Get().parallelFor(0, search_segments.size(), 1, [&](size_t begin, size_t end)
     {
-        if (skip_result > 0)
+        for (size_t i = begin; i < end && i < first_hit.load(std::memory_order_relaxed); i++)
         {
-            auto adr_list = kMgr.memScanner.findIdaPatternAll(it.startAddress,
-                                                              it.endAddress, pattern);
-            if (adr_list.size() > skip_result)
+            const auto &it = search_segments[i];
+            if (skip_result > 0)
+            {
+                auto adr_list = kMgr.memScanner.findIdaPatternAll(it.startAddress,
+                                                                  it.endAddress, pattern);
+                if (adr_list.size() > skip_result)
+                {
+                    segs_results[i] = adr_list[skip_result];
+                }
+            }
+            else
             {
-                insn_address = adr_list[skip_result];
+                segs_results[i] = kMgr.memScanner.findIdaPatternFirst(
+                    it.startAddress, it.endAddress, pattern);
+            }
+
+            if (segs_results[i])
+            {
+                size_t hit = first_hit.load(std::memory_order_relaxed);
+                while (i < hit && !first_hit.compare_exchange_weak(hit, i, std::memory_order_relaxed))
+                {
+                }
             }
         }
-        else
-        {
-            insn_address = kMgr.memScanner.findIdaPatternFirst(
-                it.startAddress, it.endAddress, pattern);
-        }
+    });
+
+    uintptr_t insn_address = 0;
+    for (uintptr_t it : segs_results)
+    {
+        insn_address = it;
         if (insn_address)
             break;
     }
@@ -459,6 +599,15 @@ std::vector<std::string> IGameProfile::GetExcludedObjects() const
     return {};
 }
 
+std::vector<std::string> IGameProfile::GetDumpFilterRules() const
+{
+    /*return {
+        "-package:Niagara*",
+        "+class:re:^(Actor|Pawn|Character)$"
+    };*/
+    return {};
+}
+
 std::string IGameProfile::GetUserTypesHeader() const
 {
     return R"(#pragma once
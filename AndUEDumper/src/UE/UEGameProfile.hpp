@@ -10,6 +10,7 @@
 
 #include "../Utils/Logger.hpp"
 
+#include "UEEngineVersion.hpp"
 #include "UEMemory.hpp"
 #include "UEOffsets.hpp"
 
@@ -33,7 +34,9 @@ protected:
 public:
     virtual ~IGameProfile() = default;
 
-    UEVarsInitStatus InitUEVars();
+    // cached has library relative Names & UObjectArray from an earlier run on the same build,
+    // they're used instead of scanning if they still look right
+    UEVarsInitStatus InitUEVars(const UE_Pointers *cached = nullptr);
     const UEVars *GetUEVars() const { return &_UEVars; }
 
     virtual std::vector<std::string> GetUESoNames() const;
@@ -53,16 +56,31 @@ public:
 
     virtual bool isUsingOutlineNumberName() const = 0;
 
-    virtual UE_Offsets *GetOffsets() const = 0;
+    // UE_DefaultOffsets table of the engine version fingerprinted from the library, nullptr if the version isn't known.
+    // profiles of games with a modified layout return their own table
+    virtual UE_Offsets *GetOffsets() const;
+
+    // fingerprinted once from GetUnrealELF
+    const UEEngineVersion &GetEngineVersion() const;
 
     virtual bool findProcessEvent(uint8_t *uObject, uintptr_t *pe_address_out, int *pe_index_out) const;
 
     // Exclude objects from dump, useful when trying to redefine structs/classes in UserTypes.hpp
     virtual std::vector<std::string> GetExcludedObjects() const;
 
+    // Include/exclude rules, see UEDumpFilter
+    virtual std::vector<std::string> GetDumpFilterRules() const;
+
     // UserTypes.hpp
     virtual std::string GetUserTypesHeader() const;
 
+    // Cheap checks that the profile fits the running target: arch, pattern hits and the layout they point to.
+    // 0 if it doesn't fit, found gets library relative Names & UObjectArray
+    int ProbeTarget(UE_Pointers *found) const;
+
+    // read from the names pool every time, UEVars::GetNameByID is the cached one
+    virtual std::string GetNameByID(int32_t id) const;
+
 protected:
     virtual uintptr_t GetGUObjectArrayPtr() const = 0;
 
@@ -72,11 +90,19 @@ protected:
     virtual uint8_t *GetNameEntry(int32_t id) const;
     // can override if decryption is needed
     virtual std::string GetNameEntryString(uint8_t *entry) const;
-    virtual std::string GetNameByID(int32_t id) const;
 
     virtual bool isEmulator() const;
 
     virtual uintptr_t findIdaPattern(PATTERN_MAP_TYPE map_type,
                                      const std::string &pattern, const int step,
                                      uint32_t skip_result = 0) const;
+
+private:
+    mutable std::mutex _engineVersionMtx;
+    mutable UEEngineVersion _engineVersion;
+    mutable bool _engineVersionReady = false;
+
+    mutable std::mutex _defaultOffsetsMtx;
+    mutable UE_Offsets _defaultOffsets{};
+    mutable bool _defaultOffsetsReady = false;
 };
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "../UEGameProfile.hpp"
+#include "../../Fixture/UEFixtureConfig.hpp"
+using namespace UEMemory;
+
+// Synthetic UE world of Fixture/UEFixture.cpp running on a Linux host, see the build notes there
+class FixtureProfile : public IGameProfile
+{
+public:
+    FixtureProfile() = default;
+
+    // the fixture is a plain executable, not a loaded UE library
+    ElfScanner GetUnrealELF() const override
+    {
+        static std::mutex mtx;
+        std::lock_guard<std::mutex> lock(mtx);
+
+        static ElfScanner fixture_elf{};
+        if (fixture_elf.isValid())
+            return fixture_elf;
+
+        auto maps = KittyMemoryEx::getMaps(kMgr.processID(), EProcMapFilter::EndWith, "/" kUEFIXTURE_PROCESS_NAME);
+        if (!maps.empty())
+            fixture_elf = kMgr.elfScanner.createWithBase(maps.front().startAddress);
+
+        return fixture_elf;
+    }
+
+    bool ArchSupprted() const override
+    {
+        auto e_machine = GetUnrealELF().header().e_machine;
+        return e_machine == EM_X86_64 || e_machine == EM_AARCH64 || e_machine == EM_386 || e_machine == EM_ARM;
+    }
+
+    std::string GetAppName() const override
+    {
+        return "UE Fixture";
+    }
+
+    std::vector<std::string> GetAppIDs() const override
+    {
+        return {kUEFIXTURE_PROCESS_NAME};
+    }
+
+    bool isUsingCasePreservingName() const override
+    {
+        return GetConfig().CasePreservingName != 0;
+    }
+
+    bool IsUsingFNamePool() const override
+    {
+        return GetConfig().FNamePool != 0;
+    }
+
+    bool isUsingOutlineNumberName() const override
+    {
+        return GetConfig().OutlineNumberName != 0;
+    }
+
+    uintptr_t GetGUObjectArrayPtr() const override
+    {
+        uintptr_t guobjectarray = GetUnrealELF().findSymbol("GUObjectArray");
+        if (guobjectarray == 0)
+        {
+            LOGE("Failed to find GUObjectArray symbol.");
+            return 0;
+        }
+        return guobjectarray;
+    }
+
+    uintptr_t GetNamesPtr() const override
+    {
+        if (IsUsingFNamePool())
+        {
+            // GNameBlocksDebug = &NamePoolData + Blocks offset
+            uintptr_t blocks_p = GetUnrealELF().findSymbol("GNameBlocksDebug");
+            if (blocks_p != 0)
+            {
+                blocks_p = vm_rpm_ptr<uintptr_t>((void *)blocks_p);
+                if (blocks_p != 0)
+                    return (blocks_p - GetOffsets()->FNamePool.BlocksOff);
+            }
+
+            LOGE("Failed to find GNameBlocksDebug symbol.");
+            return 0;
+        }
+
+        uintptr_t GFNameTableForDebuggerVisualizers_MT = GetUnrealELF().findSymbol("GFNameTableForDebuggerVisualizers_MT");
+        if (GFNameTableForDebuggerVisualizers_MT == 0)
+        {
+            LOGE("Failed to find GFNameTableForDebuggerVisualizers_MT symbol.");
+            return 0;
+        }
+
+        return GFNameTableForDebuggerVisualizers_MT;
+    }
+
+    UE_Offsets *GetOffsets() const override
+    {
+        const UEFixtureConfig &config = GetConfig();
+        if (config.Magic != kUEFIXTURE_MAGIC)
+            return nullptr;
+
+        static UE_Offsets offsets = UE_DefaultOffsets::ForEngineVersion(config.EngineMajor, config.EngineMinor,
+                                                                         config.CasePreservingName != 0, config.OutlineNumberName != 0);
+        return &offsets;
+    }
+
+private:
+    // zeroed until the fixture finished laying out its world
+    const UEFixtureConfig &GetConfig() const
+    {
+        static std::mutex mtx;
+        std::lock_guard<std::mutex> lock(mtx);
+
+        static UEFixtureConfig config{};
+        if (config.Magic == kUEFIXTURE_MAGIC)
+            return config;
+
+        uintptr_t config_p = GetUnrealELF().findSymbol("GFixtureConfig");
+        if (config_p == 0 || !vm_rpm_ptr((void *)config_p, &config, sizeof(UEFixtureConfig)) || config.Magic != kUEFIXTURE_MAGIC)
+        {
+            config = {};
+            LOGE("Fixture isn't ready, GFixtureConfig wasn't found or isn't set yet.");
+        }
+
+        return config;
+    }
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "../UEGameProfile.hpp"
+using namespace UEMemory;
+
+// Fallback for unknown packages, only picked by the profile detector.
+// Offsets are the default ones of the fingerprinted engine version and the globals are found
+// through the debugger visualizer symbols, so it only fits libraries that weren't stripped of them
+class GenericProfile : public IGameProfile
+{
+public:
+    GenericProfile() = default;
+
+    bool ArchSupprted() const override
+    {
+        auto e_machine = GetUnrealELF().header().e_machine;
+        return e_machine == EM_AARCH64 || e_machine == EM_ARM || e_machine == EM_X86_64 || e_machine == EM_386;
+    }
+
+    std::string GetAppName() const override
+    {
+        return "Generic";
+    }
+
+    // detected only
+    std::vector<std::string> GetAppIDs() const override
+    {
+        return {};
+    }
+
+    bool isUsingCasePreservingName() const override
+    {
+        return false;
+    }
+
+    // FNamePool replaced GNames in 4.23
+    bool IsUsingFNamePool() const override
+    {
+        const UEEngineVersion &version = GetEngineVersion();
+        return version.Major > 4 || (version.Major == 4 && version.Minor >= 23);
+    }
+
+    bool isUsingOutlineNumberName() const override
+    {
+        return false;
+    }
+
+    uintptr_t GetGUObjectArrayPtr() const override
+    {
+        return GetUnrealELF().findSymbol("GUObjectArray");
+    }
+
+    uintptr_t GetNamesPtr() const override
+    {
+        UE_Offsets *offsets = GetOffsets();
+        if (!offsets)
+            return 0;
+
+        if (IsUsingFNamePool())
+        {
+            // GNameBlocksDebug = &NamePoolData + Blocks offset
+            uintptr_t blocks_p = GetUnrealELF().findSymbol("GNameBlocksDebug");
+            if (blocks_p != 0)
+            {
+                blocks_p = vm_rpm_ptr<uintptr_t>((void *)blocks_p);
+                if (blocks_p != 0)
+                    return (blocks_p - offsets->FNamePool.BlocksOff);
+            }
+            return 0;
+        }
+
+        return GetUnrealELF().findSymbol("GFNameTableForDebuggerVisualizers_MT");
+    }
+};
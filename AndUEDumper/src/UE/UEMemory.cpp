@@ -1,18 +1,92 @@
 #include "UEMemory.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <sys/uio.h>
+
 namespace UEMemory
 {
     KittyMemoryMgr kMgr{};
     KittyPtrValidator kPtrValidator;
 
+    // validator region cache isn't thread safe, reads themselves are
+    static std::mutex kPtrValidatorMtx;
+
     bool vm_rpm_ptr(const void *address, void *result, size_t len)
     {
-        if (!kPtrValidator.isPtrReadable(address))
-            return false;
+        {
+            std::lock_guard<std::mutex> lock(kPtrValidatorMtx);
+            if (!kPtrValidator.isPtrReadable(address))
+                return false;
+        }
 
         return kMgr.readMem(uintptr_t(address), result, len) == len;
     }
 
+    size_t vm_rpm_batch(std::vector<RemoteRead> &reads)
+    {
+        // kernels without process_vm_readv or a denied syscall, don't retry it on every batch
+        static std::atomic<bool> vectoredUnsupported{false};
+        const size_t kMaxIovecs = 1024;
+
+        size_t succeeded = 0;
+        std::vector<iovec> local, remote;
+
+        auto readSingle = [&succeeded](RemoteRead &it)
+        {
+            it.ok = vm_rpm_ptr(it.address, it.result, it.len);
+            if (it.ok) succeeded++;
+        };
+
+        size_t start = 0;
+        while (start < reads.size())
+        {
+            if (vectoredUnsupported.load())
+            {
+                readSingle(reads[start++]);
+                continue;
+            }
+
+            size_t count = std::min(reads.size() - start, kMaxIovecs);
+            local.resize(count);
+            remote.resize(count);
+            for (size_t i = 0; i < count; i++)
+            {
+                local[i] = {reads[start + i].result, reads[start + i].len};
+                remote[i] = {const_cast<void *>(reads[start + i].address), reads[start + i].len};
+            }
+
+            ssize_t n = process_vm_readv(kMgr.processID(), local.data(), count, remote.data(), count, 0);
+            if (n < 0 && (errno == ENOSYS || errno == EPERM))
+            {
+                vectoredUnsupported = true;
+                continue;
+            }
+
+            // regions are read in order, stop at the first one that wasn't fully read
+            size_t done = 0, bytes = n > 0 ? size_t(n) : 0;
+            while (done < count && bytes >= reads[start + done].len)
+            {
+                bytes -= reads[start + done].len;
+                reads[start + done].ok = true;
+                succeeded++;
+                done++;
+            }
+
+            // retry the failing one alone then continue the batch after it
+            if (done < count)
+            {
+                readSingle(reads[start + done]);
+                done++;
+            }
+
+            start += done;
+        }
+
+        return succeeded;
+    }
+
     std::string vm_rpm_str(const void *address, size_t max_len)
     {
         std::vector<char> chars(max_len, '\0');
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <string>
 #include <unistd.h>
+#include <vector>
 
 #include <KittyMemoryMgr.hpp>
 #include <KittyPtrValidator.hpp>
@@ -25,6 +26,18 @@ namespace UEMemory
         return buffer;
     }
 
+    struct RemoteRead
+    {
+        const void *address = nullptr;
+        void *result = nullptr;
+        size_t len = 0;
+        bool ok = false;
+    };
+
+    // read many regions with vectored reads, failing regions are retried one by one.
+    // returns the number of regions read
+    size_t vm_rpm_batch(std::vector<RemoteRead> &reads);
+
     std::string vm_rpm_str(const void *address, size_t max_len = 1024);
     std::wstring vm_rpm_strw(const void *address, size_t max_len = 1024);
 
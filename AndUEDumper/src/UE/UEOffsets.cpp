@@ -1,6 +1,8 @@
 #include "UEOffsets.hpp"
 
+#include <mutex>
 #include <ostream>
+#include <shared_mutex>
 #include <sstream>
 #include <unordered_map>
 
@@ -211,377 +213,50 @@ std::string UE_Pointers::ToString() const
     return oss.str();
 }
 
-namespace UE_DefaultOffsets
+std::string UE_DiscoveredOffsets::ToString() const
 {
-    UE_Offsets UE4_00_17(bool bWITH_CASE_PRESERVING_NAME)
-    {
-        static UE_Offsets offsets{};
-        static bool once = false;
-        if (!once)
-        {
-            once = true;
-
-            offsets.Config.isUsingCasePreservingName = bWITH_CASE_PRESERVING_NAME;
-            offsets.Config.IsUsingFNamePool = false;
-            offsets.Config.isUsingOutlineNumberName = false;
-
-            offsets.FName.ComparisonIndex = 0;
-            offsets.FName.DisplayIndex = bWITH_CASE_PRESERVING_NAME ? 4 : 0;
-            // WITH_CASE_PRESERVING_NAME adds DisplayIndex in FName
-            offsets.FName.Number = offsets.FName.DisplayIndex + sizeof(int32_t);
-            offsets.FName.Size = kGetFNameSize(bWITH_CASE_PRESERVING_NAME, false);
-
-            offsets.FNameEntry.Index = 0;
-            offsets.FNameEntry.Name = GetPtrAlignedOf(sizeof(void *) + sizeof(int32_t));
-            offsets.FNameEntry.GetIsWide = [](int32_t index)
-            { return (index & 1) != 0; };
-
-            offsets.FUObjectArray.ObjObjects = sizeof(int32_t) * 4;
-
-            offsets.TUObjectArray.Objects = 0;
-            offsets.TUObjectArray.NumElements = sizeof(void *) + sizeof(int32_t);
-            offsets.TUObjectArray.NumElementsPerChunk = 0;
-
-            offsets.FUObjectItem.Object = 0;
-            offsets.FUObjectItem.Size = GetPtrAlignedOf(sizeof(void *) + (sizeof(int32_t) * 3));
-
-            offsets.UObject.ObjectFlags = sizeof(void *);
-            offsets.UObject.InternalIndex = offsets.UObject.ObjectFlags + sizeof(int32_t);
-            offsets.UObject.ClassPrivate = offsets.UObject.InternalIndex + sizeof(int32_t);
-            offsets.UObject.NamePrivate = offsets.UObject.ClassPrivate + sizeof(void *);
-            offsets.UObject.OuterPrivate = GetPtrAlignedOf(offsets.UObject.NamePrivate + offsets.FName.Size);
-
-            offsets.UField.Next = offsets.UObject.OuterPrivate + sizeof(void *);  // sizeof(UObject)
-
-            offsets.UEnum.Names = offsets.UField.Next + (sizeof(void *) * 2) + (sizeof(int32_t) * 2);  // usually at sizeof(UField) + sizeof(FString)
-
-            offsets.UStruct.SuperStruct = offsets.UField.Next + sizeof(void *);       // sizeof(UField)
-            offsets.UStruct.Children = offsets.UStruct.SuperStruct + sizeof(void *);  // UField*
-            offsets.UStruct.PropertiesSize = offsets.UStruct.Children + sizeof(void *);
-
-            // UFunction.EFunctionFlags = sizeof(UStruct)
-            offsets.UFunction.EFunctionFlags = offsets.UStruct.PropertiesSize + (sizeof(int32_t) * 2) + ((sizeof(void *) + sizeof(int32_t) * 2) * 2) + (sizeof(void *) * 4);
-            offsets.UFunction.NumParams = offsets.UFunction.EFunctionFlags + sizeof(int32_t) + sizeof(int16_t);
-            offsets.UFunction.ParamSize = offsets.UFunction.NumParams + sizeof(int16_t);
-            offsets.UFunction.Func = offsets.UFunction.EFunctionFlags + (sizeof(int32_t) * 4) + (sizeof(void *) * 3);
-
-            offsets.UProperty.ArrayDim = offsets.UField.Next + sizeof(void *);  // sizeof(UField)
-            offsets.UProperty.ElementSize = offsets.UProperty.ArrayDim + sizeof(int32_t);
-            offsets.UProperty.PropertyFlags = GetPtrAlignedOf(offsets.UProperty.ElementSize + sizeof(int32_t));
-            offsets.UProperty.Offset_Internal = offsets.UProperty.PropertyFlags + sizeof(int64_t) + (sizeof(int32_t) * 2) + offsets.FName.Size;
-            offsets.UProperty.Size = GetPtrAlignedOf(offsets.UProperty.Offset_Internal + sizeof(int32_t)) + (sizeof(void *) * 4);  // sizeof(UProperty)
-        }
-        return offsets;
-    }
-
-    UE_Offsets UE4_18_19(bool bWITH_CASE_PRESERVING_NAME)
-    {
-        static UE_Offsets offsets = UE4_00_17(bWITH_CASE_PRESERVING_NAME);
-        static bool once = false;
-        if (!once)
-        {
-            once = true;
-
-            offsets.UFunction.NumParams = offsets.UFunction.EFunctionFlags + sizeof(int32_t);
-            offsets.UFunction.ParamSize = offsets.UFunction.NumParams + sizeof(int16_t);
-
-            offsets.UProperty.Offset_Internal = offsets.UProperty.PropertyFlags + sizeof(int64_t) + sizeof(int32_t);
-            offsets.UProperty.Size = GetPtrAlignedOf(offsets.UProperty.Offset_Internal + sizeof(int32_t) + offsets.FName.Size) + (sizeof(void *) * 4);  // sizeof(UProperty)
-        }
-        return offsets;
-    }
-
-    UE_Offsets UE4_20(bool bWITH_CASE_PRESERVING_NAME)
-    {
-        static UE_Offsets offsets = UE4_18_19(bWITH_CASE_PRESERVING_NAME);
-        static bool once = false;
-        if (!once)
-        {
-            once = true;
-
-            offsets.TUObjectArray.NumElements = (sizeof(void *) * 2) + sizeof(int32_t);
-            offsets.TUObjectArray.NumElementsPerChunk = 65 * 1024;
-        }
-        return offsets;
-    }
-
-    UE_Offsets UE4_21(bool bWITH_CASE_PRESERVING_NAME)
-    {
-        static UE_Offsets offsets = UE4_20(bWITH_CASE_PRESERVING_NAME);
-        static bool once = false;
-        if (!once)
-        {
-            once = true;
-
-            offsets.TUObjectArray.NumElementsPerChunk = 64 * 1024;
-        }
-        return offsets;
-    }
+    std::ostringstream oss;
 
-    UE_Offsets UE4_22(bool bWITH_CASE_PRESERVING_NAME)
+    kOUT_NS_BEGIN(UEDiscoveredOffsets);
     {
-        static UE_Offsets offsets = UE4_21(bWITH_CASE_PRESERVING_NAME);
-        static bool once = false;
-        if (!once)
-        {
-            once = true;
-
-            offsets.FNameEntry.Index = sizeof(void *);
-            offsets.FNameEntry.Name = sizeof(void *) + sizeof(int32_t);
-
-            offsets.UStruct.SuperStruct = offsets.UField.Next + (sizeof(void *) * 3);  // sizeof(UField) + sizeof(FStructBaseChain)
-            offsets.UStruct.Children = offsets.UStruct.SuperStruct + sizeof(void *);   // UField*
-            offsets.UStruct.PropertiesSize = offsets.UStruct.Children + sizeof(void *);
+        kOUT_NS_MEMBER_P((*this), FPropertySubBase);
+        kOUT_NS_MEMBER_P((*this), FEnumPropertyUnderlyingProp);
+        kOUT_NS_MEMBER_P((*this), FEnumPropertyEnum);
 
-            offsets.UFunction.EFunctionFlags = offsets.UStruct.PropertiesSize + (sizeof(int32_t) * 2) + ((sizeof(void *) + sizeof(int32_t) * 2) * 2) + (sizeof(void *) * 4);
-            offsets.UFunction.NumParams = offsets.UFunction.EFunctionFlags + sizeof(int32_t);
-            offsets.UFunction.ParamSize = offsets.UFunction.NumParams + sizeof(int16_t);
-            offsets.UFunction.Func = offsets.UFunction.EFunctionFlags + (sizeof(int32_t) * 4) + (sizeof(void *) * 3);
-
-            offsets.UProperty.ArrayDim = offsets.UField.Next + sizeof(void *);  // sizeof(UField)
-            offsets.UProperty.ElementSize = offsets.UProperty.ArrayDim + sizeof(int32_t);
-            offsets.UProperty.PropertyFlags = GetPtrAlignedOf(offsets.UProperty.ElementSize + sizeof(int32_t));
-            offsets.UProperty.Offset_Internal = offsets.UProperty.PropertyFlags + sizeof(int64_t) + sizeof(int32_t);
-            offsets.UProperty.Size = GetPtrAlignedOf(offsets.UProperty.Offset_Internal + sizeof(int32_t) + offsets.FName.Size) + (sizeof(void *) * 4);  // sizeof(UProperty)
-        }
-        return offsets;
+        kOUT_NS_END();
     }
 
-    UE_Offsets UE4_23_24(bool bWITH_CASE_PRESERVING_NAME)
-    {
-        static UE_Offsets offsets{};
-        static bool once = false;
-        if (!once)
-        {
-            once = true;
-
-            offsets.Config.isUsingCasePreservingName = bWITH_CASE_PRESERVING_NAME;
-            offsets.Config.IsUsingFNamePool = true;
-            offsets.Config.isUsingOutlineNumberName = false;
-
-            offsets.FName.ComparisonIndex = 0;
-            offsets.FName.DisplayIndex = bWITH_CASE_PRESERVING_NAME ? 4 : 0;
-            // WITH_CASE_PRESERVING_NAME adds DisplayIndex in FName
-            offsets.FName.Number = offsets.FName.DisplayIndex + sizeof(int32_t);
-            offsets.FName.Size = kGetFNameSize(bWITH_CASE_PRESERVING_NAME, false);
-
-            offsets.FNamePool.Stride = bWITH_CASE_PRESERVING_NAME ? 4 : 2;  // alignof(FNameEntry)
-
-            // Blocks bit is 16 for most games
-            // ((id >> 13) & 0x7FFF8) = 16
-            // ((id >> 15) & 0x1FFF8) = 18
-            offsets.FNamePool.BlocksBit = 16;
-
-            // offset to blocks, usually ios at 0xD0 and android at 0x40
-#ifdef __APPLE__
-            offsets.FNamePool.BlocksOff = 0xD0;
-#else
-#ifdef __LP64__
-            offsets.FNamePool.BlocksOff = 0x40;
-#else
-            offsets.FNamePool.BlocksOff = 0x30;
-#endif
-#endif
-
-            offsets.FNamePoolEntry.Header = bWITH_CASE_PRESERVING_NAME ? 4 : 0;  // Offset to name entry header
-            offsets.FNamePoolEntry.GetIsWide = [](uint16_t header)
-            { return (header & 1) != 0; };
-            // usually if stride is 2 then header >> 6 and if 4 then haeder >> 1
-            offsets.FNamePoolEntry.GetLength = [bWITH_CASE_PRESERVING_NAME](uint16_t header) -> size_t
-            {
-                return bWITH_CASE_PRESERVING_NAME ? header >> 1 : header >> 6;
-            };
-
-            offsets.FUObjectArray.ObjObjects = sizeof(int32_t) * 4;
-
-            offsets.TUObjectArray.Objects = 0;
-            offsets.TUObjectArray.NumElements = (sizeof(void *) * 2) + sizeof(int32_t);
-            offsets.TUObjectArray.NumElementsPerChunk = 64 * 1024;
-
-            offsets.FUObjectItem.Object = 0;
-            offsets.FUObjectItem.Size = GetPtrAlignedOf(sizeof(void *) + (sizeof(int32_t) * 3));
-
-            offsets.UObject.ObjectFlags = sizeof(void *);
-            offsets.UObject.InternalIndex = offsets.UObject.ObjectFlags + sizeof(int32_t);
-            offsets.UObject.ClassPrivate = offsets.UObject.InternalIndex + sizeof(int32_t);
-            offsets.UObject.NamePrivate = offsets.UObject.ClassPrivate + sizeof(void *);
-            offsets.UObject.OuterPrivate = GetPtrAlignedOf(offsets.UObject.NamePrivate + offsets.FName.Size);
-
-            offsets.UField.Next = offsets.UObject.OuterPrivate + sizeof(void *);  // sizeof(UObject)
-
-            offsets.UEnum.Names = offsets.UField.Next + (sizeof(void *) * 2) + (sizeof(int32_t) * 2);  // usually at sizeof(UField) + sizeof(FString)
-
-            offsets.UStruct.SuperStruct = offsets.UField.Next + (sizeof(void *) * 3);  // sizeof(UField) + sizeof(FStructBaseChain)
-            offsets.UStruct.Children = offsets.UStruct.SuperStruct + sizeof(void *);   // UField*
-            offsets.UStruct.PropertiesSize = offsets.UStruct.Children + sizeof(void *);
-
-            offsets.UFunction.EFunctionFlags = offsets.UStruct.PropertiesSize + (sizeof(int32_t) * 2) + ((sizeof(void *) + sizeof(int32_t) * 2) * 2) + (sizeof(void *) * 4);
-            offsets.UFunction.NumParams = offsets.UFunction.EFunctionFlags + sizeof(int32_t);
-            offsets.UFunction.ParamSize = offsets.UFunction.NumParams + sizeof(int16_t);
-            offsets.UFunction.Func = offsets.UFunction.EFunctionFlags + (sizeof(int32_t) * 4) + (sizeof(void *) * 3);
-
-            offsets.UProperty.ArrayDim = offsets.UField.Next + sizeof(void *);  // sizeof(UField)
-            offsets.UProperty.ElementSize = offsets.UProperty.ArrayDim + sizeof(int32_t);
-            offsets.UProperty.PropertyFlags = GetPtrAlignedOf(offsets.UProperty.ElementSize + sizeof(int32_t));
-            offsets.UProperty.Offset_Internal = offsets.UProperty.PropertyFlags + sizeof(int64_t) + sizeof(int32_t);
-            offsets.UProperty.Size = GetPtrAlignedOf(offsets.UProperty.Offset_Internal + sizeof(int32_t) + offsets.FName.Size) + (sizeof(void *) * 4);  // sizeof(UProperty)
-        }
-        return offsets;
-    }
+    return oss.str();
+}
 
-    UE_Offsets UE4_25_27(bool bWITH_CASE_PRESERVING_NAME)
-    {
-        static UE_Offsets offsets = UE4_23_24(bWITH_CASE_PRESERVING_NAME);
-        static bool once = false;
-        if (!once)
-        {
-            once = true;
-
-            offsets.UStruct.ChildProperties = offsets.UStruct.Children + sizeof(void *);  // FField*
-            offsets.UStruct.PropertiesSize = offsets.UStruct.ChildProperties + sizeof(void *);
-
-            offsets.UFunction.EFunctionFlags = offsets.UStruct.PropertiesSize + (sizeof(int32_t) * 2) + ((sizeof(void *) + sizeof(int32_t) * 2) * 2) + (sizeof(void *) * 6);
-            offsets.UFunction.NumParams = offsets.UFunction.EFunctionFlags + sizeof(int32_t);
-            offsets.UFunction.ParamSize = offsets.UFunction.NumParams + sizeof(int16_t);
-            offsets.UFunction.Func = offsets.UFunction.EFunctionFlags + (sizeof(int32_t) * 4) + (sizeof(void *) * 3);
-
-            offsets.FField.ClassPrivate = sizeof(void *);
-            offsets.FField.Next = offsets.FField.ClassPrivate + (sizeof(void *) * 3);  // + sizeof(FFieldVariant);
-            offsets.FField.NamePrivate = offsets.FField.Next + sizeof(void *);
-            offsets.FField.FlagsPrivate = offsets.FField.NamePrivate + offsets.FName.Size;
-
-            offsets.FProperty.ArrayDim = offsets.FField.FlagsPrivate + sizeof(int32_t);  // sizeof(UFField)
-            offsets.FProperty.ElementSize = offsets.FProperty.ArrayDim + sizeof(int32_t);
-            offsets.FProperty.PropertyFlags = GetPtrAlignedOf(offsets.FProperty.ElementSize + sizeof(int32_t));
-            offsets.FProperty.Offset_Internal = offsets.FProperty.PropertyFlags + sizeof(int64_t) + sizeof(int32_t);
-            offsets.FProperty.Size = GetPtrAlignedOf(offsets.FProperty.Offset_Internal + sizeof(int32_t) + offsets.FName.Size) + (sizeof(void *) * 4);  // sizeof(FProperty)
-
-            offsets.UProperty.ArrayDim = 0;
-            offsets.UProperty.ElementSize = 0;
-            offsets.UProperty.PropertyFlags = 0;
-            offsets.UProperty.Offset_Internal = 0;
-            offsets.UProperty.Size = 0;
-        }
-        return offsets;
-    }
+std::string UEVars::GetNameByID(int32_t id) const
+{
+    // cached names belong to one names pool & layout, profile detection initializes several in a row
+    static std::unordered_map<int32_t, std::string> namesCachedMap;
+    static std::pair<uintptr_t, const UE_Offsets *> namesCachedOwner{0, nullptr};
+    static std::shared_mutex namesCachedMtx;
 
-    UE_Offsets UE5_00_02(bool bWITH_CASE_PRESERVING_NAME, bool bFNAME_OUTLINE_NUMBER)
-    {
-        static UE_Offsets offsets{};
-        static bool once = false;
-        if (!once)
-        {
-            once = true;
-
-            offsets.Config.isUsingCasePreservingName = bWITH_CASE_PRESERVING_NAME;
-            offsets.Config.IsUsingFNamePool = true;
-            offsets.Config.isUsingOutlineNumberName = bFNAME_OUTLINE_NUMBER;
-
-            offsets.FName.ComparisonIndex = 0;
-            offsets.FName.Number = bFNAME_OUTLINE_NUMBER ? 0 : 4;
-            offsets.FName.DisplayIndex = bWITH_CASE_PRESERVING_NAME ? (offsets.FName.Number + sizeof(int32_t)) : 0;
-            offsets.FName.Size = kGetFNameSize(bWITH_CASE_PRESERVING_NAME, bFNAME_OUTLINE_NUMBER);
-
-            offsets.FNamePool.Stride = bWITH_CASE_PRESERVING_NAME ? 4 : 2;  // alignof(FNameEntry)
-            // Blocks bit is 16 for most games
-            // ((id >> 13) & 0x7FFF8) = 16
-            // ((id >> 15) & 0x1FFF8) = 18
-            offsets.FNamePool.BlocksBit = 16;
-
-            // offset to blocks, usually ios at 0xD0 and android at 0x40
-#ifdef __APPLE__
-            offsets.FNamePool.BlocksOff = 0xD0;
-#else
-#ifdef __LP64__
-            offsets.FNamePool.BlocksOff = 0x40;
-#else
-            offsets.FNamePool.BlocksOff = 0x30;
-#endif
-#endif
-
-            offsets.FNamePoolEntry.Header = bWITH_CASE_PRESERVING_NAME ? 4 : 0;  // Offset to name entry header
-            offsets.FNamePoolEntry.GetIsWide = [](uint16_t header)
-            { return (header & 1) != 0; };
-            // usually if stride is 2 then header >> 6 and if 4 then haeder >> 1
-            offsets.FNamePoolEntry.GetLength = [bWITH_CASE_PRESERVING_NAME](uint16_t header) -> size_t
-            {
-                return bWITH_CASE_PRESERVING_NAME ? header >> 1 : header >> 6;
-            };
-
-            offsets.FUObjectArray.ObjObjects = sizeof(int32_t) * 4;
-
-            offsets.TUObjectArray.Objects = 0;
-            offsets.TUObjectArray.NumElements = (sizeof(void *) * 2) + sizeof(int32_t);
-            offsets.TUObjectArray.NumElementsPerChunk = 64 * 1024;
-
-            offsets.FUObjectItem.Object = 0;
-            offsets.FUObjectItem.Size = GetPtrAlignedOf(sizeof(void *) + (sizeof(int32_t) * 3));
-
-            offsets.UObject.ObjectFlags = sizeof(void *);
-            offsets.UObject.InternalIndex = offsets.UObject.ObjectFlags + sizeof(int32_t);
-            offsets.UObject.ClassPrivate = offsets.UObject.InternalIndex + sizeof(int32_t);
-            offsets.UObject.NamePrivate = offsets.UObject.ClassPrivate + sizeof(void *);
-            offsets.UObject.OuterPrivate = GetPtrAlignedOf(offsets.UObject.NamePrivate + offsets.FName.Size);
-
-            offsets.UField.Next = offsets.UObject.OuterPrivate + sizeof(void *);  // sizeof(UObject)
-
-            offsets.UEnum.Names = offsets.UField.Next + (sizeof(void *) * 2) + (sizeof(int32_t) * 2);  // usually at sizeof(UField) + sizeof(FString)
-
-            offsets.UStruct.SuperStruct = offsets.UField.Next + (sizeof(void *) * 3);     // sizeof(UField) + sizeof(FStructBaseChain)
-            offsets.UStruct.Children = offsets.UStruct.SuperStruct + sizeof(void *);      // UField*
-            offsets.UStruct.ChildProperties = offsets.UStruct.Children + sizeof(void *);  // FField*
-            offsets.UStruct.PropertiesSize = offsets.UStruct.ChildProperties + sizeof(void *);
-
-            offsets.UFunction.EFunctionFlags = offsets.UStruct.PropertiesSize + (sizeof(int32_t) * 2) + ((sizeof(void *) + sizeof(int32_t) * 2) * 2) + (sizeof(void *) * 6);
-            offsets.UFunction.NumParams = offsets.UFunction.EFunctionFlags + sizeof(int32_t);
-            offsets.UFunction.ParamSize = offsets.UFunction.NumParams + sizeof(int16_t);
-            offsets.UFunction.Func = offsets.UFunction.EFunctionFlags + (sizeof(int32_t) * 4) + (sizeof(void *) * 3);
-
-            offsets.FField.ClassPrivate = sizeof(void *);
-            offsets.FField.Next = offsets.FField.ClassPrivate + sizeof(void *) + GetPtrAlignedOf(sizeof(void *) + sizeof(bool));  // + sizeof(FFieldVariant);
-            offsets.FField.NamePrivate = offsets.FField.Next + sizeof(void *);
-            offsets.FField.FlagsPrivate = offsets.FField.NamePrivate + offsets.FName.Size;
-
-            offsets.FProperty.ArrayDim = offsets.FField.FlagsPrivate + sizeof(int32_t);  // sizeof(UFField)
-            offsets.FProperty.ElementSize = offsets.FProperty.ArrayDim + sizeof(int32_t);
-            offsets.FProperty.PropertyFlags = GetPtrAlignedOf(offsets.FProperty.ElementSize + sizeof(int32_t));
-            offsets.FProperty.Offset_Internal = offsets.FProperty.PropertyFlags + sizeof(int64_t) + sizeof(int32_t);
-            offsets.FProperty.Size = GetPtrAlignedOf(offsets.FProperty.Offset_Internal + sizeof(int32_t) + offsets.FName.Size) + (sizeof(void *) * 4);  // sizeof(FProperty)
-        }
-        return offsets;
-    }
+    const std::pair<uintptr_t, const UE_Offsets *> owner{NamesPtr, Offsets};
 
-    UE_Offsets UE5_03(bool bWITH_CASE_PRESERVING_NAME, bool bFNAME_OUTLINE_NUMBER)
     {
-        static UE_Offsets offsets = UE5_00_02(bWITH_CASE_PRESERVING_NAME, bFNAME_OUTLINE_NUMBER);
-        static bool once = false;
-        if (!once)
+        std::shared_lock<std::shared_mutex> lock(namesCachedMtx);
+        if (namesCachedOwner == owner)
         {
-            once = true;
-
-            offsets.FField.Next = offsets.FField.ClassPrivate + (sizeof(void *) * 2);  // + sizeof(FFieldVariant);
-            offsets.FField.NamePrivate = offsets.FField.Next + sizeof(void *);
-            offsets.FField.FlagsPrivate = offsets.FField.NamePrivate + offsets.FName.Size;
-
-            offsets.FProperty.ArrayDim = offsets.FField.FlagsPrivate + sizeof(int32_t);  // sizeof(UFField)
-            offsets.FProperty.ElementSize = offsets.FProperty.ArrayDim + sizeof(int32_t);
-            offsets.FProperty.PropertyFlags = GetPtrAlignedOf(offsets.FProperty.ElementSize + sizeof(int32_t));
-            offsets.FProperty.Offset_Internal = offsets.FProperty.PropertyFlags + sizeof(int64_t) + sizeof(int32_t);
-            offsets.FProperty.Size = GetPtrAlignedOf(offsets.FProperty.Offset_Internal + sizeof(int32_t) + offsets.FName.Size) + (sizeof(void *) * 4);  // sizeof(FProperty)
+            auto it = namesCachedMap.find(id);
+            if (it != namesCachedMap.end())
+                return it->second;
         }
-        return offsets;
     }
-}  // namespace UE_DefaultOffsets
-
-std::string UEVars::GetNameByID(int32_t id) const
-{
-    static std::unordered_map<int32_t, std::string> namesCachedMap;
-    if (namesCachedMap.count(id) > 0)
-        return namesCachedMap[id];
 
     std::string name = pGetNameByID ? pGetNameByID(id) : "pGetNameByID_IS_NULL";
     if (!name.empty())
     {
+        std::unique_lock<std::shared_mutex> lock(namesCachedMtx);
+        if (namesCachedOwner != owner)
+        {
+            namesCachedMap.clear();
+            namesCachedOwner = owner;
+        }
         namesCachedMap[id] = name;
     }
     return name;
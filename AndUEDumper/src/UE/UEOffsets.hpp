@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <cstring>
 #include <functional>
+#include <string>
 #include <utility>
 
 #define kMAX_UENAME_BUFFER 0xff
@@ -134,6 +135,17 @@ struct UE_Pointers
     std::string ToString() const;
 };
 
+// offsets probed from the target properties instead of the profile
+struct UE_DiscoveredOffsets
+{
+    // FStructProperty::Struct, FObjectPropertyBase::PropertyClass, FArrayProperty::Inner, etc.
+    uintptr_t FPropertySubBase = 0;
+    uintptr_t FEnumPropertyUnderlyingProp = 0;
+    uintptr_t FEnumPropertyEnum = 0;
+
+    std::string ToString() const;
+};
+
 namespace UE_DefaultOffsets
 {
     inline static uintptr_t kGetFNameSize(bool bWITH_CASE_PRESERVING_NAME, bool bFNAME_OUTLINE_NUMBER)
@@ -170,6 +182,12 @@ namespace UE_DefaultOffsets
 
     // UE 5.03 and above
     UE_Offsets UE5_03(bool bWITH_CASE_PRESERVING_NAME, bool bFNAME_OUTLINE_NUMBER);
+
+    // table of an engine version, see UEEngineVersion
+    UE_Offsets ForEngineVersion(int major, int minor, bool bWITH_CASE_PRESERVING_NAME, bool bFNAME_OUTLINE_NUMBER);
+
+    // name of the table above, nullptr for unknown versions
+    const char *TableNameForEngineVersion(int major, int minor);
 }  // namespace UE_DefaultOffsets
 
 enum class UEVarsInitStatus : uint8_t
@@ -197,6 +215,8 @@ struct UEVars
 protected:
     uintptr_t BaseAddress;
     uintptr_t NamesPtr;
+    // GNames chunks table, read from NamesPtr when FNamePool isn't used
+    uintptr_t GNamesTable;
     uintptr_t GUObjectsArrayPtr;
     uintptr_t ObjObjectsPtr;
     uintptr_t ObjObjects_Objects;
@@ -206,11 +226,11 @@ protected:
     std::function<std::string(int32_t)> pGetNameByID;
 
 public:
-    UEVars() : BaseAddress(0), NamesPtr(0), GUObjectsArrayPtr(0), ObjObjectsPtr(0), ObjObjects_Objects(0), Offsets(nullptr), pGetNameByID(nullptr)
+    UEVars() : BaseAddress(0), NamesPtr(0), GNamesTable(0), GUObjectsArrayPtr(0), ObjObjectsPtr(0), ObjObjects_Objects(0), Offsets(nullptr), pGetNameByID(nullptr)
     {
     }
 
-    UEVars(uintptr_t base, uintptr_t names, uintptr_t objectArray, uintptr_t objObjects, uintptr_t objects, UE_Offsets *offsets, const std::function<std::string(int32_t)> &pGetNameByID) : BaseAddress(base), NamesPtr(names), GUObjectsArrayPtr(objectArray), ObjObjectsPtr(objObjects), ObjObjects_Objects(objects), Offsets(offsets), pGetNameByID(pGetNameByID)
+    UEVars(uintptr_t base, uintptr_t names, uintptr_t objectArray, uintptr_t objObjects, uintptr_t objects, UE_Offsets *offsets, const std::function<std::string(int32_t)> &pGetNameByID) : BaseAddress(base), NamesPtr(names), GNamesTable(0), GUObjectsArrayPtr(objectArray), ObjObjectsPtr(objObjects), ObjObjects_Objects(objects), Offsets(offsets), pGetNameByID(pGetNameByID)
     {
     }
 
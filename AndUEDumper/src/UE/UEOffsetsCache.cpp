@@ -0,0 +1,180 @@
+#include "UEOffsetsCache.hpp"
+
+#include <elf.h>
+#include <link.h>
+
+#include <fstream>
+
+#include <fmt/format.h>
+
+#include "../Utils/BufferFmt.hpp"
+
+using namespace UEMemory;
+
+namespace
+{
+    constexpr const char *kCacheHeader = "UEOffsetsCache 1";
+
+    std::string HexString(const uint8_t *data, size_t size)
+    {
+        std::string str;
+        str.reserve(size * 2);
+        for (size_t i = 0; i < size; i++)
+            str += fmt::format("{:02x}", data[i]);
+        return str;
+    }
+
+    std::string ReadBuildId(uintptr_t base)
+    {
+        ElfW(Ehdr) ehdr{};
+        if (!vm_rpm_ptr((void *)base, &ehdr, sizeof(ehdr)) || memcmp(ehdr.e_ident, ELFMAG, SELFMAG) != 0)
+            return "";
+
+        if (ehdr.e_phentsize != sizeof(ElfW(Phdr)) || ehdr.e_phnum == 0 || ehdr.e_phnum > 0x100)
+            return "";
+
+        std::vector<ElfW(Phdr)> phdrs(ehdr.e_phnum);
+        if (!vm_rpm_ptr((void *)(base + ehdr.e_phoff), phdrs.data(), phdrs.size() * sizeof(ElfW(Phdr))))
+            return "";
+
+        // notes are mapped at their vaddr relative to the first load segment
+        uintptr_t loadBias = base;
+        for (const auto &phdr : phdrs)
+        {
+            if (phdr.p_type == PT_LOAD)
+            {
+                loadBias = base - (phdr.p_vaddr & ~uintptr_t(phdr.p_align ? phdr.p_align - 1 : 0));
+                break;
+            }
+        }
+
+        for (const auto &phdr : phdrs)
+        {
+            if (phdr.p_type != PT_NOTE || phdr.p_memsz == 0 || phdr.p_memsz > 0x10000)
+                continue;
+
+            std::vector<uint8_t> notes(phdr.p_memsz, 0);
+            if (!vm_rpm_ptr((void *)(loadBias + phdr.p_vaddr), notes.data(), notes.size()))
+                continue;
+
+            size_t off = 0;
+            while (off + sizeof(ElfW(Nhdr)) <= notes.size())
+            {
+                ElfW(Nhdr) nhdr{};
+                memcpy(&nhdr, notes.data() + off, sizeof(nhdr));
+                off += sizeof(nhdr);
+
+                size_t nameSize = (nhdr.n_namesz + 3) & ~size_t(3);
+                size_t descSize = (nhdr.n_descsz + 3) & ~size_t(3);
+                if (off + nameSize + nhdr.n_descsz > notes.size())
+                    break;
+
+                if (nhdr.n_type == NT_GNU_BUILD_ID && nhdr.n_namesz == 4 && memcmp(notes.data() + off, "GNU", 4) == 0)
+                    return HexString(notes.data() + off + nameSize, nhdr.n_descsz);
+
+                off += nameSize + descSize;
+            }
+        }
+
+        return "";
+    }
+}  // namespace
+
+std::string UEOffsetsCache::GetBuildKey(const ElfScanner &elf)
+{
+    if (!elf.isValid())
+        return "";
+
+    std::string buildId = ReadBuildId(elf.base());
+    if (!buildId.empty())
+        return "build-" + buildId;
+
+    // FNV-1a over the executable segments
+    uint64_t hash = 14695981039346656037ull;
+    bool hashed = false;
+    std::vector<uint8_t> page(0x10000);
+    for (const auto &seg : elf.segments())
+    {
+        if (!seg.is_rx)
+            continue;
+
+        for (uintptr_t addr = seg.startAddress; addr < seg.endAddress; addr += page.size())
+        {
+            size_t len = std::min(page.size(), size_t(seg.endAddress - addr));
+            if (!vm_rpm_ptr((void *)addr, page.data(), len))
+                return "";
+
+            for (size_t i = 0; i < len; i++)
+                hash = (hash ^ page[i]) * 1099511628211ull;
+        }
+        hashed = true;
+    }
+
+    return hashed ? fmt::format("text-{:016x}", hash) : "";
+}
+
+bool UEOffsetsCache::Load(const std::string &path)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+        return false;
+
+    std::string line;
+    if (!std::getline(file, line) || line != kCacheHeader)
+        return false;
+
+    *this = UEOffsetsCache();
+    while (std::getline(file, line))
+    {
+        size_t eq = line.find('=');
+        if (eq == std::string::npos)
+            continue;
+
+        std::string key = line.substr(0, eq);
+        uintptr_t value = uintptr_t(strtoull(line.c_str() + eq + 1, nullptr, 16));
+
+        if (key == "Names") Pointers.Names = value;
+        else if (key == "UObjectArray") Pointers.UObjectArray = value;
+        else if (key == "ObjObjects") Pointers.ObjObjects = value;
+        else if (key == "Engine") Pointers.Engine = value;
+        else if (key == "World") Pointers.World = value;
+        else if (key == "ProcessEvent") Pointers.ProcessEvent = value;
+        else if (key == "ProcessEventIndex") Pointers.ProcessEventIndex = value;
+        else if (key == "HasPointers") HasPointers = value != 0;
+        else if (key == "FPropertySubBase") Discovered.FPropertySubBase = value;
+        else if (key == "FEnumPropertyUnderlyingProp") Discovered.FEnumPropertyUnderlyingProp = value;
+        else if (key == "FEnumPropertyEnum") Discovered.FEnumPropertyEnum = value;
+        else if (key == "HasDiscovered") HasDiscovered = value != 0;
+        else if (key == "EngineMajor") EngineVersion.Major = int(value);
+        else if (key == "EngineMinor") EngineVersion.Minor = int(value);
+        else if (key == "EnginePatch") EngineVersion.Patch = int(strtol(line.c_str() + eq + 1, nullptr, 10));
+        else if (key == "EngineChangelist") EngineVersion.Changelist = uint32_t(value);
+        else if (key == "EngineBranch") EngineVersion.Branch = line.substr(eq + 1);
+    }
+
+    return Pointers.Names != 0 && Pointers.UObjectArray != 0;
+}
+
+bool UEOffsetsCache::Save(const std::string &path) const
+{
+    std::string dir = IOUtils::get_file_directory(path);
+    if (!dir.empty() && IOUtils::mkdir_recursive(dir, 0777) == -1 && errno != EEXIST)
+        return false;
+
+    BufferFmt buffer;
+    buffer.append("{}\n", kCacheHeader);
+    buffer.append("Names={:X}\nUObjectArray={:X}\nObjObjects={:X}\n", Pointers.Names, Pointers.UObjectArray, Pointers.ObjObjects);
+    buffer.append("Engine={:X}\nWorld={:X}\n", Pointers.Engine, Pointers.World);
+    buffer.append("ProcessEvent={:X}\nProcessEventIndex={:X}\n", Pointers.ProcessEvent, Pointers.ProcessEventIndex);
+    buffer.append("HasPointers={:X}\n", int(HasPointers));
+    buffer.append("FPropertySubBase={:X}\nFEnumPropertyUnderlyingProp={:X}\nFEnumPropertyEnum={:X}\n",
+                  Discovered.FPropertySubBase, Discovered.FEnumPropertyUnderlyingProp, Discovered.FEnumPropertyEnum);
+    buffer.append("HasDiscovered={:X}\n", int(HasDiscovered));
+    if (EngineVersion.IsValid())
+    {
+        // patch is decimal, -1 when only the branch name was found
+        buffer.append("EngineMajor={:X}\nEngineMinor={:X}\nEnginePatch={}\n", EngineVersion.Major, EngineVersion.Minor, EngineVersion.Patch);
+        buffer.append("EngineChangelist={:X}\nEngineBranch={}\n", EngineVersion.Changelist, EngineVersion.Branch);
+    }
+    return buffer.writeBufferToFile(path);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+
+#include "UEEngineVersion.hpp"
+#include "UEMemory.hpp"
+#include "UEOffsets.hpp"
+
+// Resolved pointers & discovered offsets of one UE library build, kept on disk so later runs
+// on the same build skip the pattern scans. Everything is library relative.
+struct UEOffsetsCache
+{
+    UE_Pointers Pointers{};
+    // Engine, World & ProcessEvent were resolved, Names & UObjectArray always are
+    bool HasPointers = false;
+
+    UE_DiscoveredOffsets Discovered{};
+    bool HasDiscovered = false;
+
+    // not valid if it wasn't fingerprinted
+    UEEngineVersion EngineVersion{};
+
+    // "build-<GNU build-id>", or "text-<hash of the executable segments>" when the headers are stripped,
+    // empty if neither can be read
+    static std::string GetBuildKey(const ElfScanner &elf);
+
+    bool Load(const std::string &path);
+    bool Save(const std::string &path) const;
+};
@@ -0,0 +1,994 @@
+#include "UEOffsetsDiscovery.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+
+#include "UEWrappers.hpp"
+
+#include "../Utils/ThreadPool.hpp"
+
+using namespace UEMemory;
+
+namespace
+{
+    constexpr int32_t kSampledObjects = 8192;
+    // names decoded per NamePrivate candidate
+    constexpr size_t kNameSamples = 1024;
+    constexpr size_t kObjectBlockSize = 0x40;
+    constexpr size_t kStructBlockSize = 0x200;
+    constexpr size_t kFieldBlockSize = 0x100;
+    constexpr size_t kMaxSampledClasses = 128;
+    constexpr size_t kMaxSampledFunctions = 512;
+    constexpr size_t kMaxSampledEnums = 64;
+    constexpr size_t kMaxChain = 64;
+
+    // EPropertyFlags of Vector X, Y & Z: CPF_Edit | CPF_BlueprintVisible | CPF_ZeroConstructor
+    constexpr uint64_t kVectorMemberFlags = 0x1 | 0x4 | 0x200;
+    // EFunctionFlags FUNC_Public | FUNC_Private | FUNC_Protected, one of them is set
+    constexpr uint32_t kFunctionAccessFlags = 0x20000 | 0x40000 | 0x80000;
+    constexpr uint32_t kClassDefaultObjectFlag = 0x10;
+
+    // first CoreUObject objects, any engine version has most of them
+    const char *const kCoreNames[] = {
+        "Object", "Class", "Struct", "Field", "Function", "Package", "Enum", "ScriptStruct",
+        "Interface", "Vector", "Rotator", "Guid", "Color", "LinearColor", "Transform", "Box"};
+
+    struct Candidate
+    {
+        uintptr_t Offset = 0;
+        int Score = -1;
+    };
+
+    template <typename T>
+    T BlockGet(const std::vector<uint8_t> &block, uintptr_t offset)
+    {
+        T value{};
+        if (offset + sizeof(T) <= block.size())
+            memcpy(&value, block.data() + offset, sizeof(T));
+        return value;
+    }
+
+    inline uint8_t *BlockGetPtr(const std::vector<uint8_t> &block, uintptr_t offset)
+    {
+        return BlockGet<uint8_t *>(block, offset);
+    }
+
+    inline bool Overlaps(uintptr_t a, size_t aSize, uintptr_t b, size_t bSize)
+    {
+        return a < b + bSize && b < a + aSize;
+    }
+
+    inline bool IsCoreName(const std::string &name)
+    {
+        return std::any_of(std::begin(kCoreNames), std::end(kCoreNames), [&name](const char *core)
+        { return name == core; });
+    }
+
+    inline bool EndsWith(const std::string &s, const std::string &suffix)
+    {
+        return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    std::string NameByID(int32_t id)
+    {
+        // ids are block/offset pairs or table indices, way below this
+        if (id < 0 || id >= (1 << 26))
+            return "";
+
+        return UEWrappers::GetUEVars()->GetNameByID(id);
+    }
+}  // namespace
+
+UEOffsetsDiscovery::UEOffsetsDiscovery(const IGameProfile *profile) : _profile(profile)
+{
+    if (profile && profile->GetOffsets())
+        _offsets = *profile->GetOffsets();
+}
+
+void UEOffsetsDiscovery::addFinding(const std::string &field, uintptr_t *target, uintptr_t value, int score, int samples)
+{
+    if (target)
+        *target = value;
+
+    Finding finding;
+    finding.Field = field;
+    finding.Value = value;
+    finding.Score = score;
+    finding.Samples = samples;
+    _findings.push_back(finding);
+}
+
+std::vector<UEOffsetsDiscovery::Block> UEOffsetsDiscovery::ReadBlocks(const std::vector<uint8_t *> &addresses, size_t size)
+{
+    std::vector<Block> blocks(addresses.size());
+    std::vector<RemoteRead> reads;
+    std::vector<size_t> readIndices;
+    reads.reserve(addresses.size());
+    readIndices.reserve(addresses.size());
+
+    for (size_t i = 0; i < addresses.size(); i++)
+    {
+        if (!addresses[i])
+            continue;
+
+        blocks[i].resize(size);
+
+        RemoteRead read;
+        read.address = addresses[i];
+        read.result = blocks[i].data();
+        read.len = size;
+        reads.push_back(read);
+        readIndices.push_back(i);
+    }
+
+    vm_rpm_batch(reads);
+
+    // failed blocks stay empty, BlockGet reads zeros from them
+    for (size_t i = 0; i < reads.size(); i++)
+    {
+        if (!reads[i].ok)
+            blocks[readIndices[i]].clear();
+    }
+
+    return blocks;
+}
+
+std::string UEOffsetsDiscovery::nameAt(const uint8_t *address) const
+{
+    int32_t id = -1;
+    if (!address || !vm_rpm_ptr(address + _offsets.FName.ComparisonIndex, &id, sizeof(id)))
+        return "";
+
+    return NameByID(id);
+}
+
+std::string UEOffsetsDiscovery::className(size_t index) const
+{
+    return objectName(BlockGetPtr(_blocks[index], _offsets.UObject.ClassPrivate));
+}
+
+uint8_t *UEOffsetsDiscovery::findObject(const std::string &name, const std::string &clsName) const
+{
+    for (size_t i = 0; i < _objects.size(); i++)
+    {
+        if (_objects[i] && _names[i] == name && className(i) == clsName)
+            return _objects[i];
+    }
+    return nullptr;
+}
+
+bool UEOffsetsDiscovery::isObject(uint8_t *address) const
+{
+    if (!address)
+        return false;
+
+    if (_objectsIndex.count(address))
+        return true;
+
+    int32_t index = -1;
+    if (!vm_rpm_ptr(address + _offsets.UObject.InternalIndex, &index, sizeof(index)) || index < 0)
+        return false;
+
+    return UEWrappers::GetObjects()->GetObjectPtr(index) == address;
+}
+
+std::string UEOffsetsDiscovery::objectName(uint8_t *address) const
+{
+    if (!address)
+        return "";
+
+    auto it = _objectsIndex.find(address);
+    if (it != _objectsIndex.end())
+        return _names[it->second];
+
+    return nameAt(address + _offsets.UObject.NamePrivate);
+}
+
+std::string UEOffsetsDiscovery::objectClassName(uint8_t *address) const
+{
+    if (!address)
+        return "";
+
+    return objectName(vm_rpm_ptr<uint8_t *>(address + _offsets.UObject.ClassPrivate));
+}
+
+bool UEOffsetsDiscovery::Run()
+{
+    _findings.clear();
+    _useFField = false;
+
+    if (!_profile || !UEWrappers::GetObjects())
+        return false;
+
+    int32_t count = std::min(UEWrappers::GetObjects()->GetNumElements(), kSampledObjects);
+    if (count <= 0)
+        return false;
+
+    _objects.assign(count, nullptr);
+    for (int32_t i = 0; i < count; i++)
+        _objects[i] = UEWrappers::GetObjects()->GetObjectPtr(i);
+
+    _blocks = ReadBlocks(_objects, kObjectBlockSize);
+
+    _objectsIndex.clear();
+    for (int32_t i = 0; i < count; i++)
+    {
+        if (_blocks[i].empty())
+            _objects[i] = nullptr;
+        else
+            _objectsIndex[_objects[i]] = i;
+    }
+
+    if (!discoverUObject())
+    {
+        LOGE("Offsets discovery: couldn't infer UObject layout.");
+        return false;
+    }
+
+    if (!discoverUStruct())
+    {
+        LOGE("Offsets discovery: couldn't infer UStruct layout.");
+        return false;
+    }
+
+    if (!discoverProperties())
+        LOGW("Offsets discovery: couldn't infer properties layout.");
+
+    discoverUFunction();
+    discoverUEnum();
+
+    return true;
+}
+
+bool UEOffsetsDiscovery::discoverUObject()
+{
+    const size_t count = _objects.size();
+    const int valid = int(_objectsIndex.size());
+    if (valid < 64)
+        return false;
+
+    // InternalIndex is the object's own index
+    Candidate index;
+    for (uintptr_t off = 0; off + sizeof(int32_t) <= kObjectBlockSize; off += sizeof(int32_t))
+    {
+        int score = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            if (_objects[i] && BlockGet<int32_t>(_blocks[i], off) == int32_t(i))
+                score++;
+        }
+        if (score > index.Score)
+            index = {off, score};
+    }
+    if (index.Score < valid * 9 / 10)
+        return false;
+
+    // ClassPrivate points into the objects and is never null, Class is its own class.
+    // OuterPrivate points into the objects too but packages have none
+    Candidate cls, outer;
+    for (uintptr_t off = 0; off + sizeof(void *) <= kObjectBlockSize; off += sizeof(void *))
+    {
+        if (Overlaps(off, sizeof(void *), index.Offset, sizeof(int32_t)))
+            continue;
+
+        int inSet = 0, nulls = 0;
+        bool selfRef = false;
+        for (size_t i = 0; i < count; i++)
+        {
+            if (!_objects[i])
+                continue;
+
+            uint8_t *p = BlockGetPtr(_blocks[i], off);
+            if (!p)
+                nulls++;
+            else if (_objectsIndex.count(p))
+                inSet++;
+
+            if (p == _objects[i])
+                selfRef = true;
+        }
+
+        if (nulls == 0 && selfRef)
+        {
+            if (inSet > cls.Score)
+                cls = {off, inSet};
+        }
+        else if (nulls > 0 && inSet + nulls >= valid * 3 / 4)
+        {
+            if (inSet > outer.Score)
+                outer = {off, inSet};
+        }
+    }
+    if (cls.Score < valid * 3 / 4 || outer.Score <= 0)
+        return false;
+
+    // NamePrivate decodes to the CoreUObject names
+    std::vector<uintptr_t> nameOffsets;
+    const size_t nameCount = std::min(count, kNameSamples);
+    for (uintptr_t off = 0; off + sizeof(int32_t) <= kObjectBlockSize; off += sizeof(int32_t))
+    {
+        if (Overlaps(off, sizeof(int32_t), index.Offset, sizeof(int32_t)) ||
+            Overlaps(off, sizeof(int32_t), cls.Offset, sizeof(void *)) ||
+            Overlaps(off, sizeof(int32_t), outer.Offset, sizeof(void *)))
+            continue;
+
+        int plausible = 0;
+        for (size_t i = 0; i < nameCount; i++)
+        {
+            int32_t id = BlockGet<int32_t>(_blocks[i], off + _offsets.FName.ComparisonIndex);
+            if (_objects[i] && id > 0 && id < (1 << 26))
+                plausible++;
+        }
+        if (plausible >= int(nameCount) / 2)
+            nameOffsets.push_back(off);
+    }
+    if (nameOffsets.empty())
+        return false;
+
+    std::vector<int> nameScores(nameOffsets.size(), 0);
+    ThreadPool::Get().parallelFor(0, nameOffsets.size(), 1, [&](size_t begin, size_t end)
+    {
+        for (size_t k = begin; k < end; k++)
+        {
+            int score = 0;
+            for (size_t i = 0; i < nameCount; i++)
+            {
+                if (!_objects[i])
+                    continue;
+
+                std::string name = NameByID(BlockGet<int32_t>(_blocks[i], nameOffsets[k] + _offsets.FName.ComparisonIndex));
+                if (IsCoreName(name))
+                    score += 2;
+                else if (i == 0 && name.compare(0, 8, "/Script/") == 0)
+                    score += 4;
+                else if (!name.empty())
+                    score++;
+            }
+            nameScores[k] = score;
+        }
+    });
+
+    auto bestName = std::max_element(nameScores.begin(), nameScores.end());
+    Candidate name = {nameOffsets[bestName - nameScores.begin()], *bestName};
+    if (name.Score < int(nameCount) / 2)
+        return false;
+
+    _offsets.UObject.NamePrivate = name.Offset;
+    _names.assign(count, "");
+    ThreadPool::Get().parallelFor(0, count, 256, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            if (_objects[i])
+                _names[i] = NameByID(BlockGet<int32_t>(_blocks[i], name.Offset + _offsets.FName.ComparisonIndex));
+        }
+    });
+
+    // ObjectFlags has RF_ClassDefaultObject on Default__ objects only
+    Candidate flags;
+    int cdoCount = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (_objects[i] && _names[i].compare(0, 9, "Default__") == 0)
+            cdoCount++;
+    }
+    for (uintptr_t off = 0; cdoCount > 0 && off + sizeof(int32_t) <= kObjectBlockSize; off += sizeof(int32_t))
+    {
+        if (Overlaps(off, sizeof(int32_t), index.Offset, sizeof(int32_t)) ||
+            Overlaps(off, sizeof(int32_t), cls.Offset, sizeof(void *)) ||
+            Overlaps(off, sizeof(int32_t), outer.Offset, sizeof(void *)) ||
+            Overlaps(off, sizeof(int32_t), name.Offset, _offsets.FName.Size))
+            continue;
+
+        int score = 0, cdoHits = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            if (!_objects[i] || _names[i].empty())
+                continue;
+
+            bool cdo = _names[i].compare(0, 9, "Default__") == 0;
+            bool flagged = (BlockGet<uint32_t>(_blocks[i], off) & kClassDefaultObjectFlag) != 0;
+            if (cdo == flagged)
+            {
+                score++;
+                if (cdo)
+                    cdoHits++;
+            }
+        }
+        if (cdoHits > 0 && score > flags.Score)
+            flags = {off, score};
+    }
+
+    addFinding("UObject.InternalIndex", &_offsets.UObject.InternalIndex, index.Offset, index.Score, valid);
+    addFinding("UObject.ClassPrivate", &_offsets.UObject.ClassPrivate, cls.Offset, cls.Score, valid);
+    addFinding("UObject.NamePrivate", &_offsets.UObject.NamePrivate, name.Offset, name.Score, int(nameCount) * 2);
+    addFinding("UObject.OuterPrivate", &_offsets.UObject.OuterPrivate, outer.Offset, outer.Score, valid);
+    if (flags.Score > 0)
+        addFinding("UObject.ObjectFlags", &_offsets.UObject.ObjectFlags, flags.Offset, flags.Score, valid);
+
+    uintptr_t end = std::max({index.Offset + sizeof(int32_t),
+                              cls.Offset + sizeof(void *),
+                              outer.Offset + sizeof(void *),
+                              name.Offset + _offsets.FName.Size,
+                              flags.Score > 0 ? flags.Offset + sizeof(int32_t) : 0});
+    _uobjectEnd = GetPtrAlignedOf(end);
+
+    return true;
+}
+
+bool UEOffsetsDiscovery::discoverUStruct()
+{
+    uint8_t *objectClass = findObject("Object", "Class");
+    uint8_t *classClass = findObject("Class", "Class");
+    uint8_t *structClass = findObject("Struct", "Class");
+    uint8_t *fieldClass = findObject("Field", "Class");
+    uint8_t *vectorStruct = findObject("Vector", "ScriptStruct");
+    uint8_t *guidStruct = findObject("Guid", "ScriptStruct");
+    if (!objectClass || !classClass || !structClass || !vectorStruct)
+        return false;
+
+    auto blocks = ReadBlocks({objectClass, classClass, structClass, vectorStruct, guidStruct}, kStructBlockSize);
+    const Block &objectB = blocks[0], &classB = blocks[1], &structB = blocks[2], &vectorB = blocks[3], &guidB = blocks[4];
+    if (objectB.empty() || classB.empty() || vectorB.empty())
+        return false;
+
+    // SuperStruct: Class -> Struct, Object & Vector have none
+    Candidate super;
+    for (uintptr_t off = _uobjectEnd; off + sizeof(void *) <= kStructBlockSize; off += sizeof(void *))
+    {
+        if (BlockGetPtr(classB, off) != structClass)
+            continue;
+
+        int score = 2;
+        if (!BlockGetPtr(objectB, off)) score++;
+        if (!BlockGetPtr(vectorB, off)) score++;
+        if (fieldClass && BlockGetPtr(structB, off) == fieldClass) score++;
+        if (score > super.Score)
+            super = {off, score};
+    }
+    if (super.Score < 4)
+        return false;
+
+    // PropertiesSize: sizeof(FVector), sizeof(FGuid) & sizeof(UObject)
+    Candidate size;
+    for (uintptr_t off = super.Offset + sizeof(void *); off + sizeof(int32_t) <= kStructBlockSize; off += sizeof(int32_t))
+    {
+        int32_t vectorSize = BlockGet<int32_t>(vectorB, off);
+        int32_t objectSize = BlockGet<int32_t>(objectB, off);
+        int score = 0;
+        if (vectorSize == 12 || vectorSize == 24) score++;
+        if (!guidB.empty() && BlockGet<int32_t>(guidB, off) == 16) score++;
+        // UObject is 0x1C on 32bit targets without case preserving names, it ends with its last field
+        if (objectSize >= int32_t(_uobjectEnd) && objectSize <= 0x40) score++;
+        if (BlockGet<int32_t>(classB, off) > objectSize) score++;
+        if (score > size.Score)
+            size = {off, score};
+    }
+    if (size.Score < (guidB.empty() ? 3 : 4))
+        return false;
+
+    addFinding("UStruct.SuperStruct", &_offsets.UStruct.SuperStruct, super.Offset, super.Score, 5);
+    addFinding("UStruct.PropertiesSize", &_offsets.UStruct.PropertiesSize, size.Offset, size.Score, 4);
+
+    // Children & ChildProperties sit between them
+    std::vector<uintptr_t> childOffsets;
+    for (uintptr_t off = super.Offset + sizeof(void *); off + sizeof(void *) <= size.Offset; off += sizeof(void *))
+        childOffsets.push_back(off);
+    if (childOffsets.empty())
+        return false;
+
+    // ChildProperties of Vector is a FField named X, not an object
+    for (uintptr_t off : childOffsets)
+    {
+        uint8_t *x = BlockGetPtr(vectorB, off);
+        if (!x || isObject(x))
+            continue;
+
+        Block xb = ReadBlocks({x}, kFieldBlockSize)[0];
+        for (uintptr_t nameOff = sizeof(void *); nameOff + sizeof(int32_t) <= kFieldBlockSize; nameOff += sizeof(int32_t))
+        {
+            if (NameByID(BlockGet<int32_t>(xb, nameOff + _offsets.FName.ComparisonIndex)) == "X")
+            {
+                _useFField = true;
+                addFinding("UStruct.ChildProperties", &_offsets.UStruct.ChildProperties, off, 1, 1);
+                addFinding("FField.NamePrivate", &_offsets.FField.NamePrivate, nameOff, 1, 1);
+                break;
+            }
+        }
+        if (_useFField)
+            break;
+    }
+
+    if (!_useFField)
+        _offsets.UStruct.ChildProperties = 0;
+
+    // Children points to functions or, before FField, properties too
+    std::vector<uint8_t *> classes;
+    for (size_t i = 0; i < _objects.size() && classes.size() < kMaxSampledClasses; i++)
+    {
+        if (_objects[i] && className(i) == "Class")
+            classes.push_back(_objects[i]);
+    }
+    classes.push_back(vectorStruct);
+    auto classBlocks = ReadBlocks(classes, kStructBlockSize);
+
+    Candidate children;
+    for (uintptr_t off : childOffsets)
+    {
+        if (_useFField && off == _offsets.UStruct.ChildProperties)
+            continue;
+
+        int score = 0;
+        for (const auto &block : classBlocks)
+        {
+            uint8_t *child = BlockGetPtr(block, off);
+            if (!child || !isObject(child))
+                continue;
+
+            std::string childClass = objectClassName(child);
+            if (childClass == "Function" || (!_useFField && EndsWith(childClass, "Property")))
+                score++;
+        }
+        if (score > children.Score)
+            children = {off, score};
+    }
+    if (children.Score <= 0)
+        return false;
+
+    addFinding("UStruct.Children", &_offsets.UStruct.Children, children.Offset, children.Score, int(classBlocks.size()));
+
+    return true;
+}
+
+bool UEOffsetsDiscovery::discoverProperties()
+{
+    uint8_t *vectorStruct = findObject("Vector", "ScriptStruct");
+    if (!vectorStruct)
+        return false;
+
+    uintptr_t firstMember = _useFField ? _offsets.UStruct.ChildProperties : _offsets.UStruct.Children;
+    uint8_t *x = vm_rpm_ptr<uint8_t *>(vectorStruct + firstMember);
+    if (!x)
+        return false;
+
+    Block xb = ReadBlocks({x}, kFieldBlockSize)[0];
+    uintptr_t nextStart = _useFField ? sizeof(void *) : _uobjectEnd;
+    uintptr_t memberName = _useFField ? _offsets.FField.NamePrivate : _offsets.UObject.NamePrivate;
+
+    // Next: X -> Y -> Z
+    uint8_t *y = nullptr, *z = nullptr;
+    uintptr_t next = 0;
+    for (uintptr_t off = nextStart; off + sizeof(void *) <= kFieldBlockSize; off += sizeof(void *))
+    {
+        if (Overlaps(off, sizeof(void *), memberName, _offsets.FName.Size))
+            continue;
+
+        uint8_t *p = BlockGetPtr(xb, off);
+        if (p && nameAt(p + memberName) == "Y")
+        {
+            uint8_t *pz = vm_rpm_ptr<uint8_t *>(p + off);
+            if (pz && nameAt(pz + memberName) == "Z")
+            {
+                next = off;
+                y = p;
+                z = pz;
+                break;
+            }
+        }
+    }
+    if (!y || !z)
+        return false;
+
+    uintptr_t headerEnd = 0;
+    if (_useFField)
+    {
+        addFinding("FField.Next", &_offsets.FField.Next, next, 2, 2);
+
+        // ClassPrivate: FFieldClass, its name is at the start
+        Candidate fieldClass;
+        for (uintptr_t off = 0; off + sizeof(void *) <= kFieldBlockSize; off += sizeof(void *))
+        {
+            if (off == next || Overlaps(off, sizeof(void *), memberName, _offsets.FName.Size))
+                continue;
+
+            uint8_t *p = BlockGetPtr(xb, off);
+            std::string name = p ? nameAt(p) : "";
+            if (name == "FloatProperty" || name == "DoubleProperty")
+            {
+                fieldClass = {off, 1};
+                break;
+            }
+        }
+        if (fieldClass.Score > 0)
+            addFinding("FField.ClassPrivate", &_offsets.FField.ClassPrivate, fieldClass.Offset, 1, 1);
+
+        // EObjectFlags follows the name
+        addFinding("FField.FlagsPrivate", &_offsets.FField.FlagsPrivate, _offsets.FField.NamePrivate + _offsets.FName.Size, 0, 0);
+
+        headerEnd = std::max({_offsets.FField.FlagsPrivate + sizeof(int32_t), next + sizeof(void *), fieldClass.Offset + sizeof(void *)});
+    }
+    else
+    {
+        addFinding("UField.Next", &_offsets.UField.Next, next, 2, 2);
+        headerEnd = next + sizeof(void *);
+    }
+
+    auto blocks = ReadBlocks({x, y, z}, kFieldBlockSize);
+    const Block &b0 = blocks[0], &b1 = blocks[1], &b2 = blocks[2];
+
+    // FProperty & UProperty have the same fields
+    auto propsField = [this](uintptr_t &fproperty, uintptr_t &uproperty)
+    { return _useFField ? &fproperty : &uproperty; };
+    const std::string prefix = _useFField ? "FProperty." : "UProperty.";
+
+    // Offset_Internal: 0, e & 2e
+    Candidate offsetInternal;
+    int32_t elementSize = 0;
+    for (uintptr_t off = headerEnd; off + sizeof(int32_t) <= kFieldBlockSize; off += sizeof(int32_t))
+    {
+        int32_t o0 = BlockGet<int32_t>(b0, off), o1 = BlockGet<int32_t>(b1, off), o2 = BlockGet<int32_t>(b2, off);
+        if (o0 == 0 && (o1 == 4 || o1 == 8) && o2 == o1 * 2)
+        {
+            offsetInternal = {off, 3};
+            elementSize = o1;
+            break;
+        }
+    }
+    if (offsetInternal.Score <= 0)
+        return false;
+
+    // ArrayDim 1 and ElementSize e on all three, both come first
+    Candidate arrayDim, elemSize;
+    for (uintptr_t off = headerEnd; off + sizeof(int32_t) <= offsetInternal.Offset; off += sizeof(int32_t))
+    {
+        int32_t v0 = BlockGet<int32_t>(b0, off), v1 = BlockGet<int32_t>(b1, off), v2 = BlockGet<int32_t>(b2, off);
+        if (v0 != v1 || v1 != v2)
+            continue;
+
+        if (v0 == 1 && arrayDim.Score < 0)
+            arrayDim = {off, 3};
+        else if (v0 == elementSize && elemSize.Score < 0)
+            elemSize = {off, 3};
+    }
+
+    // PropertyFlags, same on all three
+    Candidate propertyFlags;
+    for (uintptr_t off = GetPtrAlignedOf(headerEnd); off + sizeof(uint64_t) <= offsetInternal.Offset; off += sizeof(uint64_t))
+    {
+        uint64_t f0 = BlockGet<uint64_t>(b0, off);
+        if (f0 == BlockGet<uint64_t>(b1, off) && f0 == BlockGet<uint64_t>(b2, off) && (f0 & kVectorMemberFlags) == kVectorMemberFlags)
+        {
+            propertyFlags = {off, 3};
+            break;
+        }
+    }
+
+    addFinding(prefix + "Offset_Internal", propsField(_offsets.FProperty.Offset_Internal, _offsets.UProperty.Offset_Internal), offsetInternal.Offset, 3, 3);
+    if (arrayDim.Score > 0)
+        addFinding(prefix + "ArrayDim", propsField(_offsets.FProperty.ArrayDim, _offsets.UProperty.ArrayDim), arrayDim.Offset, 3, 3);
+    if (elemSize.Score > 0)
+        addFinding(prefix + "ElementSize", propsField(_offsets.FProperty.ElementSize, _offsets.UProperty.ElementSize), elemSize.Offset, 3, 3);
+    if (propertyFlags.Score > 0)
+        addFinding(prefix + "PropertyFlags", propsField(_offsets.FProperty.PropertyFlags, _offsets.UProperty.PropertyFlags), propertyFlags.Offset, 3, 3);
+
+    // Size: subclass data starts right after, a struct member points to Vector there
+    for (const char *owner : {"Box", "BoxSphereBounds", "Transform"})
+    {
+        uint8_t *ownerStruct = findObject(owner, "ScriptStruct");
+        if (!ownerStruct)
+            continue;
+
+        uint8_t *member = vm_rpm_ptr<uint8_t *>(ownerStruct + firstMember);
+        for (int i = 0; member && i < 4; i++)
+        {
+            Block mb = ReadBlocks({member}, kFieldBlockSize)[0];
+            for (uintptr_t off = GetPtrAlignedOf(offsetInternal.Offset + sizeof(int32_t)); off + sizeof(void *) <= kFieldBlockSize; off += sizeof(void *))
+            {
+                if (BlockGetPtr(mb, off) == vectorStruct)
+                {
+                    addFinding(prefix + "Size", propsField(_offsets.FProperty.Size, _offsets.UProperty.Size), off, 1, 1);
+                    return true;
+                }
+            }
+            member = BlockGetPtr(mb, next);
+        }
+    }
+
+    return true;
+}
+
+void UEOffsetsDiscovery::discoverUFunction()
+{
+    std::vector<uint8_t *> classes;
+    for (size_t i = 0; i < _objects.size() && classes.size() < kMaxSampledClasses; i++)
+    {
+        if (_objects[i] && className(i) == "Class")
+            classes.push_back(_objects[i]);
+    }
+
+    std::vector<uint8_t *> firstFunctions;
+    for (const auto &block : ReadBlocks(classes, kStructBlockSize))
+    {
+        uint8_t *child = BlockGetPtr(block, _offsets.UStruct.Children);
+        if (child && objectClassName(child) == "Function")
+            firstFunctions.push_back(child);
+    }
+    if (firstFunctions.empty())
+        return;
+
+    // UField.Next of functions, properties gave it already before FField
+    if (_useFField)
+    {
+        auto blocks = ReadBlocks(firstFunctions, _uobjectEnd + sizeof(void *) * 4);
+        Candidate next;
+        for (uintptr_t off = _uobjectEnd; off < _uobjectEnd + sizeof(void *) * 4; off += sizeof(void *))
+        {
+            int score = 0;
+            for (const auto &block : blocks)
+            {
+                uint8_t *p = BlockGetPtr(block, off);
+                if (p && objectClassName(p) == "Function")
+                    score++;
+            }
+            if (score > next.Score)
+                next = {off, score};
+        }
+        if (next.Score <= 0)
+            return;
+
+        addFinding("UField.Next", &_offsets.UField.Next, next.Offset, next.Score, int(blocks.size()));
+    }
+
+    std::vector<uint8_t *> functions;
+    for (uint8_t *f : firstFunctions)
+    {
+        for (size_t i = 0; f && i < kMaxChain && functions.size() < kMaxSampledFunctions; i++)
+        {
+            functions.push_back(f);
+            f = vm_rpm_ptr<uint8_t *>(f + _offsets.UField.Next);
+        }
+    }
+
+    auto blocks = ReadBlocks(functions, kStructBlockSize);
+
+    // params are the function's members
+    uintptr_t firstParam = _useFField ? _offsets.UStruct.ChildProperties : _offsets.UStruct.Children;
+    uintptr_t paramNext = _useFField ? _offsets.FField.Next : _offsets.UField.Next;
+    std::vector<int> paramsCount(functions.size(), 0);
+    ThreadPool::Get().parallelFor(0, functions.size(), 16, [&](size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            uint8_t *param = BlockGetPtr(blocks[i], firstParam);
+            for (size_t k = 0; param && k < kMaxChain; k++)
+            {
+                paramsCount[i]++;
+                param = vm_rpm_ptr<uint8_t *>(param + paramNext);
+            }
+        }
+    });
+
+    const uintptr_t start = _offsets.UStruct.PropertiesSize + sizeof(int32_t);
+    const int sampled = int(functions.size());
+
+    // Func: native thunk or ProcessInternal, both in the library
+    ElfScanner elf = _profile->GetUnrealELF();
+    Candidate func;
+    for (uintptr_t off = GetPtrAlignedOf(start); off + sizeof(void *) <= kStructBlockSize; off += sizeof(void *))
+    {
+        int score = 0;
+        for (const auto &block : blocks)
+        {
+            uintptr_t p = uintptr_t(BlockGetPtr(block, off));
+            if (p >= elf.base() && p < elf.end())
+                score++;
+        }
+        if (score > func.Score)
+            func = {off, score};
+    }
+    if (func.Score > sampled / 2)
+        addFinding("UFunction.Func", &_offsets.UFunction.Func, func.Offset, func.Score, sampled);
+
+    // NumParams: members count, ParamSize: PropertiesSize
+    Candidate numParams, paramSize;
+    int withParams = 0;
+    for (int count : paramsCount)
+    {
+        if (count > 0)
+            withParams++;
+    }
+    for (uintptr_t off = start; off + sizeof(uint16_t) <= kStructBlockSize; off++)
+    {
+        int numScore = 0, sizeScore = 0;
+        for (size_t i = 0; i < blocks.size(); i++)
+        {
+            if (paramsCount[i] == 0)
+                continue;
+
+            if (BlockGet<uint8_t>(blocks[i], off) == paramsCount[i])
+                numScore++;
+
+            if ((off % sizeof(uint16_t)) == 0 && BlockGet<uint16_t>(blocks[i], off) == BlockGet<int32_t>(blocks[i], _offsets.UStruct.PropertiesSize))
+                sizeScore++;
+        }
+        if (numScore > numParams.Score)
+            numParams = {off, numScore};
+        if (sizeScore > paramSize.Score && (off < func.Offset || off >= func.Offset + sizeof(void *)))
+            paramSize = {off, sizeScore};
+    }
+    if (withParams > 0 && numParams.Score > withParams / 2)
+        addFinding("UFunction.NumParams", &_offsets.UFunction.NumParams, numParams.Offset, numParams.Score, withParams);
+    if (withParams > 0 && paramSize.Score > withParams / 2)
+        addFinding("UFunction.ParamSize", &_offsets.UFunction.ParamSize, paramSize.Offset, paramSize.Score, withParams);
+
+    // EFunctionFlags: exactly one access specifier, it comes before NumParams
+    Candidate functionFlags;
+    uintptr_t flagsEnd = numParams.Score > 0 ? numParams.Offset : kStructBlockSize;
+    for (uintptr_t off = start; off + sizeof(uint32_t) <= flagsEnd; off += sizeof(uint32_t))
+    {
+        if (Overlaps(off, sizeof(uint32_t), func.Offset, sizeof(void *)) ||
+            Overlaps(off, sizeof(uint32_t), paramSize.Offset, sizeof(uint16_t)))
+            continue;
+
+        int score = 0;
+        for (const auto &block : blocks)
+        {
+            uint32_t flags = BlockGet<uint32_t>(block, off);
+            if (std::bitset<32>(flags & kFunctionAccessFlags).count() == 1)
+                score++;
+        }
+        if (score > functionFlags.Score)
+            functionFlags = {off, score};
+    }
+    if (functionFlags.Score > sampled / 2)
+        addFinding("UFunction.EFunctionFlags", &_offsets.UFunction.EFunctionFlags, functionFlags.Offset, functionFlags.Score, sampled);
+}
+
+void UEOffsetsDiscovery::discoverUEnum()
+{
+    std::vector<uint8_t *> enums;
+    for (size_t i = 0; i < _objects.size() && enums.size() < kMaxSampledEnums; i++)
+    {
+        if (_objects[i] && className(i) == "Enum")
+            enums.push_back(_objects[i]);
+    }
+    if (enums.empty())
+        return;
+
+    auto blocks = ReadBlocks(enums, kFieldBlockSize);
+
+    // Names: TArray<TPair<FName, int64>> with a small first value, CppType FString comes before it
+    const uintptr_t pairValue = GetPtrAlignedOf(_offsets.FName.Size);
+    Candidate names;
+    for (uintptr_t off = _uobjectEnd; off + sizeof(void *) + sizeof(int32_t) * 2 <= kFieldBlockSize; off += sizeof(void *))
+    {
+        int score = 0;
+        for (const auto &block : blocks)
+        {
+            uint8_t *data = BlockGetPtr(block, off);
+            int32_t num = BlockGet<int32_t>(block, off + sizeof(void *));
+            int32_t max = BlockGet<int32_t>(block, off + sizeof(void *) + sizeof(int32_t));
+            if (!data || num <= 0 || num > max || max > 0x10000)
+                continue;
+
+            int64_t value = vm_rpm_ptr<int64_t>(data + pairValue);
+            if (value < -1 || value > 0x10000 || nameAt(data).empty())
+                continue;
+
+            score++;
+        }
+        if (score > names.Score)
+            names = {off, score};
+    }
+
+    if (names.Score > int(blocks.size()) / 2)
+        addFinding("UEnum.Names", &_offsets.UEnum.Names, names.Offset, names.Score, int(blocks.size()));
+}
+
+void UEOffsetsDiscovery::WriteProfileCode(BufferFmt &out) const
+{
+    const UE_Offsets *current = _profile ? _profile->GetOffsets() : nullptr;
+
+    out.append("// Offsets discovered for {}, samples agreeing out of those checked:\n", _profile ? _profile->GetAppName() : "");
+    for (const auto &finding : _findings)
+    {
+        out.append("//   {} = 0x{:X}", finding.Field, finding.Value);
+        if (finding.Samples > 0)
+            out.append(" ({}/{})", finding.Score, finding.Samples);
+        else
+            out.append(" (derived)");
+        out.append("\n");
+    }
+    out.append("\n");
+
+    const char *table = _engineVersion.GetDefaultOffsetsName();
+    if (!table)
+        table = _useFField ? "UE4_25_27" : "UE4_23_24";
+
+    if (_engineVersion.IsValid())
+        out.append("// Engine: {}\n", _engineVersion.ToString());
+
+    out.append("UE_Offsets *GetOffsets() const override\n");
+    out.append("{{\n");
+    if (_engineVersion.Major >= 5)
+        out.append("    static UE_Offsets offsets = UE_DefaultOffsets::{}(isUsingCasePreservingName(), isUsingOutlineNumberName());\n\n", table);
+    else
+        out.append("    static UE_Offsets offsets = UE_DefaultOffsets::{}(isUsingCasePreservingName());\n\n", table);
+    out.append("    static bool once = false;\n");
+    out.append("    if (!once)\n");
+    out.append("    {{\n");
+    out.append("        once = true;\n\n");
+
+    auto emit = [&out, current](const char *group, const char *field, uintptr_t value, uintptr_t profileValue)
+    {
+        out.append("        offsets.{}.{} = 0x{:X};", group, field, value);
+        if (current && value != profileValue)
+            out.append("  // profile: 0x{:X}", profileValue);
+        out.append("\n");
+    };
+
+    // names & objects arrays come from the profile as they are, the rest from discovery
+#define DISCOVERY_EMIT(group, field) emit(#group, #field, _offsets.group.field, current ? current->group.field : 0)
+    DISCOVERY_EMIT(FName, ComparisonIndex);
+    DISCOVERY_EMIT(FName, DisplayIndex);
+    DISCOVERY_EMIT(FName, Number);
+    DISCOVERY_EMIT(FName, Size);
+    out.append("\n");
+    DISCOVERY_EMIT(FNamePool, Stride);
+    DISCOVERY_EMIT(FNamePool, BlocksBit);
+    DISCOVERY_EMIT(FNamePool, BlocksOff);
+    out.append("\n");
+    DISCOVERY_EMIT(FUObjectArray, ObjObjects);
+    DISCOVERY_EMIT(TUObjectArray, Objects);
+    DISCOVERY_EMIT(TUObjectArray, NumElements);
+    DISCOVERY_EMIT(TUObjectArray, NumElementsPerChunk);
+    DISCOVERY_EMIT(FUObjectItem, Object);
+    DISCOVERY_EMIT(FUObjectItem, Size);
+    out.append("\n");
+    DISCOVERY_EMIT(UObject, ObjectFlags);
+    DISCOVERY_EMIT(UObject, InternalIndex);
+    DISCOVERY_EMIT(UObject, ClassPrivate);
+    DISCOVERY_EMIT(UObject, NamePrivate);
+    DISCOVERY_EMIT(UObject, OuterPrivate);
+    out.append("\n");
+    DISCOVERY_EMIT(UField, Next);
+    DISCOVERY_EMIT(UEnum, Names);
+    out.append("\n");
+    DISCOVERY_EMIT(UStruct, SuperStruct);
+    DISCOVERY_EMIT(UStruct, Children);
+    DISCOVERY_EMIT(UStruct, ChildProperties);
+    DISCOVERY_EMIT(UStruct, PropertiesSize);
+    out.append("\n");
+    DISCOVERY_EMIT(UFunction, EFunctionFlags);
+    DISCOVERY_EMIT(UFunction, NumParams);
+    DISCOVERY_EMIT(UFunction, ParamSize);
+    DISCOVERY_EMIT(UFunction, Func);
+    out.append("\n");
+    if (_useFField)
+    {
+        DISCOVERY_EMIT(FField, ClassPrivate);
+        DISCOVERY_EMIT(FField, Next);
+        DISCOVERY_EMIT(FField, NamePrivate);
+        DISCOVERY_EMIT(FField, FlagsPrivate);
+        out.append("\n");
+        DISCOVERY_EMIT(FProperty, ArrayDim);
+        DISCOVERY_EMIT(FProperty, ElementSize);
+        DISCOVERY_EMIT(FProperty, PropertyFlags);
+        DISCOVERY_EMIT(FProperty, Offset_Internal);
+        DISCOVERY_EMIT(FProperty, Size);
+    }
+    else
+    {
+        DISCOVERY_EMIT(UProperty, ArrayDim);
+        DISCOVERY_EMIT(UProperty, ElementSize);
+        DISCOVERY_EMIT(UProperty, PropertyFlags);
+        DISCOVERY_EMIT(UProperty, Offset_Internal);
+        DISCOVERY_EMIT(UProperty, Size);
+    }
+#undef DISCOVERY_EMIT
+
+    out.append("    }}\n\n");
+    out.append("    return &offsets;\n");
+    out.append("}}\n");
+}
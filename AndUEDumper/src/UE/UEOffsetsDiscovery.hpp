@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "UEGameProfile.hpp"
+#include "UEEngineVersion.hpp"
+
+#include "../Utils/BufferFmt.hpp"
+
+// Infers UObject, UStruct, UFunction, UEnum & property offsets of a new title from invariants of
+// the core objects (CoreUObject Object, Class, Struct, Vector X/Y/Z, Box...).
+// Names and GUObjectArray must already work with the profile, everything else is scored on
+// blocks of the first objects read in bulk.
+class UEOffsetsDiscovery
+{
+public:
+    struct Finding
+    {
+        std::string Field;
+        uintptr_t Value = 0;
+        // samples agreeing out of those checked
+        int Score = 0;
+        int Samples = 0;
+    };
+
+    explicit UEOffsetsDiscovery(const IGameProfile *profile);
+
+    // false if UObject or UStruct couldn't be inferred, later steps depend on them
+    bool Run();
+
+    inline const UE_Offsets &GetOffsets() const { return _offsets; }
+    inline const std::vector<Finding> &GetFindings() const { return _findings; }
+    inline bool IsUsingFField() const { return _useFField; }
+
+    // picks the UE_DefaultOffsets table the profile code starts from
+    inline void setEngineVersion(const UEEngineVersion &version) { _engineVersion = version; }
+
+    // findings and a GetOffsets() override to paste in a profile
+    void WriteProfileCode(BufferFmt &out) const;
+
+private:
+    using Block = std::vector<uint8_t>;
+
+    const IGameProfile *_profile;
+    UE_Offsets _offsets;
+    std::vector<Finding> _findings;
+    bool _useFField = false;
+    UEEngineVersion _engineVersion;
+
+    // first objects of GUObjectArray, their first bytes & names once NamePrivate is known
+    std::vector<uint8_t *> _objects;
+    std::vector<Block> _blocks;
+    std::vector<std::string> _names;
+    std::unordered_map<uint8_t *, int32_t> _objectsIndex;
+
+    uintptr_t _uobjectEnd = 0;
+
+    void addFinding(const std::string &field, uintptr_t *target, uintptr_t value, int score, int samples);
+
+    static std::vector<Block> ReadBlocks(const std::vector<uint8_t *> &addresses, size_t size);
+
+    std::string nameAt(const uint8_t *address) const;
+    std::string className(size_t index) const;
+    // sampled object by name & class name
+    uint8_t *findObject(const std::string &name, const std::string &className) const;
+    // object pointer check through its own InternalIndex, for objects outside the sample
+    bool isObject(uint8_t *address) const;
+    std::string objectName(uint8_t *address) const;
+    std::string objectClassName(uint8_t *address) const;
+
+    bool discoverUObject();
+    bool discoverUStruct();
+    bool discoverProperties();
+    void discoverUFunction();
+    void discoverUEnum();
+};
@@ -0,0 +1,107 @@
+#include "UEProfileDetector.hpp"
+
+#include <algorithm>
+
+#include "UEWrappers.hpp"
+
+#include "../Utils/ThreadPool.hpp"
+#include "../Utils/TraceUtils.hpp"
+
+using namespace UEMemory;
+
+namespace
+{
+    // probe score of a profile whose patterns hit and point to a sane names pool & objects array
+    constexpr int kMinProbeScore = 5;
+    constexpr size_t kMaxValidated = 3;
+    constexpr int32_t kValidatedObjects = 32;
+
+    // first objects are CoreUObject's package & classes, their names are plain identifiers.
+    // names are read uncached from the candidate's own pool
+    int ValidateObjects(const IGameProfile *profile)
+    {
+        if (profile->GetNameByID(0) != "None")
+            return 0;
+
+        const UE_Offsets *offsets = profile->GetOffsets();
+
+        int score = 0;
+        int32_t count = std::min(UEWrappers::GetObjects()->GetNumElements(), kValidatedObjects);
+        for (int32_t i = 0; i < count; i++)
+        {
+            UE_UObject object = UEWrappers::GetObjects()->GetObjectPtr(i);
+            if (!object || object.GetIndex() != i)
+                continue;
+
+            int32_t nameIndex = vm_rpm_ptr<int32_t>(object.GetAddress() + offsets->UObject.NamePrivate + offsets->FName.ComparisonIndex);
+            std::string name = profile->GetNameByID(nameIndex);
+            bool plain = !name.empty() && std::all_of(name.begin(), name.end(), [](char c)
+            { return c == '_' || c == '/' || (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z'); });
+
+            if (plain)
+                score++;
+        }
+        return score;
+    }
+}  // namespace
+
+namespace UEProfileDetector
+{
+    Result Detect(const std::vector<IGameProfile *> &profiles)
+    {
+        TRACE_SCOPE("UEProfileDetector::Detect");
+
+        kPtrValidator.setPID(kMgr.processID());
+        kPtrValidator.setUseCache(true);
+        kPtrValidator.refreshRegionCache();
+
+        // profiles build their offsets into function statics on first use, some patching them after,
+        // that's done here one profile at a time so the concurrent probes only read them
+        for (IGameProfile *profile : profiles)
+            profile->GetOffsets();
+
+        std::vector<Result> probes(profiles.size());
+
+        TaskGroup probeTasks;
+        for (size_t i = 0; i < profiles.size(); i++)
+        {
+            probeTasks.run([&profiles, &probes, i]
+            {
+                probes[i].Profile = profiles[i];
+                probes[i].Score = profiles[i]->ProbeTarget(&probes[i].Pointers);
+            });
+        }
+        probeTasks.wait();
+
+        probes.erase(std::remove_if(probes.begin(), probes.end(), [](const Result &r)
+        { return r.Score < kMinProbeScore; }), probes.end());
+
+        std::stable_sort(probes.begin(), probes.end(), [](const Result &a, const Result &b)
+        { return a.Score > b.Score; });
+
+        if (probes.size() > kMaxValidated)
+            probes.resize(kMaxValidated);
+
+        // initializing sets the global UE state, so candidates are validated one at a time
+        Result best;
+        for (auto &probe : probes)
+        {
+            LOGI("Validating profile %s...", probe.Profile->GetAppName().c_str());
+            if (probe.Profile->InitUEVars(&probe.Pointers) != UEVarsInitStatus::SUCCESS)
+                continue;
+
+            int score = ValidateObjects(probe.Profile);
+            LOGI("%s: %d/%d objects names", probe.Profile->GetAppName().c_str(), score, kValidatedObjects);
+            if (score > best.Score)
+            {
+                best = probe;
+                best.Score = score;
+            }
+        }
+
+        if (best.Profile && best.Score < kValidatedObjects / 2)
+            best = Result();
+
+        return best;
+    }
+}  // namespace UEProfileDetector
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <vector>
+
+#include "UEGameProfile.hpp"
+
+// Picks a profile for a target whose package isn't known, or a renamed build.
+// All profiles are probed concurrently, the best ones are then initialized one by one
+// and checked by reading the first objects names.
+namespace UEProfileDetector
+{
+    struct Result
+    {
+        IGameProfile *Profile = nullptr;
+        // library relative Names & UObjectArray the profile resolved
+        UE_Pointers Pointers{};
+        int Score = 0;
+    };
+
+    // Profile is null if none fits, kMgr must be initialized
+    Result Detect(const std::vector<IGameProfile *> &profiles);
+}  // namespace UEProfileDetector
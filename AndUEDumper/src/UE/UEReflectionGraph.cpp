@@ -0,0 +1,1069 @@
+#include "UEReflectionGraph.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <queue>
+#include <set>
+#include <unordered_map>
+
+#include "UEMemory.hpp"
+using namespace UEMemory;
+
+namespace
+{
+    struct FieldSpan
+    {
+        uintptr_t Offset;
+        size_t Size;
+    };
+
+    size_t SpansEnd(const std::vector<FieldSpan> &fields)
+    {
+        size_t end = 0;
+        for (const auto &it : fields)
+            end = std::max(end, size_t(it.Offset + it.Size));
+        return end;
+    }
+
+    // for nodes whose whole block isn't readable
+    void ReadFieldsOneByOne(uint8_t *address, std::vector<uint8_t> &block, const std::vector<FieldSpan> &fields)
+    {
+        std::fill(block.begin(), block.end(), 0);
+        for (const auto &it : fields)
+            vm_rpm_ptr(address + it.Offset, block.data() + it.Offset, it.Size);
+    }
+
+    template <typename T>
+    T BlockGet(const std::vector<uint8_t> &block, uintptr_t offset)
+    {
+        T value{};
+        if (offset + sizeof(T) <= block.size())
+            memcpy(&value, block.data() + offset, sizeof(T));
+        return value;
+    }
+
+    std::string BlockGetName(const std::vector<uint8_t> &block, uintptr_t nameOffset)
+    {
+        auto offsets = UEWrappers::GetUEVars()->GetOffsets();
+        int32_t index = BlockGet<int32_t>(block, nameOffset + offsets->FName.ComparisonIndex);
+        int32_t number = offsets->Config.isUsingOutlineNumberName ? 0 : BlockGet<int32_t>(block, nameOffset + offsets->FName.Number);
+        return UE_FName::ResolveName(index, number);
+    }
+
+    // a position in a FField or UField chain of a struct or function
+    struct ChainCursor
+    {
+        uint32_t Owner = 0;
+        bool OwnerIsFunction = false;
+        bool IsFField = false;
+        uint8_t *Node = nullptr;
+    };
+
+    struct PendingFunction
+    {
+        UEReflectionGraph::Function Function;
+        std::vector<UEReflectionGraph::Property> FParams, UParams;
+    };
+
+    enum class EFieldKind : uint8_t
+    {
+        Function,
+        Property,
+        Other
+    };
+
+    // property class -> its type, the type string is kept when it's the same for every property of the class
+    struct PropertyClassInfo
+    {
+        UEPropertyType Type = UEPropertyType::Unknown;
+        bool ConstantTypeStr = false;
+        std::string TypeStr;
+    };
+
+    bool IsConstantTypeStr(UEPropertyType type)
+    {
+        switch (type)
+        {
+        case UEPropertyType::DoubleProperty:
+        case UEPropertyType::FloatProperty:
+        case UEPropertyType::IntProperty:
+        case UEPropertyType::Int8Property:
+        case UEPropertyType::Int16Property:
+        case UEPropertyType::Int32Property:
+        case UEPropertyType::Int64Property:
+        case UEPropertyType::UInt16Property:
+        case UEPropertyType::UInt32Property:
+        case UEPropertyType::UInt64Property:
+        case UEPropertyType::NameProperty:
+        case UEPropertyType::StrProperty:
+        case UEPropertyType::TextProperty:
+        case UEPropertyType::DelegateProperty:
+        case UEPropertyType::MulticastDelegateProperty:
+        case UEPropertyType::MulticastSparseDelegateProperty:
+        case UEPropertyType::Unknown:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // struct, class or enum a property points to
+    struct ValueRefInfo
+    {
+        std::string Name;
+        bool IsEnum = false;
+    };
+
+    // same naming as UE_UEnum::GetName
+    std::string EnumTypeName(const std::string &name)
+    {
+        if (!name.empty() && name[0] != 'E')
+            return "E" + name;
+        return name;
+    }
+
+    struct FPropertyFamily
+    {
+        using Property = UE_FProperty;
+        using StructProperty = UE_FStructProperty;
+        using ArrayProperty = UE_FArrayProperty;
+        using SetProperty = UE_FSetProperty;
+        using MapProperty = UE_FMapProperty;
+        using EnumProperty = UE_FEnumProperty;
+        using ByteProperty = UE_FByteProperty;
+    };
+
+    struct UPropertyFamily
+    {
+        using Property = UE_UProperty;
+        using StructProperty = UE_UStructProperty;
+        using ArrayProperty = UE_UArrayProperty;
+        using SetProperty = UE_USetProperty;
+        using MapProperty = UE_UMapProperty;
+        using EnumProperty = UE_UEnumProperty;
+        using ByteProperty = UE_UByteProperty;
+    };
+
+    // inner nodes are added before their parent, returns the node index
+    // refName is the name of the struct/enum the property points to when the caller has it already, empty for none
+    template <typename Family>
+    int32_t AcquireTypeNode(UEReflectionGraph &graph, const typename Family::Property &prop,
+                            const std::pair<UEPropertyType, std::string> &type, int depth,
+                            const std::string *refName = nullptr)
+    {
+        UEReflectionGraph::TypeNode node;
+        node.Kind = type.first;
+        // GetType reports strings as TextProperty
+        if (node.Kind == UEPropertyType::TextProperty && type.second == "struct FString")
+            node.Kind = UEPropertyType::StrProperty;
+
+        auto acquireInner = [&](const typename Family::Property &inner) -> int32_t
+        {
+            if (!inner || depth >= 8)
+                return -1;
+            return AcquireTypeNode<Family>(graph, inner, inner.GetType(), depth + 1);
+        };
+
+        auto setKnownName = [&](const std::string &name)
+        {
+            if (name.empty())
+                return;
+            node.HasName = true;
+            node.Name = graph.Intern(name);
+        };
+
+        auto setName = [&](const UE_UObject &object)
+        {
+            if (object)
+                setKnownName(object.GetName());
+        };
+
+        switch (node.Kind)
+        {
+        case UEPropertyType::StructProperty:
+            if (refName)
+                setKnownName(*refName);
+            else
+                setName(prop.template Cast<typename Family::StructProperty>().GetStruct());
+            break;
+        case UEPropertyType::EnumProperty:
+        {
+            auto enumProp = prop.template Cast<typename Family::EnumProperty>();
+            if (refName)
+                setKnownName(*refName);
+            else
+                setName(enumProp.GetEnum());
+            node.Inner = acquireInner(enumProp.GetUnderlayingProperty());
+            break;
+        }
+        case UEPropertyType::ByteProperty:
+            if (refName)
+                setKnownName(*refName);
+            else
+                setName(prop.template Cast<typename Family::ByteProperty>().GetEnum());
+            break;
+        case UEPropertyType::ArrayProperty:
+            node.Inner = acquireInner(prop.template Cast<typename Family::ArrayProperty>().GetInner());
+            break;
+        case UEPropertyType::SetProperty:
+            node.Inner = acquireInner(prop.template Cast<typename Family::SetProperty>().GetElementProp());
+            break;
+        case UEPropertyType::MapProperty:
+        {
+            auto mapProp = prop.template Cast<typename Family::MapProperty>();
+            node.Inner = acquireInner(mapProp.GetKeyProp());
+            node.Value = acquireInner(mapProp.GetValueProp());
+            break;
+        }
+        default:
+            break;
+        }
+
+        graph.TypeNodes.push_back(node);
+        return int32_t(graph.TypeNodes.size() - 1);
+    }
+
+    struct PendingStruct
+    {
+        std::vector<UEReflectionGraph::Property> FMembers, UMembers;
+        std::vector<uint32_t> Functions;
+    };
+}  // namespace
+
+UEReflectionGraph::NameID UEReflectionGraph::Intern(const std::string &str)
+{
+    auto it = _namesMap.find(str);
+    if (it != _namesMap.end())
+        return it->second;
+
+    NameID id = NameID(_names.size());
+    auto inserted = _namesMap.emplace(str, id).first;
+    _names.push_back(&inserted->first);
+    return id;
+}
+
+int32_t UEReflectionGraph::FindType(uint8_t *address) const
+{
+    auto it = _typesMap.find(address);
+    return it != _typesMap.end() ? it->second : -1;
+}
+
+UEReflectionGraph UEReflectionGraph::AcquirePackage(uint8_t *packageObj, const std::vector<int32_t> &objects, bool typeTrees)
+{
+    UEReflectionGraph graph;
+    auto offsets = UEWrappers::GetUEVars()->GetOffsets();
+
+    Package package;
+    package.Object = packageObj;
+    package.Name = graph.Intern(UE_UObject(packageObj).GetName());
+    package.FirstType = 0;
+
+    std::vector<PendingStruct> pendingStructs;
+    std::vector<PendingFunction> pendingFunctions;
+    std::vector<ChainCursor> frontier;
+
+    // type headers, chains heads are queued for the breadth-first walk
+    for (int32_t index : objects)
+    {
+        UE_UObject object = UEWrappers::GetObjects()->GetObjectPtr(index);
+        if (!object)
+            continue;
+
+        Type type;
+        type.Address = object.GetAddress();
+        type.ObjectIndex = index;
+
+        if (object.IsA<UE_UClass>() || object.IsA<UE_UScriptStruct>())
+        {
+            auto st = object.Cast<UE_UStruct>();
+            type.Kind = object.IsA<UE_UClass>() ? ETypeKind::Class : ETypeKind::Struct;
+            type.Name = graph.Intern(st.GetName());
+            type.FullName = graph.Intern(st.GetFullName());
+            type.CppName = graph.Intern(st.GetCppName());
+            type.Size = st.GetSize();
+
+            if (type.Size != 0)
+            {
+                auto super = st.GetSuper();
+                if (super)
+                {
+                    type.Super = super.GetAddress();
+                    type.SuperName = graph.Intern(super.GetName());
+                    type.SuperCppName = graph.Intern(super.GetCppName());
+                    type.Inherited = super.GetSize();
+                }
+
+                uint32_t owner = uint32_t(graph.Types.size());
+                if (auto head = st.GetChildProperties())
+                    frontier.push_back({owner, false, true, head.GetAddress()});
+                if (auto head = st.GetChildren())
+                    frontier.push_back({owner, false, false, head.GetAddress()});
+            }
+        }
+        else if (object.IsA<UE_UEnum>())
+        {
+            auto en = object.Cast<UE_UEnum>();
+            type.Kind = ETypeKind::Enum;
+            type.Name = graph.Intern(en.GetName());
+            type.FullName = graph.Intern(en.GetFullName());
+            type.CppName = type.Name;
+
+            uint64_t nameSize = GetPtrAlignedOf(offsets->FName.Size);
+            uint64_t pairSize = nameSize + sizeof(int64_t);
+
+            auto names = en.GetNames();
+            type.FirstEnumValue = uint32_t(graph.EnumValues.size());
+
+            if (names.Num() > 0)
+            {
+                // whole names array in one read
+                std::vector<uint8_t> pairs(names.Num() * pairSize, 0);
+                if (!vm_rpm_ptr(names.GetData(), pairs.data(), pairs.size()))
+                {
+                    for (int32_t i = 0; i < names.Num(); i++)
+                        vm_rpm_ptr(names.GetData() + i * pairSize, pairs.data() + i * pairSize, pairSize);
+                }
+
+                for (int32_t i = 0; i < names.Num(); i++)
+                {
+                    std::string str = BlockGetName(pairs, i * pairSize);
+                    auto pos = str.find_last_of(':');
+                    if (pos != std::string::npos)
+                        str = str.substr(pos + 1);
+
+                    graph.EnumValues.push_back({graph.Intern(str), BlockGet<uint64_t>(pairs, i * pairSize + nameSize)});
+                }
+            }
+
+            type.EnumValuesCount = uint32_t(graph.EnumValues.size()) - type.FirstEnumValue;
+        }
+        else
+        {
+            continue;
+        }
+
+        graph._typesMap.emplace(type.Address, int32_t(graph.Types.size()));
+        graph.Types.push_back(type);
+        pendingStructs.emplace_back();
+    }
+
+    auto ownerProps = [&](const ChainCursor &c) -> std::vector<Property> &
+    {
+        if (c.OwnerIsFunction)
+            return c.IsFField ? pendingFunctions[c.Owner].FParams : pendingFunctions[c.Owner].UParams;
+        return c.IsFField ? pendingStructs[c.Owner].FMembers : pendingStructs[c.Owner].UMembers;
+    };
+
+    // node fields of both chain kinds, fetched as one block per node
+    auto discovered = UEWrappers::GetDiscoveredOffsets();
+
+    std::vector<FieldSpan> fFieldSpans = {{offsets->FField.Next, sizeof(void *)},
+                                          {offsets->FField.ClassPrivate, sizeof(void *)},
+                                          {offsets->FField.NamePrivate, offsets->FName.Size},
+                                          {offsets->FProperty.ArrayDim, sizeof(int32_t)},
+                                          {offsets->FProperty.ElementSize, sizeof(int32_t)},
+                                          {offsets->FProperty.PropertyFlags, sizeof(uint64_t)},
+                                          {offsets->FProperty.Offset_Internal, sizeof(int32_t)},
+                                          {offsets->FProperty.Size + 3, sizeof(uint8_t)}};
+    // the struct/class/enum a property points to, right after the FProperty fields
+    if (discovered->FPropertySubBase)
+        fFieldSpans.push_back({discovered->FPropertySubBase, sizeof(void *)});
+    if (discovered->FEnumPropertyEnum)
+        fFieldSpans.push_back({discovered->FEnumPropertyEnum, sizeof(void *)});
+
+    const std::vector<FieldSpan> uFieldSpans = {{offsets->UField.Next, sizeof(void *)},
+                                                {offsets->UObject.ClassPrivate, sizeof(void *)},
+                                                {offsets->UObject.NamePrivate, offsets->FName.Size},
+                                                {offsets->UProperty.ArrayDim, sizeof(int32_t)},
+                                                {offsets->UProperty.ElementSize, sizeof(int32_t)},
+                                                {offsets->UProperty.PropertyFlags, sizeof(uint64_t)},
+                                                {offsets->UProperty.Offset_Internal, sizeof(int32_t)},
+                                                {offsets->UProperty.Size + 3, sizeof(uint8_t)},
+                                                {offsets->UProperty.Size, sizeof(void *)}};
+
+    // struct children chains may hold functions, their block covers the UFunction fields too
+    std::vector<FieldSpan> uChildSpans = uFieldSpans;
+    uChildSpans.push_back({offsets->UObject.OuterPrivate, sizeof(void *)});
+    uChildSpans.push_back({offsets->UFunction.EFunctionFlags, sizeof(uint32_t)});
+    uChildSpans.push_back({offsets->UFunction.NumParams, sizeof(int8_t)});
+    uChildSpans.push_back({offsets->UFunction.ParamSize, sizeof(int16_t)});
+    uChildSpans.push_back({offsets->UFunction.Func, sizeof(uintptr_t)});
+    if (offsets->UStruct.ChildProperties > 0)
+        uChildSpans.push_back({offsets->UStruct.ChildProperties, sizeof(void *)});
+    if (offsets->UStruct.Children > 0)
+        uChildSpans.push_back({offsets->UStruct.Children, sizeof(void *)});
+
+    auto cursorSpans = [&](const ChainCursor &c) -> const std::vector<FieldSpan> &
+    {
+        if (c.IsFField)
+            return fFieldSpans;
+        return c.OwnerIsFunction ? uFieldSpans : uChildSpans;
+    };
+
+    const size_t fFieldBlockSize = SpansEnd(fFieldSpans);
+    const size_t uFieldBlockSize = SpansEnd(uFieldSpans);
+    const size_t uChildBlockSize = SpansEnd(uChildSpans);
+
+    // UField class -> what kind of field it makes, classes are shared by many fields
+    std::unordered_map<uint8_t *, EFieldKind> fieldKinds;
+    auto getFieldKind = [&fieldKinds](uint8_t *fieldClass) -> EFieldKind
+    {
+        auto it = fieldKinds.find(fieldClass);
+        if (it != fieldKinds.end())
+            return it->second;
+
+        EFieldKind kind = EFieldKind::Other;
+        for (UE_UStruct c = UE_UStruct(fieldClass); c; c = c.GetSuper())
+        {
+            if (c.GetAddress() == UE_UFunction::StaticClass().GetAddress())
+            {
+                kind = EFieldKind::Function;
+                break;
+            }
+            if (c.GetAddress() == UE_UProperty::StaticClass().GetAddress())
+            {
+                kind = EFieldKind::Property;
+                break;
+            }
+        }
+
+        fieldKinds.emplace(fieldClass, kind);
+        return kind;
+    };
+
+    // function classes are a handful, their names are read once
+    std::unordered_map<uint8_t *, std::string> functionClassNames;
+    auto getFunctionClassName = [&functionClassNames](uint8_t *fnClass) -> const std::string &
+    {
+        auto it = functionClassNames.find(fnClass);
+        if (it == functionClassNames.end())
+            it = functionClassNames.emplace(fnClass, UE_UObject(fnClass).GetName()).first;
+        return it->second;
+    };
+
+    // property class -> its type, classifying is cached process wide so only
+    // the first property of each class is asked for its type here
+    std::unordered_map<uint8_t *, PropertyClassInfo> propClasses;
+    auto getPropertyClass = [&propClasses](const ChainCursor &c, uint8_t *fieldClass) -> const PropertyClassInfo &
+    {
+        auto it = propClasses.find(fieldClass);
+        if (it != propClasses.end())
+            return it->second;
+
+        auto type = c.IsFField ? UE_FProperty(c.Node).GetType(fieldClass) : UE_UProperty(c.Node).GetType(fieldClass);
+
+        PropertyClassInfo info;
+        info.Type = type.first;
+        info.ConstantTypeStr = IsConstantTypeStr(type.first);
+        if (info.ConstantTypeStr)
+            info.TypeStr = std::move(type.second);
+
+        return propClasses.emplace(fieldClass, std::move(info)).first->second;
+    };
+
+    auto isPropertyNode = [&getFieldKind](const ChainCursor &c, uint8_t *fieldClass) -> bool
+    {
+        return c.IsFField || c.OwnerIsFunction || getFieldKind(fieldClass) == EFieldKind::Property;
+    };
+
+    // class of a referenced object -> is it an enum, byte & enum properties may point at anything
+    std::unordered_map<uint8_t *, bool> enumClasses;
+    auto isEnumClass = [&enumClasses](uint8_t *objectClass) -> bool
+    {
+        auto it = enumClasses.find(objectClass);
+        if (it != enumClasses.end())
+            return it->second;
+
+        bool isEnum = false;
+        UE_UClass enumClass = UE_UEnum::StaticClass();
+        for (UE_UClass c = UE_UClass(objectClass); enumClass && c; c = c.GetSuper().Cast<UE_UClass>())
+        {
+            if (c == enumClass)
+            {
+                isEnum = true;
+                break;
+            }
+        }
+
+        enumClasses.emplace(objectClass, isEnum);
+        return isEnum;
+    };
+
+    const std::vector<FieldSpan> refSpans = {{offsets->UObject.ClassPrivate, sizeof(void *)},
+                                             {offsets->UObject.NamePrivate, offsets->FName.Size}};
+    const size_t refBlockSize = SpansEnd(refSpans);
+    std::unordered_map<uint8_t *, ValueRefInfo> valueRefs;
+    const std::string noRefName;
+
+    // value ref the property getters would return, byte & UProperty enum refs must be enums
+    auto resolveRef = [&valueRefs](const ChainCursor &c, UEPropertyType type, uint8_t *ref) -> uint8_t *
+    {
+        if (!ref)
+            return nullptr;
+
+        switch (type)
+        {
+        case UEPropertyType::StructProperty:
+        case UEPropertyType::ObjectProperty:
+            return ref;
+        case UEPropertyType::EnumProperty:
+            return (c.IsFField || valueRefs[ref].IsEnum) ? ref : nullptr;
+        case UEPropertyType::ByteProperty:
+            return valueRefs[ref].IsEnum ? ref : nullptr;
+        default:
+            return nullptr;
+        }
+    };
+
+    // same strings as the property GetType, built from the round's blocks and refs
+    auto getPropertyType = [&](const ChainCursor &c, uint8_t *fieldClass, uint8_t *ref, uint8_t fieldMask) -> UEPropTypeInfo
+    {
+        const PropertyClassInfo &info = getPropertyClass(c, fieldClass);
+        if (info.ConstantTypeStr)
+            return {info.Type, info.TypeStr};
+
+        switch (info.Type)
+        {
+        case UEPropertyType::StructProperty:
+            return {info.Type, "struct " + UE_UObject(ref).GetCppName()};
+        case UEPropertyType::ObjectProperty:
+            return {info.Type, "struct " + UE_UObject(ref).GetCppName() + "*"};
+        case UEPropertyType::ByteProperty:
+        {
+            uint8_t *en = resolveRef(c, info.Type, ref);
+            return {info.Type, en ? "enum class " + EnumTypeName(valueRefs[en].Name) : "uint8_t"};
+        }
+        case UEPropertyType::EnumProperty:
+            if (uint8_t *en = resolveRef(c, info.Type, ref))
+                return {info.Type, "enum class " + EnumTypeName(valueRefs[en].Name)};
+            break;
+        case UEPropertyType::BoolProperty:
+            return {info.Type, fieldMask == 0xFF ? "bool" : "uint8_t"};
+        default:
+            break;
+        }
+
+        // containers & the rest read their inner properties
+        return c.IsFField ? UE_FProperty(c.Node).GetType(fieldClass) : UE_UProperty(c.Node).GetType(fieldClass);
+    };
+
+    auto refNameOf = [&valueRefs, &noRefName](uint8_t *ref) -> const std::string *
+    {
+        return ref ? &valueRefs[ref].Name : &noRefName;
+    };
+
+    // all chains advance one node per round, every node of a round is fetched in one vectored read
+    // along with its next pointer, class and value ref. the objects the round points to are read
+    // in one more vectored read and property classes are resolved once, so a round costs two
+    // round trips no matter how many nodes it has. only inner properties of containers
+    // (arrays, sets, maps, ...) are still read one by one
+    std::vector<std::vector<uint8_t>> blocks;
+    std::vector<RemoteRead> reads;
+    std::vector<uint8_t *> nodeClasses, nodeRefs, newRefs;
+    std::vector<std::vector<uint8_t>> refBlocks;
+    std::vector<RemoteRead> refReads;
+    while (!frontier.empty())
+    {
+        blocks.resize(frontier.size());
+        reads.resize(frontier.size());
+        for (size_t i = 0; i < frontier.size(); i++)
+        {
+            const ChainCursor &c = frontier[i];
+            blocks[i].assign(c.IsFField ? fFieldBlockSize : (c.OwnerIsFunction ? uFieldBlockSize : uChildBlockSize), 0);
+            reads[i] = {frontier[i].Node, blocks[i].data(), blocks[i].size(), false};
+        }
+
+        vm_rpm_batch(reads);
+
+        // classes & value refs of the round, refs not seen yet are queued
+        nodeClasses.assign(frontier.size(), nullptr);
+        nodeRefs.assign(frontier.size(), nullptr);
+        newRefs.clear();
+        for (size_t i = 0; i < frontier.size(); i++)
+        {
+            const ChainCursor &cursor = frontier[i];
+            std::vector<uint8_t> &block = blocks[i];
+
+            if (!reads[i].ok)
+                ReadFieldsOneByOne(cursor.Node, block, cursorSpans(cursor));
+
+            nodeClasses[i] = BlockGet<uint8_t *>(block, cursor.IsFField ? offsets->FField.ClassPrivate : offsets->UObject.ClassPrivate);
+            if (!nodeClasses[i] || !isPropertyNode(cursor, nodeClasses[i]))
+                continue;
+
+            uintptr_t refOffset = 0;
+            switch (getPropertyClass(cursor, nodeClasses[i]).Type)
+            {
+            case UEPropertyType::StructProperty:
+            case UEPropertyType::ObjectProperty:
+            case UEPropertyType::ByteProperty:
+                refOffset = cursor.IsFField ? discovered->FPropertySubBase : offsets->UProperty.Size;
+                break;
+            case UEPropertyType::EnumProperty:
+                refOffset = cursor.IsFField ? discovered->FEnumPropertyEnum : offsets->UProperty.Size;
+                break;
+            default:
+                break;
+            }
+
+            if (refOffset)
+            {
+                nodeRefs[i] = BlockGet<uint8_t *>(block, refOffset);
+                if (nodeRefs[i] && valueRefs.emplace(nodeRefs[i], ValueRefInfo()).second)
+                    newRefs.push_back(nodeRefs[i]);
+            }
+        }
+
+        if (!newRefs.empty())
+        {
+            refBlocks.resize(newRefs.size());
+            refReads.resize(newRefs.size());
+            for (size_t i = 0; i < newRefs.size(); i++)
+            {
+                refBlocks[i].assign(refBlockSize, 0);
+                refReads[i] = {newRefs[i], refBlocks[i].data(), refBlocks[i].size(), false};
+            }
+
+            vm_rpm_batch(refReads);
+
+            for (size_t i = 0; i < newRefs.size(); i++)
+            {
+                if (!refReads[i].ok)
+                    ReadFieldsOneByOne(newRefs[i], refBlocks[i], refSpans);
+
+                ValueRefInfo &info = valueRefs[newRefs[i]];
+                info.Name = BlockGetName(refBlocks[i], offsets->UObject.NamePrivate);
+                uint8_t *refClass = BlockGet<uint8_t *>(refBlocks[i], offsets->UObject.ClassPrivate);
+                info.IsEnum = refClass && isEnumClass(refClass);
+            }
+        }
+
+        std::vector<ChainCursor> next;
+        next.reserve(frontier.size());
+
+        for (size_t i = 0; i < frontier.size(); i++)
+        {
+            const ChainCursor &cursor = frontier[i];
+            std::vector<uint8_t> &block = blocks[i];
+            uint8_t *nextNode = nullptr;
+
+            if (cursor.IsFField)
+            {
+                UE_FProperty prop(cursor.Node);
+                uint8_t fieldMask = BlockGet<uint8_t>(block, offsets->FProperty.Size + 3);
+                auto type = getPropertyType(cursor, nodeClasses[i], nodeRefs[i], fieldMask);
+
+                Property p;
+                p.Name = graph.Intern(BlockGetName(block, offsets->FField.NamePrivate));
+                p.Type = graph.Intern(type.second);
+                p.PropType = type.first;
+                p.ArrayDim = BlockGet<int32_t>(block, offsets->FProperty.ArrayDim);
+                p.ElementSize = BlockGet<int32_t>(block, offsets->FProperty.ElementSize);
+                p.Offset = BlockGet<int32_t>(block, offsets->FProperty.Offset_Internal);
+                p.Flags = BlockGet<uint64_t>(block, offsets->FProperty.PropertyFlags);
+                p.FieldMask = fieldMask;
+                p.ValueRef = resolveRef(cursor, p.PropType, nodeRefs[i]);
+
+                if (typeTrees)
+                    p.TypeTree = AcquireTypeNode<FPropertyFamily>(graph, prop, type, 0, refNameOf(p.ValueRef));
+
+                ownerProps(cursor).push_back(p);
+                nextNode = BlockGet<uint8_t *>(block, offsets->FField.Next);
+            }
+            else
+            {
+                EFieldKind kind = getFieldKind(nodeClasses[i]);
+
+                // function params chain holds properties only
+                if (!cursor.OwnerIsFunction && kind == EFieldKind::Function)
+                {
+                    std::string name = BlockGetName(block, offsets->UObject.NamePrivate);
+                    uint8_t *fnClass = BlockGet<uint8_t *>(block, offsets->UObject.ClassPrivate);
+                    uint8_t *fnOuter = BlockGet<uint8_t *>(block, offsets->UObject.OuterPrivate);
+
+                    PendingFunction pending;
+                    pending.Function.Name = graph.Intern(name);
+                    pending.Function.FullName = graph.Intern(getFunctionClassName(fnClass) + " " + UEWrappers::GetOuterPrefix(fnOuter) + name);
+                    pending.Function.EFlags = BlockGet<uint32_t>(block, offsets->UFunction.EFunctionFlags);
+                    pending.Function.NumParams = BlockGet<int8_t>(block, offsets->UFunction.NumParams);
+                    pending.Function.ParamSize = BlockGet<int16_t>(block, offsets->UFunction.ParamSize);
+                    pending.Function.Func = BlockGet<uintptr_t>(block, offsets->UFunction.Func);
+
+                    uint32_t owner = uint32_t(pendingFunctions.size());
+                    pendingFunctions.push_back(std::move(pending));
+                    pendingStructs[cursor.Owner].Functions.push_back(owner);
+
+                    uint8_t *fHead = offsets->UStruct.ChildProperties > 0 ? BlockGet<uint8_t *>(block, offsets->UStruct.ChildProperties) : nullptr;
+                    uint8_t *uHead = offsets->UStruct.Children > 0 ? BlockGet<uint8_t *>(block, offsets->UStruct.Children) : nullptr;
+                    if (fHead)
+                        next.push_back({owner, true, true, fHead});
+                    if (uHead)
+                        next.push_back({owner, true, false, uHead});
+                }
+                else if (cursor.OwnerIsFunction || kind == EFieldKind::Property)
+                {
+                    UE_UProperty prop(cursor.Node);
+                    uint8_t fieldMask = BlockGet<uint8_t>(block, offsets->UProperty.Size + 3);
+                    auto type = getPropertyType(cursor, nodeClasses[i], nodeRefs[i], fieldMask);
+
+                    Property p;
+                    p.Name = graph.Intern(BlockGetName(block, offsets->UObject.NamePrivate));
+                    p.Type = graph.Intern(type.second);
+                    p.PropType = type.first;
+                    p.ArrayDim = BlockGet<int32_t>(block, offsets->UProperty.ArrayDim);
+                    p.ElementSize = BlockGet<int32_t>(block, offsets->UProperty.ElementSize);
+                    p.Offset = BlockGet<int32_t>(block, offsets->UProperty.Offset_Internal);
+                    p.Flags = BlockGet<uint64_t>(block, offsets->UProperty.PropertyFlags);
+                    p.FieldMask = fieldMask;
+                    p.ValueRef = resolveRef(cursor, p.PropType, nodeRefs[i]);
+
+                    if (typeTrees)
+                        p.TypeTree = AcquireTypeNode<UPropertyFamily>(graph, prop, type, 0, refNameOf(p.ValueRef));
+
+                    ownerProps(cursor).push_back(p);
+                }
+
+                nextNode = BlockGet<uint8_t *>(block, offsets->UField.Next);
+            }
+
+            if (nextNode)
+            {
+                ChainCursor cursorNext = cursor;
+                cursorNext.Node = nextNode;
+                next.push_back(cursorNext);
+            }
+        }
+
+        frontier.swap(next);
+    }
+
+    // flatten, FField members/params come before UField ones like a chain by chain walk
+    for (size_t i = 0; i < graph.Types.size(); i++)
+    {
+        Type &type = graph.Types[i];
+        PendingStruct &pending = pendingStructs[i];
+
+        type.FirstMember = uint32_t(graph.Members.size());
+        graph.Members.insert(graph.Members.end(), pending.FMembers.begin(), pending.FMembers.end());
+        graph.Members.insert(graph.Members.end(), pending.UMembers.begin(), pending.UMembers.end());
+        type.MembersCount = uint32_t(graph.Members.size()) - type.FirstMember;
+
+        type.FirstFunction = uint32_t(graph.Functions.size());
+        for (uint32_t fnIndex : pending.Functions)
+        {
+            PendingFunction &fn = pendingFunctions[fnIndex];
+            fn.Function.FirstParam = uint32_t(graph.Params.size());
+            graph.Params.insert(graph.Params.end(), fn.FParams.begin(), fn.FParams.end());
+            graph.Params.insert(graph.Params.end(), fn.UParams.begin(), fn.UParams.end());
+            fn.Function.ParamsCount = uint32_t(graph.Params.size()) - fn.Function.FirstParam;
+            graph.Functions.push_back(fn.Function);
+        }
+        type.FunctionsCount = uint32_t(graph.Functions.size()) - type.FirstFunction;
+    }
+
+    package.TypesCount = uint32_t(graph.Types.size());
+    graph.Packages.push_back(package);
+
+    return graph;
+}
+
+void UEReflectionGraph::Append(UEReflectionGraph &&part)
+{
+    std::vector<NameID> names(part._names.size());
+    for (size_t i = 0; i < part._names.size(); i++)
+        names[i] = Intern(*part._names[i]);
+
+    const uint32_t typesBase = uint32_t(Types.size());
+    const uint32_t membersBase = uint32_t(Members.size());
+    const uint32_t functionsBase = uint32_t(Functions.size());
+    const uint32_t paramsBase = uint32_t(Params.size());
+    const uint32_t enumValuesBase = uint32_t(EnumValues.size());
+    const int32_t typeNodesBase = int32_t(TypeNodes.size());
+
+    auto remapProperty = [&names, typeNodesBase](Property &p)
+    {
+        p.Name = names[p.Name];
+        p.Type = names[p.Type];
+        if (p.TypeTree >= 0)
+            p.TypeTree += typeNodesBase;
+    };
+
+    for (auto &it : part.Packages)
+    {
+        it.Name = names[it.Name];
+        it.FirstType += typesBase;
+
+        if (!Packages.empty() && Packages.back().Object == it.Object &&
+            Packages.back().FirstType + Packages.back().TypesCount == it.FirstType)
+        {
+            Packages.back().TypesCount += it.TypesCount;
+            continue;
+        }
+        Packages.push_back(it);
+    }
+
+    for (auto &it : part.Types)
+    {
+        it.Name = names[it.Name];
+        it.FullName = names[it.FullName];
+        it.CppName = names[it.CppName];
+        it.SuperName = names[it.SuperName];
+        it.SuperCppName = names[it.SuperCppName];
+        it.FirstMember += membersBase;
+        it.FirstFunction += functionsBase;
+        it.FirstEnumValue += enumValuesBase;
+
+        _typesMap.emplace(it.Address, int32_t(Types.size()));
+        Types.push_back(it);
+    }
+
+    for (auto &it : part.Members)
+    {
+        remapProperty(it);
+        Members.push_back(it);
+    }
+
+    for (auto &it : part.Functions)
+    {
+        it.Name = names[it.Name];
+        it.FullName = names[it.FullName];
+        it.FirstParam += paramsBase;
+        Functions.push_back(it);
+    }
+
+    for (auto &it : part.Params)
+    {
+        remapProperty(it);
+        Params.push_back(it);
+    }
+
+    for (auto &it : part.EnumValues)
+    {
+        it.Name = names[it.Name];
+        EnumValues.push_back(it);
+    }
+
+    for (auto &it : part.TypeNodes)
+    {
+        if (it.HasName)
+            it.Name = names[it.Name];
+        if (it.Inner >= 0)
+            it.Inner += typeNodesBase;
+        if (it.Value >= 0)
+            it.Value += typeNodesBase;
+        TypeNodes.push_back(it);
+    }
+
+    part = UEReflectionGraph();
+}
+
+std::vector<uint32_t> UEReflectionGraph::GetTypesPackages() const
+{
+    std::vector<uint32_t> typePackage(Types.size(), 0);
+    for (uint32_t p = 0; p < uint32_t(Packages.size()); p++)
+    {
+        for (uint32_t t = 0; t < Packages[p].TypesCount; t++)
+            typePackage[Packages[p].FirstType + t] = p;
+    }
+    return typePackage;
+}
+
+std::vector<uint8_t *> UEReflectionGraph::GetValueReferences(uint32_t type) const
+{
+    std::vector<uint8_t *> refs;
+    const Type &t = Types[type];
+    if (t.Kind == ETypeKind::Enum)
+        return refs;
+
+    if (t.Super)
+        refs.push_back(t.Super);
+
+    for (uint32_t m = 0; m < t.MembersCount; m++)
+    {
+        const Property &prop = Members[t.FirstMember + m];
+        // object references are pointers, they don't need the definition
+        if (prop.ValueRef && (prop.PropType == UEPropertyType::StructProperty ||
+                              prop.PropType == UEPropertyType::EnumProperty ||
+                              prop.PropType == UEPropertyType::ByteProperty))
+        {
+            refs.push_back(prop.ValueRef);
+        }
+    }
+
+    return refs;
+}
+
+std::vector<std::vector<uint32_t>> UEReflectionGraph::GetTypesDependencies() const
+{
+    std::vector<std::vector<uint32_t>> dependencies(Types.size());
+    for (uint32_t t = 0; t < uint32_t(Types.size()); t++)
+    {
+        for (uint8_t *ref : GetValueReferences(t))
+        {
+            int32_t dep = FindType(ref);
+            if (dep >= 0 && uint32_t(dep) != t)
+                dependencies[t].push_back(uint32_t(dep));
+        }
+    }
+
+    return dependencies;
+}
+
+std::vector<std::vector<uint32_t>> UEReflectionGraph::GetPackagesDependencies() const
+{
+    std::vector<uint32_t> typePackage = GetTypesPackages();
+
+    std::vector<std::vector<uint32_t>> dependencies(Packages.size());
+    for (uint32_t p = 0; p < uint32_t(Packages.size()); p++)
+    {
+        auto &deps = dependencies[p];
+        auto addRef = [&](uint8_t *ref)
+        {
+            int32_t t = ref ? FindType(ref) : -1;
+            if (t >= 0 && typePackage[t] != p)
+                deps.push_back(typePackage[t]);
+        };
+
+        for (uint32_t t = 0; t < Packages[p].TypesCount; t++)
+        {
+            const Type &type = Types[Packages[p].FirstType + t];
+            if (type.Kind == ETypeKind::Enum)
+                continue;
+
+            addRef(type.Super);
+            for (uint32_t m = 0; m < type.MembersCount; m++)
+                addRef(Members[type.FirstMember + m].ValueRef);
+        }
+
+        std::sort(deps.begin(), deps.end());
+        deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+    }
+
+    return dependencies;
+}
+
+std::vector<uint32_t> UEReflectionGraph::TopologicalOrder(const std::vector<std::vector<uint32_t>> &dependencies)
+{
+    enum class EVisit : uint8_t
+    {
+        None,
+        Active,
+        Done
+    };
+
+    std::vector<uint32_t> order;
+    order.reserve(dependencies.size());
+    std::vector<EVisit> visit(dependencies.size(), EVisit::None);
+
+    // iterative post-order dfs, chains can be deep
+    std::vector<std::pair<uint32_t, size_t>> stack;
+    for (uint32_t root = 0; root < uint32_t(dependencies.size()); root++)
+    {
+        if (visit[root] != EVisit::None)
+            continue;
+
+        visit[root] = EVisit::Active;
+        stack.emplace_back(root, 0);
+
+        while (!stack.empty())
+        {
+            auto &top = stack.back();
+            const auto &deps = dependencies[top.first];
+
+            if (top.second < deps.size())
+            {
+                uint32_t dep = deps[top.second++];
+                // an active dependency is a cycle back edge
+                if (dep < visit.size() && visit[dep] == EVisit::None)
+                {
+                    visit[dep] = EVisit::Active;
+                    stack.emplace_back(dep, 0);
+                }
+                continue;
+            }
+
+            visit[top.first] = EVisit::Done;
+            order.push_back(top.first);
+            stack.pop_back();
+        }
+    }
+
+    return order;
+}
+
+std::vector<UEReflectionGraph::PackageRun> UEReflectionGraph::PackageRuns(const std::vector<std::vector<uint32_t>> &typesDependencies,
+                                                                          const std::vector<uint32_t> &typesPackages,
+                                                                          const std::vector<uint32_t> &packagesOrder)
+{
+    const uint32_t typesCount = uint32_t(typesDependencies.size());
+
+    // edges closing a cycle are dropped the same way as in the global order
+    const auto typesOrder = TopologicalOrder(typesDependencies);
+    std::vector<uint32_t> typesOrderPos(typesCount);
+    for (uint32_t i = 0; i < typesCount; i++)
+        typesOrderPos[typesOrder[i]] = i;
+
+    std::vector<uint32_t> packagesOrderPos(packagesOrder.size());
+    for (uint32_t i = 0; i < uint32_t(packagesOrder.size()); i++)
+        packagesOrderPos[packagesOrder[i]] = i;
+
+    std::vector<uint32_t> pendingDeps(typesCount, 0);
+    std::vector<std::vector<uint32_t>> dependents(typesCount);
+    for (uint32_t t = 0; t < typesCount; t++)
+    {
+        for (uint32_t dep : typesDependencies[t])
+        {
+            if (dep < typesCount && typesOrderPos[dep] < typesOrderPos[t])
+            {
+                pendingDeps[t]++;
+                dependents[dep].push_back(t);
+            }
+        }
+    }
+
+    // per package, its ready types by global order position. packages with ready types by packages order position
+    using ReadyQueue = std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>>;
+    std::vector<ReadyQueue> ready(packagesOrder.size());
+    std::set<uint32_t> readyPackages;
+
+    auto pushReady = [&](uint32_t t)
+    {
+        uint32_t pkg = typesPackages[t];
+        if (ready[pkg].empty())
+            readyPackages.insert(packagesOrderPos[pkg]);
+        ready[pkg].push(typesOrderPos[t]);
+    };
+
+    for (uint32_t t : typesOrder)
+    {
+        if (pendingDeps[t] == 0)
+            pushReady(t);
+    }
+
+    std::vector<PackageRun> runs;
+    uint32_t current = UINT32_MAX;
+    while (!readyPackages.empty())
+    {
+        if (current == UINT32_MAX || ready[current].empty())
+        {
+            current = packagesOrder[*readyPackages.begin()];
+            runs.push_back({current, {}});
+        }
+
+        uint32_t t = typesOrder[ready[current].top()];
+        ready[current].pop();
+        if (ready[current].empty())
+            readyPackages.erase(packagesOrderPos[current]);
+
+        runs.back().Types.push_back(t);
+
+        for (uint32_t dependent : dependents[t])
+        {
+            if (--pendingDeps[dependent] == 0)
+                pushReady(dependent);
+        }
+    }
+
+    return runs;
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "UEWrappers.hpp"
+
+// Flat, index based copy of the reflection data of the dumped packages.
+// It's read from the target once, everything generated after works on local data only.
+class UEReflectionGraph
+{
+public:
+    // index in the interned names
+    using NameID = uint32_t;
+
+    enum class ETypeKind : uint8_t
+    {
+        Class,
+        Struct,
+        Enum
+    };
+
+    struct Property
+    {
+        NameID Name = 0;
+        NameID Type = 0;  // C++ type
+        UEPropertyType PropType = UEPropertyType::Unknown;
+        int32_t ArrayDim = 0;
+        int32_t ElementSize = 0;
+        int32_t Offset = 0;
+        uint64_t Flags = 0;
+        uint8_t FieldMask = 0;
+        // struct or enum held by value, class of object references
+        uint8_t *ValueRef = nullptr;
+        // root in TypeNodes, -1 if type trees weren't acquired
+        int32_t TypeTree = -1;
+    };
+
+    // property type as a tree, containers point to their inner types
+    struct TypeNode
+    {
+        UEPropertyType Kind = UEPropertyType::Unknown;
+        // struct or enum object name
+        bool HasName = false;
+        NameID Name = 0;
+        // array, set & map key element, enum underlying property
+        int32_t Inner = -1;
+        // map value
+        int32_t Value = -1;
+    };
+
+    struct Function
+    {
+        NameID Name = 0;
+        NameID FullName = 0;
+        uint32_t EFlags = 0;
+        int8_t NumParams = 0;
+        int16_t ParamSize = 0;
+        uintptr_t Func = 0;
+        // range in Params
+        uint32_t FirstParam = 0;
+        uint32_t ParamsCount = 0;
+    };
+
+    struct EnumValue
+    {
+        NameID Name = 0;
+        uint64_t Value = 0;
+    };
+
+    struct Type
+    {
+        ETypeKind Kind = ETypeKind::Struct;
+        uint8_t *Address = nullptr;
+        int32_t ObjectIndex = -1;
+        NameID Name = 0;
+        NameID FullName = 0;
+        NameID CppName = 0;
+
+        // classes & structs
+        uint8_t *Super = nullptr;
+        NameID SuperName = 0;
+        NameID SuperCppName = 0;
+        uint32_t Size = 0;
+        uint32_t Inherited = 0;
+        uint32_t FirstMember = 0;
+        uint32_t MembersCount = 0;
+        uint32_t FirstFunction = 0;
+        uint32_t FunctionsCount = 0;
+
+        // enums
+        uint32_t FirstEnumValue = 0;
+        uint32_t EnumValuesCount = 0;
+    };
+
+    struct Package
+    {
+        uint8_t *Object = nullptr;
+        NameID Name = 0;
+        // range in Types, in GUObjectArray order
+        uint32_t FirstType = 0;
+        uint32_t TypesCount = 0;
+    };
+
+    std::vector<Package> Packages;
+    std::vector<Type> Types;
+    std::vector<Property> Members;
+    std::vector<Function> Functions;
+    std::vector<Property> Params;
+    std::vector<EnumValue> EnumValues;
+    std::vector<TypeNode> TypeNodes;
+
+    UEReflectionGraph() = default;
+    UEReflectionGraph(const UEReflectionGraph &) = delete;
+    UEReflectionGraph &operator=(const UEReflectionGraph &) = delete;
+    UEReflectionGraph(UEReflectionGraph &&) = default;
+    UEReflectionGraph &operator=(UEReflectionGraph &&) = default;
+
+    inline const std::string &GetName(NameID id) const { return *_names[id]; }
+    inline size_t GetNamesCount() const { return _names.size(); }
+
+    NameID Intern(const std::string &str);
+
+    // type index of an object address, -1 if it's not in the graph
+    int32_t FindType(uint8_t *address) const;
+
+    // Read a package's structs, classes & enums, safe to call concurrently.
+    // typeTrees also reads the inner types of container, struct & enum properties
+    static UEReflectionGraph AcquirePackage(uint8_t *packageObj, const std::vector<int32_t> &objects, bool typeTrees = false);
+
+    // Move a package graph into this one, names and indices are remapped.
+    // A part of the package appended last extends it
+    void Append(UEReflectionGraph &&part);
+
+    // Package index of each type
+    std::vector<uint32_t> GetTypesPackages() const;
+
+    // Objects a type needs the definition of: super, by value structs and enums, in the graph or not
+    std::vector<uint8_t *> GetValueReferences(uint32_t type) const;
+
+    // Per type, the types that must be defined before it: super, by value structs and enums
+    std::vector<std::vector<uint32_t>> GetTypesDependencies() const;
+
+    // Per package, the other packages its types inherit from or reference by struct, enum or object properties
+    std::vector<std::vector<uint32_t>> GetPackagesDependencies() const;
+
+    // Nodes ordered so that dependencies come first, edges closing a cycle are ignored.
+    // Independent nodes keep their index order
+    static std::vector<uint32_t> TopologicalOrder(const std::vector<std::vector<uint32_t>> &dependencies);
+
+    struct PackageRun
+    {
+        uint32_t Package = 0;
+        std::vector<uint32_t> Types;
+    };
+
+    // Types in dependency order across packages, in runs of one package each. A run goes on while its package
+    // has types ready, the next run is the first package in packagesOrder with types ready. So a package is
+    // only split when its types need types of a package depending on it. Packages without types have no run
+    static std::vector<PackageRun> PackageRuns(const std::vector<std::vector<uint32_t>> &typesDependencies,
+                                               const std::vector<uint32_t> &typesPackages,
+                                               const std::vector<uint32_t> &packagesOrder);
+
+private:
+    std::unordered_map<std::string, NameID> _namesMap;
+    // points to the keys of _namesMap
+    std::vector<const std::string *> _names;
+
+    std::unordered_map<uint8_t *, int32_t> _typesMap;
+};
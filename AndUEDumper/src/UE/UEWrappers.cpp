@@ -1,6 +1,12 @@
 #include "UEWrappers.hpp"
 using namespace UEMemory;
 
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
 #include <hash/hash.h>
 
 #include "UEGameProfile.hpp"
@@ -12,6 +18,34 @@ namespace UEWrappers
     UEVars const *GUVars = nullptr;
     std::unique_ptr<UE_UObjectArray> pObjectsArray = nullptr;
 
+    // outer object -> "Package.Outer.Outer." prefix and its outermost package
+    struct OuterPath
+    {
+        std::string Prefix;
+        uint8_t *Package = nullptr;
+    };
+    std::unordered_map<uint8_t *, OuterPath> outerPathCache;
+    std::shared_mutex outerPathMtx;
+
+    // property class (UClass or FFieldClass) -> its property type,
+    // name is only kept for unknown types which are printed with it
+    struct PropertyClassType
+    {
+        UEPropertyType Type = UEPropertyType::Unknown;
+        std::string Name;
+    };
+    std::unordered_map<uint8_t *, PropertyClassType> propClassTypeCache;
+    std::shared_mutex propClassTypeMtx;
+
+    // struct address -> its C++ name, it's looked up for every property referencing it
+    std::unordered_map<uint8_t *, std::string> cppNameCache;
+    std::shared_mutex cppNameMtx;
+
+    // probed once per target on first use, readers only see it after it's published
+    UE_DiscoveredOffsets discoveredOffsets{};
+    std::atomic<bool> discoveredOffsetsReady{false};
+    std::mutex discoveredOffsetsMtx;
+
     void Init(const UEVars *vars)
     {
         if (vars)
@@ -22,7 +56,83 @@ namespace UEWrappers
                 pObjectsArray.reset();
             }
             pObjectsArray = std::make_unique<UE_UObjectArray>(vars->GetObjObjects_Objects());
+
+            {
+                std::unique_lock<std::shared_mutex> lock(outerPathMtx);
+                outerPathCache.clear();
+            }
+            {
+                std::unique_lock<std::shared_mutex> lock(propClassTypeMtx);
+                propClassTypeCache.clear();
+            }
+            {
+                std::unique_lock<std::shared_mutex> lock(cppNameMtx);
+                cppNameCache.clear();
+            }
+            {
+                std::lock_guard<std::mutex> lock(discoveredOffsetsMtx);
+                discoveredOffsets = UE_DiscoveredOffsets();
+                discoveredOffsetsReady = false;
+            }
+        }
+    }
+
+    const PropertyClassType &GetPropertyClassType(uint8_t *propClass, const std::function<PropertyClassType(uint8_t *)> &classify)
+    {
+        {
+            std::shared_lock<std::shared_mutex> lock(propClassTypeMtx);
+            auto it = propClassTypeCache.find(propClass);
+            if (it != propClassTypeCache.end())
+                return it->second;
+        }
+
+        PropertyClassType classType = classify(propClass);
+
+        std::unique_lock<std::shared_mutex> lock(propClassTypeMtx);
+        return propClassTypeCache.emplace(propClass, std::move(classType)).first->second;
+    }
+
+    // outer chains deeper than the cap are broken or looping, they get no prefix & no package and aren't cached
+    const OuterPath kBrokenOuterPath{};
+
+    // entries are never erased while dumping, so returned pointers stay valid
+    const OuterPath *GetOuterPath(const UE_UObject &outer, int depth = 0)
+    {
+        {
+            std::shared_lock<std::shared_mutex> lock(outerPathMtx);
+            auto it = outerPathCache.find(outer.GetAddress());
+            if (it != outerPathCache.end())
+                return &it->second;
         }
+
+        if (depth >= 64)
+            return &kBrokenOuterPath;
+
+        OuterPath path;
+        auto parent = outer.GetOuter();
+        if (parent)
+        {
+            const OuterPath *parentPath = GetOuterPath(parent, depth + 1);
+            if (parentPath == &kBrokenOuterPath)
+                return parentPath;
+
+            path.Prefix = parentPath->Prefix;
+            path.Package = parentPath->Package;
+        }
+        else
+        {
+            path.Package = outer.GetAddress();
+        }
+        path.Prefix += outer.GetName();
+        path.Prefix += '.';
+
+        std::unique_lock<std::shared_mutex> lock(outerPathMtx);
+        return &outerPathCache.emplace(outer.GetAddress(), std::move(path)).first->second;
+    }
+
+    std::string GetOuterPrefix(uint8_t *outer)
+    {
+        return outer ? GetOuterPath(UE_UObject(outer))->Prefix : "";
     }
 
     UEVars const *GetUEVars() { return GUVars; }
@@ -30,6 +140,138 @@ namespace UEWrappers
     UE_Offsets *GetOffsets() { return GUVars ? GUVars->GetOffsets() : nullptr; }
     std::string GetNameByID(int32_t id) { return GUVars ? GUVars->GetNameByID(id) : ""; }
     UE_UObjectArray *GetObjects() { return pObjectsArray.get(); }
+
+    // offset with most votes, 0 if nothing was voted
+    uintptr_t MajorityVote(const std::unordered_map<uintptr_t, int> &votes)
+    {
+        uintptr_t offset = 0;
+        int count = 0;
+        for (const auto &it : votes)
+        {
+            if (it.second > count || (it.second == count && it.first < offset))
+            {
+                offset = it.first;
+                count = it.second;
+            }
+        }
+        return offset;
+    }
+
+    UE_DiscoveredOffsets ProbeDiscoveredOffsets()
+    {
+        const int kSamplesPerOffset = 16;
+        const int32_t kMaxScannedObjects = 0x20000;
+
+        UE_DiscoveredOffsets result{};
+
+        UE_Offsets *offsets = GetOffsets();
+        if (!offsets || !pObjectsArray || offsets->UStruct.ChildProperties <= 0)
+            return result;
+
+        const uintptr_t propSize = offsets->FProperty.Size;
+        const uintptr_t ptrSize = sizeof(void *);
+
+        std::unordered_map<uintptr_t, int> subBaseVotes, underlyingVotes, enumVotes;
+        int subBaseSamples = 0, enumSamples = 0;
+
+        // each sampled property votes for the first candidate that holds what its type expects
+        auto vote = [](std::unordered_map<uintptr_t, int> &votes, std::initializer_list<uintptr_t> candidates, const std::function<bool(uintptr_t)> &check)
+        {
+            for (uintptr_t candidate : candidates)
+            {
+                if (check(candidate))
+                {
+                    votes[candidate]++;
+                    return;
+                }
+            }
+        };
+
+        int32_t objectsCount = std::min(pObjectsArray->GetNumElements(), kMaxScannedObjects);
+        for (int32_t i = 0; i < objectsCount && (subBaseSamples < kSamplesPerOffset || enumSamples < kSamplesPerOffset); i++)
+        {
+            UE_UObject object = pObjectsArray->GetObjectPtr(i);
+            if (!object || !object.IsA<UE_UStruct>())
+                continue;
+
+            for (auto field = object.Cast<UE_UStruct>().GetChildProperties(); field; field = field.GetNext())
+            {
+                uint8_t *prop = field.GetAddress();
+                std::string className = field.GetClass().GetName();
+
+                if (className == "StructProperty" && subBaseSamples < kSamplesPerOffset)
+                {
+                    subBaseSamples++;
+                    vote(subBaseVotes, {propSize, propSize + ptrSize}, [prop](uintptr_t off)
+                    {
+                        auto st = vm_rpm_ptr<UE_UObject>(prop + off);
+                        return st && st.IsA<UE_UScriptStruct>();
+                    });
+                }
+                else if (className == "ObjectProperty" && subBaseSamples < kSamplesPerOffset)
+                {
+                    subBaseSamples++;
+                    vote(subBaseVotes, {propSize, propSize + ptrSize}, [prop](uintptr_t off)
+                    {
+                        auto cls = vm_rpm_ptr<UE_UObject>(prop + off);
+                        return cls && cls.IsA<UE_UClass>();
+                    });
+                }
+                else if (className == "ArrayProperty" && subBaseSamples < kSamplesPerOffset)
+                {
+                    subBaseSamples++;
+                    vote(subBaseVotes, {propSize, propSize + ptrSize}, [prop](uintptr_t off)
+                    {
+                        auto inner = vm_rpm_ptr<UE_FField>(prop + off);
+                        if (!inner || !inner.GetClass()) return false;
+                        std::string innerClassName = inner.GetClass().GetName();
+                        return innerClassName.size() > 8 && innerClassName.compare(innerClassName.size() - 8, 8, "Property") == 0;
+                    });
+                }
+                else if (className == "EnumProperty" && enumSamples < kSamplesPerOffset)
+                {
+                    enumSamples++;
+                    vote(underlyingVotes, {propSize, propSize - ptrSize, propSize + ptrSize}, [prop](uintptr_t off)
+                    {
+                        auto underlying = vm_rpm_ptr<UE_FField>(prop + off);
+                        return underlying && underlying.GetName() == "UnderlyingType";
+                    });
+                    vote(enumVotes, {propSize + ptrSize, propSize, propSize + (ptrSize * 2)}, [prop](uintptr_t off)
+                    {
+                        auto e = vm_rpm_ptr<UE_UObject>(prop + off);
+                        return e && e.IsA<UE_UEnum>();
+                    });
+                }
+            }
+        }
+
+        result.FPropertySubBase = MajorityVote(subBaseVotes);
+        result.FEnumPropertyUnderlyingProp = MajorityVote(underlyingVotes);
+        result.FEnumPropertyEnum = MajorityVote(enumVotes);
+
+        return result;
+    }
+
+    const UE_DiscoveredOffsets *GetDiscoveredOffsets()
+    {
+        if (!discoveredOffsetsReady.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(discoveredOffsetsMtx);
+            if (!discoveredOffsetsReady.load(std::memory_order_relaxed))
+            {
+                discoveredOffsets = ProbeDiscoveredOffsets();
+                discoveredOffsetsReady.store(true, std::memory_order_release);
+            }
+        }
+        return &discoveredOffsets;
+    }
+
+    void SetDiscoveredOffsets(const UE_DiscoveredOffsets &offsets)
+    {
+        std::lock_guard<std::mutex> lock(discoveredOffsetsMtx);
+        discoveredOffsets = offsets;
+        discoveredOffsetsReady.store(true, std::memory_order_release);
+    }
 }  // namespace UEWrappers
 
 std::string FString::ToString() const
@@ -129,15 +371,21 @@ std::string UE_FName::GetName() const
     //   nameID_offset = UEWrappers::GetOffsets()->FName.DisplayIndex;
 
     int32_t index = 0;
-    if (!vm_rpm_ptr(object + nameID_offset, &index, sizeof(int32_t)) || index < 0)
+    if (!vm_rpm_ptr(object + nameID_offset, &index, sizeof(int32_t)))
         return "None";
 
-    std::string name = UEWrappers::GetNameByID(index);
+    return ResolveName(index, GetNumber());
+}
+
+std::string UE_FName::ResolveName(int32_t comparisonIndex, int32_t number)
+{
+    if (comparisonIndex < 0) return "None";
+
+    std::string name = UEWrappers::GetNameByID(comparisonIndex);
     if (name.empty()) return "None";
 
     if (!UEWrappers::GetOffsets()->Config.isUsingOutlineNumberName)
     {
-        int32_t number = GetNumber();
         if (number > 0)
         {
             name += '_' + std::to_string(number - 1);
@@ -185,12 +433,10 @@ UE_UObject UE_UObject::GetPackageObject() const
 {
     if (!object) return nullptr;
 
-    UE_UObject package(nullptr);
-    for (auto outer = GetOuter(); outer; outer = outer.GetOuter())
-    {
-        package = outer;
-    }
-    return package;
+    auto outer = GetOuter();
+    if (!outer) return nullptr;
+
+    return UEWrappers::GetOuterPath(outer)->Package;
 }
 
 std::string UE_UObject::GetName() const
@@ -205,13 +451,16 @@ std::string UE_UObject::GetFullName() const
 {
     if (!object) return "";
 
-    std::string temp;
-    for (auto outer = GetOuter(); outer; outer = outer.GetOuter())
+    UE_UClass objectClass = GetClass();
+    std::string name = objectClass.GetName() + " ";
+
+    auto outer = GetOuter();
+    if (outer)
     {
-        temp = outer.GetName() + "." + temp;
+        name += UEWrappers::GetOuterPath(outer)->Prefix;
     }
-    UE_UClass objectClass = GetClass();
-    std::string name = objectClass.GetName() + " " + temp + GetName();
+
+    name += GetName();
     return name;
 }
 
@@ -219,6 +468,13 @@ std::string UE_UObject::GetCppName() const
 {
     if (!object) return "";
 
+    {
+        std::shared_lock<std::shared_mutex> lock(UEWrappers::cppNameMtx);
+        auto it = UEWrappers::cppNameCache.find(object);
+        if (it != UEWrappers::cppNameCache.end())
+            return it->second;
+    }
+
     std::string name;
     if (IsA<UE_UClass>())
     {
@@ -247,6 +503,9 @@ std::string UE_UObject::GetCppName() const
     }
 
     name += GetName();
+
+    std::unique_lock<std::shared_mutex> lock(UEWrappers::cppNameMtx);
+    UEWrappers::cppNameCache.emplace(object, name);
     return name;
 }
 
@@ -359,115 +618,112 @@ uint64_t UE_UProperty::GetPropertyFlags() const
 
 std::pair<UEPropertyType, std::string> UE_UProperty::GetType() const
 {
-    if (IsA<UE_UDoubleProperty>())
-    {
+    return GetType(GetClass());
+}
+
+std::pair<UEPropertyType, std::string> UE_UProperty::GetType(uint8_t *fieldClass) const
+{
+    const auto &classType = UEWrappers::GetPropertyClassType(fieldClass, [](uint8_t *propClass)
+    {
+        // super chain is read once per property class, then checked in the order of most derived first
+        std::vector<uint8_t *> supers;
+        for (auto super = UE_UClass(propClass); super; super = super.GetSuper().Cast<UE_UClass>())
+            supers.push_back(super);
+
+        auto isA = [&supers](UE_UClass cmp) -> bool
+        { return cmp && std::find(supers.begin(), supers.end(), cmp.GetAddress()) != supers.end(); };
+
+        UEWrappers::PropertyClassType classType{};
+        if (isA(UE_UDoubleProperty::StaticClass())) classType.Type = UEPropertyType::DoubleProperty;
+        else if (isA(UE_UFloatProperty::StaticClass())) classType.Type = UEPropertyType::FloatProperty;
+        else if (isA(UE_UIntProperty::StaticClass())) classType.Type = UEPropertyType::IntProperty;
+        else if (isA(UE_UInt16Property::StaticClass())) classType.Type = UEPropertyType::Int16Property;
+        else if (isA(UE_UInt32Property::StaticClass())) classType.Type = UEPropertyType::Int32Property;
+        else if (isA(UE_UInt64Property::StaticClass())) classType.Type = UEPropertyType::Int64Property;
+        else if (isA(UE_UInt8Property::StaticClass())) classType.Type = UEPropertyType::Int8Property;
+        else if (isA(UE_UUInt16Property::StaticClass())) classType.Type = UEPropertyType::UInt16Property;
+        else if (isA(UE_UUInt32Property::StaticClass())) classType.Type = UEPropertyType::UInt32Property;
+        else if (isA(UE_UUInt64Property::StaticClass())) classType.Type = UEPropertyType::UInt64Property;
+        else if (isA(UE_UTextProperty::StaticClass())) classType.Type = UEPropertyType::TextProperty;
+        else if (isA(UE_UStrProperty::StaticClass())) classType.Type = UEPropertyType::StrProperty;
+        else if (isA(UE_UClassProperty::StaticClass())) classType.Type = UEPropertyType::ClassProperty;
+        else if (isA(UE_UStructProperty::StaticClass())) classType.Type = UEPropertyType::StructProperty;
+        else if (isA(UE_UNameProperty::StaticClass())) classType.Type = UEPropertyType::NameProperty;
+        else if (isA(UE_UBoolProperty::StaticClass())) classType.Type = UEPropertyType::BoolProperty;
+        else if (isA(UE_UByteProperty::StaticClass())) classType.Type = UEPropertyType::ByteProperty;
+        else if (isA(UE_UArrayProperty::StaticClass())) classType.Type = UEPropertyType::ArrayProperty;
+        else if (isA(UE_UEnumProperty::StaticClass())) classType.Type = UEPropertyType::EnumProperty;
+        else if (isA(UE_USetProperty::StaticClass())) classType.Type = UEPropertyType::SetProperty;
+        else if (isA(UE_UMapProperty::StaticClass())) classType.Type = UEPropertyType::MapProperty;
+        else if (isA(UE_UInterfaceProperty::StaticClass())) classType.Type = UEPropertyType::InterfaceProperty;
+        else if (isA(UE_UMulticastDelegateProperty::StaticClass())) classType.Type = UEPropertyType::MulticastDelegateProperty;
+        else if (isA(UE_UWeakObjectProperty::StaticClass())) classType.Type = UEPropertyType::WeakObjectProperty;
+        else if (isA(UE_ULazyObjectProperty::StaticClass())) classType.Type = UEPropertyType::LazyObjectProperty;
+        else if (isA(UE_UObjectProperty::StaticClass()) || isA(UE_UObjectPropertyBase::StaticClass())) classType.Type = UEPropertyType::ObjectProperty;
+        else classType.Name = UE_UClass(propClass).GetName();
+
+        return classType;
+    });
+
+    switch (classType.Type)
+    {
+    case UEPropertyType::DoubleProperty:
         return {UEPropertyType::DoubleProperty, Cast<UE_UDoubleProperty>().GetTypeStr()};
-    }
-    if (IsA<UE_UFloatProperty>())
-    {
+    case UEPropertyType::FloatProperty:
         return {UEPropertyType::FloatProperty, Cast<UE_UFloatProperty>().GetTypeStr()};
-    }
-    if (IsA<UE_UIntProperty>())
-    {
+    case UEPropertyType::IntProperty:
         return {UEPropertyType::IntProperty, Cast<UE_UIntProperty>().GetTypeStr()};
-    }
-    if (IsA<UE_UInt16Property>())
-    {
+    case UEPropertyType::Int16Property:
         return {UEPropertyType::Int16Property, Cast<UE_UInt16Property>().GetTypeStr()};
-    }
-    if (IsA<UE_UInt32Property>())
-    {
+    case UEPropertyType::Int32Property:
         return {UEPropertyType::Int32Property, Cast<UE_UInt32Property>().GetTypeStr()};
-    }
-    if (IsA<UE_UInt64Property>())
-    {
+    case UEPropertyType::Int64Property:
         return {UEPropertyType::Int64Property, Cast<UE_UInt64Property>().GetTypeStr()};
-    }
-    if (IsA<UE_UInt8Property>())
-    {
+    case UEPropertyType::Int8Property:
         return {UEPropertyType::Int8Property, Cast<UE_UInt8Property>().GetTypeStr()};
-    }
-    if (IsA<UE_UUInt16Property>())
-    {
+    case UEPropertyType::UInt16Property:
         return {UEPropertyType::UInt16Property, Cast<UE_UUInt16Property>().GetTypeStr()};
-    }
-    if (IsA<UE_UUInt32Property>())
-    {
+    case UEPropertyType::UInt32Property:
         return {UEPropertyType::UInt32Property, Cast<UE_UUInt32Property>().GetTypeStr()};
-    }
-    if (IsA<UE_UUInt64Property>())
-    {
+    case UEPropertyType::UInt64Property:
         return {UEPropertyType::UInt64Property, Cast<UE_UUInt64Property>().GetTypeStr()};
-    }
-    if (IsA<UE_UTextProperty>())
-    {
+    case UEPropertyType::TextProperty:
         return {UEPropertyType::TextProperty, Cast<UE_UTextProperty>().GetTypeStr()};
-    }
-    if (IsA<UE_UStrProperty>())
-    {
+    case UEPropertyType::StrProperty:
         return {UEPropertyType::TextProperty, Cast<UE_UStrProperty>().GetTypeStr()};
-    }
-    if (IsA<UE_UClassProperty>())
-    {
+    case UEPropertyType::ClassProperty:
         return {UEPropertyType::ClassProperty, Cast<UE_UClassProperty>().GetTypeStr()};
-    }
-    if (IsA<UE_UStructProperty>())
-    {
+    case UEPropertyType::StructProperty:
         return {UEPropertyType::StructProperty, Cast<UE_UStructProperty>().GetTypeStr()};
-    }
-    if (IsA<UE_UNameProperty>())
-    {
+    case UEPropertyType::NameProperty:
         return {UEPropertyType::NameProperty, Cast<UE_UNameProperty>().GetTypeStr()};
-    }
-    if (IsA<UE_UBoolProperty>())
-    {
+    case UEPropertyType::BoolProperty:
         return {UEPropertyType::BoolProperty, Cast<UE_UBoolProperty>().GetTypeStr()};
-    }
-    if (IsA<UE_UByteProperty>())
-    {
+    case UEPropertyType::ByteProperty:
         return {UEPropertyType::ByteProperty, Cast<UE_UByteProperty>().GetTypeStr()};
-    }
-    if (IsA<UE_UArrayProperty>())
-    {
+    case UEPropertyType::ArrayProperty:
         return {UEPropertyType::ArrayProperty, Cast<UE_UArrayProperty>().GetTypeStr()};
-    }
-    if (IsA<UE_UEnumProperty>())
-    {
+    case UEPropertyType::EnumProperty:
         return {UEPropertyType::EnumProperty, Cast<UE_UEnumProperty>().GetTypeStr()};
-    }
-    if (IsA<UE_USetProperty>())
-    {
+    case UEPropertyType::SetProperty:
         return {UEPropertyType::SetProperty, Cast<UE_USetProperty>().GetTypeStr()};
-    }
-    if (IsA<UE_UMapProperty>())
-    {
+    case UEPropertyType::MapProperty:
         return {UEPropertyType::MapProperty, Cast<UE_UMapProperty>().GetTypeStr()};
-    }
-    if (IsA<UE_UInterfaceProperty>())
-    {
+    case UEPropertyType::InterfaceProperty:
         return {UEPropertyType::InterfaceProperty, Cast<UE_UInterfaceProperty>().GetTypeStr()};
-    }
-    if (IsA<UE_UMulticastDelegateProperty>())
-    {
+    case UEPropertyType::MulticastDelegateProperty:
         return {UEPropertyType::MulticastDelegateProperty, Cast<UE_UMulticastDelegateProperty>().GetTypeStr()};
-    }
-    if (IsA<UE_UWeakObjectProperty>())
-    {
+    case UEPropertyType::WeakObjectProperty:
         return {UEPropertyType::WeakObjectProperty, Cast<UE_UWeakObjectProperty>().GetTypeStr()};
-    }
-    if (IsA<UE_ULazyObjectProperty>())
-    {
+    case UEPropertyType::LazyObjectProperty:
         return {UEPropertyType::LazyObjectProperty, Cast<UE_ULazyObjectProperty>().GetTypeStr()};
-    }
-    if (IsA<UE_UObjectProperty>())
-    {
-        return {UEPropertyType::ObjectProperty, Cast<UE_UObjectProperty>().GetTypeStr()};
-    }
-    if (IsA<UE_UObjectPropertyBase>())
-    {
+    case UEPropertyType::ObjectProperty:
         return {UEPropertyType::ObjectProperty, Cast<UE_UObjectPropertyBase>().GetTypeStr()};
+    default:
+        break;
     }
-    return {UEPropertyType::Unknown, GetClass().GetName()};
+
+    return {UEPropertyType::Unknown, classType.Name};
 }
 
 IUProperty UE_UProperty::GetInterface() const { return IUProperty(this); }
@@ -554,7 +810,11 @@ uint32_t UE_UFunction::GetFunctionEFlags() const
 
 std::string UE_UFunction::GetFunctionFlags() const
 {
-    auto flags = GetFunctionEFlags();
+    return FunctionFlagsToString(GetFunctionEFlags());
+}
+
+std::string UE_UFunction::FunctionFlagsToString(uint32_t flags)
+{
     std::string result;
     if (flags == FUNC_None)
     {
@@ -1159,188 +1419,301 @@ uint64_t UE_FProperty::GetPropertyFlags() const
 
 UEPropTypeInfo UE_FProperty::GetType() const
 {
-    auto objectClass = GetClass();
-    UEPropTypeInfo type = {UEPropertyType::Unknown, objectClass.GetName()};
+    return GetType(GetClass());
+}
+
+UEPropTypeInfo UE_FProperty::GetType(uint8_t *fieldClass) const
+{
+    const auto &classType = UEWrappers::GetPropertyClassType(fieldClass, [](uint8_t *propClass)
+    {
+        UEWrappers::PropertyClassType classType{};
+        std::string name = UE_FFieldClass(propClass).GetName();
+        switch (Hash(name.c_str(), name.size()))
+        {
+        case HASH("StructProperty"):
+            classType.Type = UEPropertyType::StructProperty;
+            break;
+        case HASH("ObjectProperty"):
+            classType.Type = UEPropertyType::ObjectProperty;
+            break;
+        case HASH("SoftObjectProperty"):
+            classType.Type = UEPropertyType::SoftObjectProperty;
+            break;
+        case HASH("FloatProperty"):
+            classType.Type = UEPropertyType::FloatProperty;
+            break;
+        case HASH("ByteProperty"):
+            classType.Type = UEPropertyType::ByteProperty;
+            break;
+        case HASH("BoolProperty"):
+            classType.Type = UEPropertyType::BoolProperty;
+            break;
+        case HASH("IntProperty"):
+            classType.Type = UEPropertyType::IntProperty;
+            break;
+        case HASH("Int8Property"):
+            classType.Type = UEPropertyType::Int8Property;
+            break;
+        case HASH("Int16Property"):
+            classType.Type = UEPropertyType::Int16Property;
+            break;
+        case HASH("Int64Property"):
+            classType.Type = UEPropertyType::Int64Property;
+            break;
+        case HASH("UInt16Property"):
+            classType.Type = UEPropertyType::UInt16Property;
+            break;
+        case HASH("Int32Property"):
+            classType.Type = UEPropertyType::Int32Property;
+            break;
+        case HASH("UInt32Property"):
+            classType.Type = UEPropertyType::UInt32Property;
+            break;
+        case HASH("UInt64Property"):
+            classType.Type = UEPropertyType::UInt64Property;
+            break;
+        case HASH("NameProperty"):
+            classType.Type = UEPropertyType::NameProperty;
+            break;
+        case HASH("DelegateProperty"):
+            classType.Type = UEPropertyType::DelegateProperty;
+            break;
+        case HASH("SetProperty"):
+            classType.Type = UEPropertyType::SetProperty;
+            break;
+        case HASH("ArrayProperty"):
+            classType.Type = UEPropertyType::ArrayProperty;
+            break;
+        case HASH("WeakObjectProperty"):
+            classType.Type = UEPropertyType::WeakObjectProperty;
+            break;
+        case HASH("LazyObjectProperty"):
+            classType.Type = UEPropertyType::LazyObjectProperty;
+            break;
+        case HASH("StrProperty"):
+            classType.Type = UEPropertyType::StrProperty;
+            break;
+        case HASH("TextProperty"):
+            classType.Type = UEPropertyType::TextProperty;
+            break;
+        case HASH("MulticastSparseDelegateProperty"):
+            classType.Type = UEPropertyType::MulticastSparseDelegateProperty;
+            break;
+        case HASH("EnumProperty"):
+            classType.Type = UEPropertyType::EnumProperty;
+            break;
+        case HASH("DoubleProperty"):
+            classType.Type = UEPropertyType::DoubleProperty;
+            break;
+        case HASH("MulticastDelegateProperty"):
+            classType.Type = UEPropertyType::MulticastDelegateProperty;
+            break;
+        case HASH("ClassProperty"):
+            classType.Type = UEPropertyType::ClassProperty;
+            break;
+        case HASH("MulticastInlineDelegateProperty"):
+            classType.Type = UEPropertyType::MulticastInlineDelegateProperty;
+            break;
+        case HASH("MapProperty"):
+            classType.Type = UEPropertyType::MapProperty;
+            break;
+        case HASH("InterfaceProperty"):
+            classType.Type = UEPropertyType::InterfaceProperty;
+            break;
+        case HASH("FieldPathProperty"):
+            classType.Type = UEPropertyType::FieldPathProperty;
+            break;
+        case HASH("SoftClassProperty"):
+            classType.Type = UEPropertyType::SoftClassProperty;
+            break;
+        default:
+            classType.Name = std::move(name);
+            break;
+        }
+        return classType;
+    });
+
+    UEPropTypeInfo type = {UEPropertyType::Unknown, classType.Name};
 
-    auto &str = type.second;
-    auto hash = Hash(str.c_str(), str.size());
-    switch (hash)
+    switch (classType.Type)
     {
-    case HASH("StructProperty"):
+    case UEPropertyType::StructProperty:
     {
         auto obj = this->Cast<UE_FStructProperty>();
         type = {UEPropertyType::StructProperty, obj.GetTypeStr()};
         break;
     }
-    case HASH("ObjectProperty"):
+    case UEPropertyType::ObjectProperty:
     {
         auto obj = this->Cast<UE_FObjectPropertyBase>();
         type = {UEPropertyType::ObjectProperty, obj.GetTypeStr()};
         break;
     }
-    case HASH("SoftObjectProperty"):
+    case UEPropertyType::SoftObjectProperty:
     {
         auto obj = this->Cast<UE_FObjectPropertyBase>();
         type = {UEPropertyType::SoftObjectProperty, "struct TSoftObjectPtr<" + obj.GetPropertyClass().GetCppName() + ">"};
         break;
     }
-    case HASH("FloatProperty"):
+    case UEPropertyType::FloatProperty:
     {
         type = {UEPropertyType::FloatProperty, "float"};
         break;
     }
-    case HASH("ByteProperty"):
+    case UEPropertyType::ByteProperty:
     {
         auto obj = this->Cast<UE_FByteProperty>();
         type = {UEPropertyType::ByteProperty, obj.GetTypeStr()};
         break;
     }
-    case HASH("BoolProperty"):
+    case UEPropertyType::BoolProperty:
     {
         auto obj = this->Cast<UE_FBoolProperty>();
         type = {UEPropertyType::BoolProperty, obj.GetTypeStr()};
         break;
     }
-    case HASH("IntProperty"):
+    case UEPropertyType::IntProperty:
     {
         type = {UEPropertyType::IntProperty, "int32_t"};
         break;
     }
-    case HASH("Int8Property"):
+    case UEPropertyType::Int8Property:
     {
         type = {UEPropertyType::Int8Property, "int8_t"};
         break;
     }
-    case HASH("Int16Property"):
+    case UEPropertyType::Int16Property:
     {
         type = {UEPropertyType::Int16Property, "int16_t"};
         break;
     }
-    case HASH("Int64Property"):
+    case UEPropertyType::Int64Property:
     {
         type = {UEPropertyType::Int64Property, "int64_t"};
         break;
     }
-    case HASH("UInt16Property"):
+    case UEPropertyType::UInt16Property:
     {
         type = {UEPropertyType::UInt16Property, "uint16_t"};
         break;
     }
-    case HASH("Int32Property"):
+    case UEPropertyType::Int32Property:
     {
         type = {UEPropertyType::Int32Property, "int32_t"};
         break;
     }
-    case HASH("UInt32Property"):
+    case UEPropertyType::UInt32Property:
     {
         type = {UEPropertyType::UInt32Property, "uint32_t"};
         break;
     }
-    case HASH("UInt64Property"):
+    case UEPropertyType::UInt64Property:
     {
         type = {UEPropertyType::UInt64Property, "uint64_t"};
         break;
     }
-    case HASH("NameProperty"):
+    case UEPropertyType::NameProperty:
     {
         type = {UEPropertyType::NameProperty, "struct FName"};
         break;
     }
-    case HASH("DelegateProperty"):
+    case UEPropertyType::DelegateProperty:
     {
         type = {UEPropertyType::DelegateProperty, "struct FDelegate"};
         break;
     }
-    case HASH("SetProperty"):
+    case UEPropertyType::SetProperty:
     {
         auto obj = this->Cast<UE_FSetProperty>();
         type = {UEPropertyType::SetProperty, obj.GetTypeStr()};
         break;
     }
-    case HASH("ArrayProperty"):
+    case UEPropertyType::ArrayProperty:
     {
         auto obj = this->Cast<UE_FArrayProperty>();
         type = {UEPropertyType::ArrayProperty, obj.GetTypeStr()};
         break;
     }
-    case HASH("WeakObjectProperty"):
+    case UEPropertyType::WeakObjectProperty:
     {
         auto obj = this->Cast<UE_FStructProperty>();
         type = {UEPropertyType::WeakObjectProperty, "struct TWeakObjectPtr<" + obj.GetTypeStr() + ">"};
         break;
     }
-    case HASH("LazyObjectProperty"):
+    case UEPropertyType::LazyObjectProperty:
     {
         auto obj = this->Cast<UE_FStructProperty>();
         type = {UEPropertyType::LazyObjectProperty, "struct TLazyObjectPtr<" + obj.GetTypeStr() + ">"};
         break;
     }
-    case HASH("StrProperty"):
+    case UEPropertyType::StrProperty:
     {
         type = {UEPropertyType::StrProperty, "struct FString"};
         break;
     }
-    case HASH("TextProperty"):
+    case UEPropertyType::TextProperty:
     {
         type = {UEPropertyType::TextProperty, "struct FText"};
         break;
     }
-    case HASH("MulticastSparseDelegateProperty"):
+    case UEPropertyType::MulticastSparseDelegateProperty:
     {
         type = {UEPropertyType::MulticastSparseDelegateProperty, "struct FMulticastSparseDelegate"};
         break;
     }
-    case HASH("EnumProperty"):
+    case UEPropertyType::EnumProperty:
     {
         auto obj = this->Cast<UE_FEnumProperty>();
         type = {UEPropertyType::EnumProperty, obj.GetTypeStr()};
         break;
     }
-    case HASH("DoubleProperty"):
+    case UEPropertyType::DoubleProperty:
     {
         type = {UEPropertyType::DoubleProperty, "double"};
         break;
     }
-    case HASH("MulticastDelegateProperty"):
+    case UEPropertyType::MulticastDelegateProperty:
     {
         type = {UEPropertyType::MulticastDelegateProperty, "FMulticastDelegate"};
         break;
     }
-    case HASH("ClassProperty"):
+    case UEPropertyType::ClassProperty:
     {
         auto obj = this->Cast<UE_FClassProperty>();
         type = {UEPropertyType::ClassProperty, obj.GetTypeStr()};
         break;
     }
-    case HASH("MulticastInlineDelegateProperty"):
+    case UEPropertyType::MulticastInlineDelegateProperty:
     {
         type = {UEPropertyType::MulticastDelegateProperty, "struct FMulticastInlineDelegate"};
         break;
     }
-    case HASH("MapProperty"):
+    case UEPropertyType::MapProperty:
     {
         auto obj = this->Cast<UE_FMapProperty>();
         type = {UEPropertyType::MapProperty, obj.GetTypeStr()};
         break;
     }
-    case HASH("InterfaceProperty"):
+    case UEPropertyType::InterfaceProperty:
     {
         auto obj = this->Cast<UE_FInterfaceProperty>();
         type = {UEPropertyType::InterfaceProperty, obj.GetTypeStr()};
         break;
     }
-    case HASH("FieldPathProperty"):
+    case UEPropertyType::FieldPathProperty:
     {
         auto obj = this->Cast<UE_FFieldPathProperty>();
         type = {UEPropertyType::FieldPathProperty, obj.GetTypeStr()};
         break;
     }
-    case HASH("SoftClassProperty"):
+    case UEPropertyType::SoftClassProperty:
     {
         auto obj = this->Cast<UE_FSoftClassProperty>();
         type = {UEPropertyType::SoftClassProperty, obj.GetTypeStr()};
         break;
     }
+    default:
+        break;
     }
 
     return type;
@@ -1348,28 +1721,9 @@ UEPropTypeInfo UE_FProperty::GetType() const
 
 IFProperty UE_FProperty::GetInterface() const { return IFProperty(this); }
 
-uintptr_t UE_FProperty::FindSubFPropertyBaseOffset() const
-{
-    uintptr_t offset = 0;
-    uintptr_t temp = 0;
-    if (vm_rpm_ptr(object + UEWrappers::GetOffsets()->FProperty.Size, &temp, sizeof(uintptr_t)) && kPtrValidator.isPtrReadable(temp))
-    {
-        offset = UEWrappers::GetOffsets()->FProperty.Size;
-    }
-    else if (vm_rpm_ptr(object + UEWrappers::GetOffsets()->FProperty.Size + sizeof(void *), &temp, sizeof(uintptr_t)) && kPtrValidator.isPtrReadable(temp))
-    {
-        offset = UEWrappers::GetOffsets()->FProperty.Size + sizeof(void *);
-    }
-    return offset;
-}
-
 UE_UStruct UE_FStructProperty::GetStruct() const
 {
-    static uintptr_t offset = 0;
-    if (offset == 0)
-    {
-        offset = FindSubFPropertyBaseOffset();
-    }
+    uintptr_t offset = UEWrappers::GetDiscoveredOffsets()->FPropertySubBase;
     return offset ? vm_rpm_ptr<UE_UStruct>(object + offset) : UE_UStruct();
 }
 
@@ -1380,11 +1734,7 @@ std::string UE_FStructProperty::GetTypeStr() const
 
 UE_UClass UE_FObjectPropertyBase::GetPropertyClass() const
 {
-    static uintptr_t offset = 0;
-    if (offset == 0)
-    {
-        offset = FindSubFPropertyBaseOffset();
-    }
+    uintptr_t offset = UEWrappers::GetDiscoveredOffsets()->FPropertySubBase;
     return offset ? vm_rpm_ptr<UE_UClass>(object + offset) : UE_UClass();
 }
 
@@ -1395,11 +1745,7 @@ std::string UE_FObjectPropertyBase::GetTypeStr() const
 
 UE_FProperty UE_FArrayProperty::GetInner() const
 {
-    static uintptr_t offset = 0;
-    if (offset == 0)
-    {
-        offset = FindSubFPropertyBaseOffset();
-    }
+    uintptr_t offset = UEWrappers::GetDiscoveredOffsets()->FPropertySubBase;
     return offset ? vm_rpm_ptr<UE_FProperty>(object + offset) : UE_FProperty();
 }
 
@@ -1410,11 +1756,7 @@ std::string UE_FArrayProperty::GetTypeStr() const
 
 UE_UEnum UE_FByteProperty::GetEnum() const
 {
-    static uintptr_t offset = 0;
-    if (offset == 0)
-    {
-        offset = FindSubFPropertyBaseOffset();
-    }
+    uintptr_t offset = UEWrappers::GetDiscoveredOffsets()->FPropertySubBase;
     if (offset == 0) return nullptr;
 
     auto e = vm_rpm_ptr<UE_UEnum>(object + offset);
@@ -1460,50 +1802,14 @@ std::string UE_FBoolProperty::GetTypeStr() const
 
 UE_FProperty UE_FEnumProperty::GetUnderlayingProperty() const
 {
-    static uintptr_t off = 0;
-    if (off == 0)
-    {
-        auto p = vm_rpm_ptr<UE_FProperty>(object + UEWrappers::GetOffsets()->FProperty.Size);
-        if (p && p.GetName() == "UnderlyingType")
-        {
-            off = UEWrappers::GetOffsets()->FProperty.Size;
-        }
-        else
-        {
-            p = vm_rpm_ptr<UE_FProperty>(object + UEWrappers::GetOffsets()->FProperty.Size - sizeof(void *));
-            if (p && p.GetName() == "UnderlyingType")
-            {
-                off = UEWrappers::GetOffsets()->FProperty.Size + sizeof(void *);
-            }
-        }
-        return off == 0 ? nullptr : p;
-    }
-
-    return vm_rpm_ptr<UE_FProperty>(object + off);
+    uintptr_t offset = UEWrappers::GetDiscoveredOffsets()->FEnumPropertyUnderlyingProp;
+    return offset ? vm_rpm_ptr<UE_FProperty>(object + offset) : UE_FProperty();
 }
 
 UE_UEnum UE_FEnumProperty::GetEnum() const
 {
-    static uintptr_t off = 0;
-    if (off == 0)
-    {
-        auto e = vm_rpm_ptr<UE_UEnum>(object + UEWrappers::GetOffsets()->FProperty.Size + sizeof(void *));
-        if (e && e.IsA<UE_UEnum>())
-        {
-            off = UEWrappers::GetOffsets()->FProperty.Size + sizeof(void *);
-        }
-        else
-        {
-            e = vm_rpm_ptr<UE_UEnum>(object + UEWrappers::GetOffsets()->FProperty.Size);
-            if (e && e.IsA<UE_UEnum>())
-            {
-                off = UEWrappers::GetOffsets()->FProperty.Size + (sizeof(void *) * 2);
-            }
-        }
-        return off == 0 ? nullptr : e;
-    }
-
-    return vm_rpm_ptr<UE_UEnum>(object + off);
+    uintptr_t offset = UEWrappers::GetDiscoveredOffsets()->FEnumPropertyEnum;
+    return offset ? vm_rpm_ptr<UE_UEnum>(object + offset) : UE_UEnum();
 }
 
 std::string UE_FEnumProperty::GetTypeStr() const
@@ -1516,11 +1822,7 @@ std::string UE_FEnumProperty::GetTypeStr() const
 
 UE_UClass UE_FClassProperty::GetMetaClass() const
 {
-    static uintptr_t offset = 0;
-    if (offset == 0)
-    {
-        offset = FindSubFPropertyBaseOffset();
-    }
+    uintptr_t offset = UEWrappers::GetDiscoveredOffsets()->FPropertySubBase;
     return offset ? vm_rpm_ptr<UE_UClass>(object + offset + sizeof(void *)) : UE_UClass();
 }
 
@@ -1537,11 +1839,7 @@ std::string UE_FSoftClassProperty::GetTypeStr() const
 
 UE_FProperty UE_FSetProperty::GetElementProp() const
 {
-    static uintptr_t offset = 0;
-    if (offset == 0)
-    {
-        offset = FindSubFPropertyBaseOffset();
-    }
+    uintptr_t offset = UEWrappers::GetDiscoveredOffsets()->FPropertySubBase;
     return offset ? vm_rpm_ptr<UE_FProperty>(object + offset) : UE_FProperty();
 }
 
@@ -1552,21 +1850,13 @@ std::string UE_FSetProperty::GetTypeStr() const
 
 UE_FProperty UE_FMapProperty::GetKeyProp() const
 {
-    static uintptr_t offset = 0;
-    if (offset == 0)
-    {
-        offset = FindSubFPropertyBaseOffset();
-    }
+    uintptr_t offset = UEWrappers::GetDiscoveredOffsets()->FPropertySubBase;
     return offset ? vm_rpm_ptr<UE_FProperty>(object + offset) : UE_FProperty();
 }
 
 UE_FProperty UE_FMapProperty::GetValueProp() const
 {
-    static uintptr_t offset = 0;
-    if (offset == 0)
-    {
-        offset = FindSubFPropertyBaseOffset();
-    }
+    uintptr_t offset = UEWrappers::GetDiscoveredOffsets()->FPropertySubBase;
     return offset ? vm_rpm_ptr<UE_FProperty>(object + offset + sizeof(void *)) : UE_FProperty();
 }
 
@@ -1577,11 +1867,7 @@ std::string UE_FMapProperty::GetTypeStr() const
 
 UE_UClass UE_FInterfaceProperty::GetInterfaceClass() const
 {
-    static uintptr_t offset = 0;
-    if (offset == 0)
-    {
-        offset = FindSubFPropertyBaseOffset();
-    }
+    uintptr_t offset = UEWrappers::GetDiscoveredOffsets()->FPropertySubBase;
     return offset ? vm_rpm_ptr<UE_UClass>(object + offset) : UE_UClass();
 }
 
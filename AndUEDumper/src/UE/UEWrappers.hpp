@@ -16,6 +16,11 @@ namespace UEWrappers
     void Init(const UEVars *vars);
     UEVars const *GetUEVars();
     UE_UObjectArray *GetObjects();
+    const UE_DiscoveredOffsets *GetDiscoveredOffsets();
+    // known offsets, e.g. cached from an earlier run, they aren't probed then
+    void SetDiscoveredOffsets(const UE_DiscoveredOffsets &offsets);
+    // "Package.Outer." part of the full name of objects directly inside outer, cached
+    std::string GetOuterPrefix(uint8_t *outer);
 };  // namespace UEWrappers
 
 template <class T>
@@ -125,6 +130,9 @@ public:
     UE_FName() : object(nullptr) {}
     int GetNumber() const;
     std::string GetName() const;
+
+    // name of an FName already read from the target
+    static std::string ResolveName(int32_t comparisonIndex, int32_t number);
 };
 
 enum class UEPropertyType
@@ -444,6 +452,8 @@ public:
     int32_t GetOffset() const;
     uint64_t GetPropertyFlags() const;
     UEPropTypeInfo GetType() const;
+    // class was already read, e.g. along with the rest of the property
+    UEPropTypeInfo GetType(uint8_t *fieldClass) const;
 
     IUProperty GetInterface() const;
     static UE_UClass StaticClass();
@@ -513,6 +523,7 @@ public:
 
     uint32_t GetFunctionEFlags() const;
     std::string GetFunctionFlags() const;
+    static std::string FunctionFlagsToString(uint32_t flags);
     static UE_UClass StaticClass();
 };
 
@@ -847,9 +858,9 @@ public:
     int32_t GetOffset() const;
     uint64_t GetPropertyFlags() const;
     UEPropTypeInfo GetType() const;
+    // class was already read, e.g. along with the rest of the property
+    UEPropTypeInfo GetType(uint8_t *fieldClass) const;
     IFProperty GetInterface() const;
-
-    uintptr_t FindSubFPropertyBaseOffset() const;
 };
 
 class UE_FStructProperty : public UE_FProperty
@@ -1,6 +1,7 @@
 #include "UPackageGenerator.hpp"
 
 #include "UE/UEMemory.hpp"
+#include "Utils/TraceUtils.hpp"
 using namespace UEMemory;
 
 void UE_UPackage::GenerateBitPadding(std::vector<Member> &members, uint32_t offset, uint8_t bitOffset, uint8_t size)
@@ -23,10 +24,8 @@ void UE_UPackage::GeneratePadding(std::vector<Member> &members, uint32_t offset,
     members.push_back(padding);
 }
 
-void UE_UPackage::FillPadding(const UE_UStruct &object, std::vector<Member> &members, uint32_t &offset, uint8_t &bitOffset, uint32_t end)
+void UE_UPackage::FillPadding(std::vector<Member> &members, uint32_t &offset, uint8_t &bitOffset, uint32_t end)
 {
-    (void)object;
-
     if (bitOffset && bitOffset < 8)
     {
         UE_UPackage::GenerateBitPadding(members, offset, bitOffset, 8 - bitOffset);
@@ -41,55 +40,48 @@ void UE_UPackage::FillPadding(const UE_UStruct &object, std::vector<Member> &mem
     }
 }
 
-void UE_UPackage::GenerateFunction(const UE_UFunction &fn, Function *out)
+void UE_UPackage::GenerateFunction(const UEReflectionGraph::Function &fn, Function *out) const
 {
-    out->Name = fn.GetName();
-    out->FullName = fn.GetFullName();
-    out->EFlags = fn.GetFunctionEFlags();
-    out->Flags = fn.GetFunctionFlags();
-    out->NumParams = fn.GetNumParams();
-    out->ParamSize = fn.GetParamSize();
-    out->Func = fn.GetFunc();
-
-    auto generateParam = [&](IProperty *prop)
+    const std::string &fnName = Graph->GetName(fn.Name);
+
+    out->Name = fnName;
+    out->FullName = Graph->GetName(fn.FullName);
+    out->EFlags = fn.EFlags;
+    out->Flags = UE_UFunction::FunctionFlagsToString(fn.EFlags);
+    out->NumParams = fn.NumParams;
+    out->ParamSize = fn.ParamSize;
+    out->Func = fn.Func;
+
+    for (uint32_t i = 0; i < fn.ParamsCount; i++)
     {
-        auto flags = prop->GetPropertyFlags();
+        const auto &prop = Graph->Params[fn.FirstParam + i];
+        const std::string &propType = Graph->GetName(prop.Type);
+        auto flags = prop.Flags;
 
         // if property has 'ReturnParm' flag
         if (flags & CPF_ReturnParm)
         {
-            out->CppName = prop->GetType().second + " " + fn.GetName();
+            out->CppName = propType + " " + fnName;
         }
         // if property has 'Parm' flag
         else if (flags & CPF_Parm)
         {
-            if (prop->GetArrayDim() > 1)
+            if (prop.ArrayDim > 1)
             {
-                out->Params += fmt::format("{}* {}, ", prop->GetType().second, prop->GetName());
+                out->Params += fmt::format("{}* {}, ", propType, Graph->GetName(prop.Name));
             }
             else
             {
                 if (flags & CPF_OutParm)
                 {
-                    out->Params += fmt::format("{}& {}, ", prop->GetType().second, prop->GetName());
+                    out->Params += fmt::format("{}& {}, ", propType, Graph->GetName(prop.Name));
                 }
                 else
                 {
-                    out->Params += fmt::format("{} {}, ", prop->GetType().second, prop->GetName());
+                    out->Params += fmt::format("{} {}, ", propType, Graph->GetName(prop.Name));
                 }
             }
         }
-    };
-
-    for (auto prop = fn.GetChildProperties().Cast<UE_FProperty>(); prop; prop = prop.GetNext().Cast<UE_FProperty>())
-    {
-        auto propInterface = prop.GetInterface();
-        generateParam(&propInterface);
-    }
-    for (auto prop = fn.GetChildren().Cast<UE_UProperty>(); prop; prop = prop.GetNext().Cast<UE_UProperty>())
-    {
-        auto propInterface = prop.GetInterface();
-        generateParam(&propInterface);
     }
     if (out->Params.size())
     {
@@ -98,21 +90,21 @@ void UE_UPackage::GenerateFunction(const UE_UFunction &fn, Function *out)
 
     if (out->CppName.size() == 0)
     {
-        out->CppName = "void " + fn.GetName();
+        out->CppName = "void " + fnName;
     }
 }
 
-void UE_UPackage::GenerateStruct(const UE_UStruct &object, std::vector<Struct> &arr)
+void UE_UPackage::GenerateStruct(const UEReflectionGraph::Type &object, std::vector<Struct> &arr) const
 {
     Struct s;
-    s.Name = object.GetName();
-    s.FullName = object.GetFullName();
+    s.Name = Graph->GetName(object.Name);
+    s.FullName = Graph->GetName(object.FullName);
 
     s.CppName = "struct ";
-    s.CppName += object.GetCppName();
+    s.CppName += Graph->GetName(object.CppName);
 
     s.Inherited = 0;
-    s.Size = object.GetSize();
+    s.Size = object.Size;
 
     if (s.Size == 0)
     {
@@ -120,39 +112,37 @@ void UE_UPackage::GenerateStruct(const UE_UStruct &object, std::vector<Struct> &
         return;
     }
 
-    auto super = object.GetSuper();
-    if (super)
+    if (object.Super)
     {
         s.CppName += " : ";
-        s.CppName += super.GetCppName();
-        s.Inherited = super.GetSize();
+        s.CppName += Graph->GetName(object.SuperCppName);
+        s.Inherited = object.Inherited;
     }
 
     uint32_t offset = s.Inherited;
     uint8_t bitOffset = 0;
 
-    auto generateMember = [&](IProperty *prop, Member *m)
+    auto generateMember = [&](const UEReflectionGraph::Property &prop, Member *m)
     {
-        auto arrDim = prop->GetArrayDim();
-        m->Size = prop->GetSize() * arrDim;
+        auto arrDim = prop.ArrayDim;
+        m->Size = prop.ElementSize * arrDim;
         if (m->Size == 0)
         {
             return;
         }  // this shouldn't be zero
 
-        auto type = prop->GetType();
-        m->Type = type.second;
-        m->Name = prop->GetName();
-        m->Offset = prop->GetOffset();
+        const std::string &propType = Graph->GetName(prop.Type);
+        m->Type = propType;
+        m->Name = Graph->GetName(prop.Name);
+        m->Offset = prop.Offset;
 
         if (m->Offset > offset)
         {
-            UE_UPackage::FillPadding(object, s.Members, offset, bitOffset, m->Offset);
+            UE_UPackage::FillPadding(s.Members, offset, bitOffset, m->Offset);
         }
-        if (type.first == UEPropertyType::BoolProperty && *(uint32_t *)type.second.data() != 'loob')
+        if (prop.PropType == UEPropertyType::BoolProperty && propType != "bool")
         {
-            auto boolProp = prop;
-            auto mask = boolProp->GetFieldMask();
+            auto mask = prop.FieldMask;
             uint8_t zeros = 0, ones = 0;
             while (mask & ~1)
             {
@@ -178,7 +168,7 @@ void UE_UPackage::GenerateStruct(const UE_UStruct &object, std::vector<Struct> &
                 bitOffset = 0;
             }
 
-            m->extra = fmt::format("Mask(0x{:X})", boolProp->GetFieldMask());
+            m->extra = fmt::format("Mask(0x{:X})", prop.FieldMask);
         }
         else
         {
@@ -191,66 +181,42 @@ void UE_UPackage::GenerateStruct(const UE_UStruct &object, std::vector<Struct> &
         }
     };
 
-    for (auto prop = object.GetChildProperties().Cast<UE_FProperty>(); prop; prop = prop.GetNext().Cast<UE_FProperty>())
+    for (uint32_t i = 0; i < object.MembersCount; i++)
     {
         Member m;
-        auto propInterface = prop.GetInterface();
-        generateMember(&propInterface, &m);
+        generateMember(Graph->Members[object.FirstMember + i], &m);
         s.Members.push_back(m);
     }
 
-    for (auto child = object.GetChildren(); child; child = child.GetNext())
+    for (uint32_t i = 0; i < object.FunctionsCount; i++)
     {
-        if (child.IsA<UE_UFunction>())
-        {
-            auto fn = child.Cast<UE_UFunction>();
-            Function f;
-            GenerateFunction(fn, &f);
-            s.Functions.push_back(f);
-        }
-        else if (child.IsA<UE_UProperty>())
-        {
-            auto prop = child.Cast<UE_UProperty>();
-            Member m;
-            auto propInterface = prop.GetInterface();
-            generateMember(&propInterface, &m);
-            s.Members.push_back(m);
-        }
+        Function f;
+        GenerateFunction(Graph->Functions[object.FirstFunction + i], &f);
+        s.Functions.push_back(f);
     }
 
     if (s.Size > offset)
     {
-        UE_UPackage::FillPadding(object, s.Members, offset, bitOffset, s.Size);
+        UE_UPackage::FillPadding(s.Members, offset, bitOffset, s.Size);
     }
 
     arr.push_back(s);
 }
 
-void UE_UPackage::GenerateEnum(const UE_UEnum &object, std::vector<Enum> &arr)
+void UE_UPackage::GenerateEnum(const UEReflectionGraph::Type &object, std::vector<Enum> &arr) const
 {
     Enum e;
-    e.FullName = object.GetFullName();
+    e.FullName = Graph->GetName(object.FullName);
 
-    uint64_t nameSize = GetPtrAlignedOf(UEWrappers::GetUEVars()->GetOffsets()->FName.Size);
-    uint64_t pairSize = nameSize + sizeof(int64_t);
-
-    auto names = object.GetNames();
     uint64_t max = 0;
 
-    for (int32_t i = 0; i < names.Num(); i++)
+    for (uint32_t i = 0; i < object.EnumValuesCount; i++)
     {
-        auto pair = names.GetData() + i * pairSize;
-        auto name = UE_FName(pair);
-        auto str = name.GetName();
-        auto pos = str.find_last_of(':');
-        if (pos != std::string::npos)
-            str = str.substr(pos + 1);
-
-        auto value = vm_rpm_ptr<uint64_t>(pair + nameSize);
-        if (value > max)
-            max = value;
-
-        e.Members.emplace_back(str, value);
+        const auto &value = Graph->EnumValues[object.FirstEnumValue + i];
+        if (value.Value > max)
+            max = value.Value;
+
+        e.Members.emplace_back(Graph->GetName(value.Name), value.Value);
     }
 
     // enum values should be in ascending order
@@ -287,7 +253,7 @@ void UE_UPackage::GenerateEnum(const UE_UEnum &object, std::vector<Enum> &arr)
     else
         type = " : uint8_t";
 
-    e.CppName = "enum class " + object.GetName() + type;
+    e.CppName = "enum class " + Graph->GetName(object.Name) + type;
 
     if (e.Members.size())
     {
@@ -297,6 +263,8 @@ void UE_UPackage::GenerateEnum(const UE_UEnum &object, std::vector<Enum> &arr)
 
 void UE_UPackage::AppendStructsToBuffer(std::vector<Struct> &arr, BufferFmt *pBufFmt)
 {
+    TRACE_SCOPE("UE_UPackage::AppendStructsToBuffer");
+
     for (auto &s : arr)
     {
         pBufFmt->append("// Object: {}\n// Size: 0x{:X} (Inherited: 0x{:X})\n{}\n{{",
@@ -330,6 +298,8 @@ void UE_UPackage::AppendStructsToBuffer(std::vector<Struct> &arr, BufferFmt *pBu
 
 void UE_UPackage::AppendEnumsToBuffer(std::vector<Enum> &arr, BufferFmt *pBufFmt)
 {
+    TRACE_SCOPE("UE_UPackage::AppendEnumsToBuffer");
+
     for (auto &e : arr)
     {
         pBufFmt->append("// Object: {}\n{}\n{{", e.FullName, e.CppName);
@@ -350,20 +320,30 @@ void UE_UPackage::AppendEnumsToBuffer(std::vector<Enum> &arr, BufferFmt *pBufFmt
 
 void UE_UPackage::Process()
 {
-    auto &objects = Package->second;
-    for (auto &object : objects)
+    const auto &package = Graph->Packages[PackageIndex];
+    std::vector<uint32_t> typesOrder(package.TypesCount);
+    for (uint32_t i = 0; i < package.TypesCount; i++)
+        typesOrder[i] = package.FirstType + i;
+
+    Process(typesOrder);
+}
+
+void UE_UPackage::Process(const std::vector<uint32_t> &typesOrder)
+{
+    for (uint32_t typeIndex : typesOrder)
     {
-        if (object.IsA<UE_UClass>())
-        {
-            GenerateStruct(object.Cast<UE_UStruct>(), Classes);
-        }
-        else if (object.IsA<UE_UScriptStruct>())
-        {
-            GenerateStruct(object.Cast<UE_UStruct>(), Structures);
-        }
-        else if (object.IsA<UE_UEnum>())
+        const auto &type = Graph->Types[typeIndex];
+        switch (type.Kind)
         {
-            GenerateEnum(object.Cast<UE_UEnum>(), Enums);
+        case UEReflectionGraph::ETypeKind::Class:
+            GenerateStruct(type, Classes);
+            break;
+        case UEReflectionGraph::ETypeKind::Struct:
+            GenerateStruct(type, Structures);
+            break;
+        case UEReflectionGraph::ETypeKind::Enum:
+            GenerateEnum(type, Enums);
+            break;
         }
     }
 }
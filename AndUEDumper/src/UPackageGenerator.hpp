@@ -8,6 +8,7 @@
 #include "Utils/ProgressUtils.hpp"
 
 #include "UE/UEWrappers.hpp"
+#include "UE/UEReflectionGraph.hpp"
 
 class UE_UPackage
 {
@@ -50,7 +51,8 @@ public:
     };
 
 private:
-    std::pair<uint8_t *const, std::vector<UE_UObject>> *Package;
+    const UEReflectionGraph *Graph;
+    size_t PackageIndex;
 
 public:
     std::vector<Struct> Classes;
@@ -58,18 +60,21 @@ public:
     std::vector<Enum> Enums;
 
 private:
-    static void GenerateFunction(const UE_UFunction &fn, Function *out);
-    static void GenerateStruct(const UE_UStruct &object, std::vector<Struct> &arr);
-    static void GenerateEnum(const UE_UEnum &object, std::vector<Enum> &arr);
+    void GenerateFunction(const UEReflectionGraph::Function &fn, Function *out) const;
+    void GenerateStruct(const UEReflectionGraph::Type &object, std::vector<Struct> &arr) const;
+    void GenerateEnum(const UEReflectionGraph::Type &object, std::vector<Enum> &arr) const;
 
     static void GenerateBitPadding(std::vector<Member> &members, uint32_t offset, uint8_t bitOffset, uint8_t size);
     static void GeneratePadding(std::vector<Member> &members, uint32_t offset, uint32_t size);
-    static void FillPadding(const UE_UStruct &object, std::vector<Member> &members, uint32_t &offset, uint8_t &bitOffset, uint32_t end);
+    static void FillPadding(std::vector<Member> &members, uint32_t &offset, uint8_t &bitOffset, uint32_t end);
 
 public:
-    UE_UPackage(std::pair<uint8_t *const, std::vector<UE_UObject>> &package) : Package(&package) {};
-    inline UE_UObject GetObject() const { return UE_UObject(Package->first); }
+    UE_UPackage(const UEReflectionGraph &graph, size_t packageIndex) : Graph(&graph), PackageIndex(packageIndex) {};
+    inline UE_UObject GetObject() const { return UE_UObject(Graph->Packages[PackageIndex].Object); }
+    inline const std::string &GetName() const { return Graph->GetName(Graph->Packages[PackageIndex].Name); }
     void Process();
+    // typesOrder: indices in Graph->Types of this package's types, in the order they're generated
+    void Process(const std::vector<uint32_t> &typesOrder);
     static void AppendStructsToBuffer(std::vector<Struct> &arr, class BufferFmt *bufFmt);
     static void AppendEnumsToBuffer(std::vector<Enum> &arr, class BufferFmt *bufFmt);
 };
@@ -0,0 +1,245 @@
+#include "UsmapWriter.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    // EPropertyType of the mappings format
+    enum class EUsmapType : uint8_t
+    {
+        ByteProperty,
+        BoolProperty,
+        IntProperty,
+        FloatProperty,
+        ObjectProperty,
+        NameProperty,
+        DelegateProperty,
+        DoubleProperty,
+        ArrayProperty,
+        StructProperty,
+        StrProperty,
+        TextProperty,
+        InterfaceProperty,
+        MulticastDelegateProperty,
+        WeakObjectProperty,
+        LazyObjectProperty,
+        AssetObjectProperty,
+        SoftObjectProperty,
+        UInt64Property,
+        UInt32Property,
+        UInt16Property,
+        Int64Property,
+        Int16Property,
+        Int8Property,
+        MapProperty,
+        SetProperty,
+        EnumProperty,
+        FieldPathProperty,
+
+        Unknown = 0xFF
+    };
+
+    EUsmapType ToUsmapType(UEPropertyType type)
+    {
+        switch (type)
+        {
+        case UEPropertyType::StructProperty: return EUsmapType::StructProperty;
+        case UEPropertyType::ObjectProperty: return EUsmapType::ObjectProperty;
+        case UEPropertyType::ClassProperty: return EUsmapType::ObjectProperty;
+        case UEPropertyType::SoftObjectProperty: return EUsmapType::SoftObjectProperty;
+        case UEPropertyType::SoftClassProperty: return EUsmapType::SoftObjectProperty;
+        case UEPropertyType::FloatProperty: return EUsmapType::FloatProperty;
+        case UEPropertyType::DoubleProperty: return EUsmapType::DoubleProperty;
+        case UEPropertyType::ByteProperty: return EUsmapType::ByteProperty;
+        case UEPropertyType::BoolProperty: return EUsmapType::BoolProperty;
+        case UEPropertyType::IntProperty: return EUsmapType::IntProperty;
+        case UEPropertyType::Int32Property: return EUsmapType::IntProperty;
+        case UEPropertyType::Int8Property: return EUsmapType::Int8Property;
+        case UEPropertyType::Int16Property: return EUsmapType::Int16Property;
+        case UEPropertyType::Int64Property: return EUsmapType::Int64Property;
+        case UEPropertyType::UInt16Property: return EUsmapType::UInt16Property;
+        case UEPropertyType::UInt32Property: return EUsmapType::UInt32Property;
+        case UEPropertyType::UInt64Property: return EUsmapType::UInt64Property;
+        case UEPropertyType::NameProperty: return EUsmapType::NameProperty;
+        case UEPropertyType::DelegateProperty: return EUsmapType::DelegateProperty;
+        case UEPropertyType::MulticastDelegateProperty: return EUsmapType::MulticastDelegateProperty;
+        case UEPropertyType::MulticastSparseDelegateProperty: return EUsmapType::MulticastDelegateProperty;
+        case UEPropertyType::MulticastInlineDelegateProperty: return EUsmapType::MulticastDelegateProperty;
+        case UEPropertyType::SetProperty: return EUsmapType::SetProperty;
+        case UEPropertyType::ArrayProperty: return EUsmapType::ArrayProperty;
+        case UEPropertyType::MapProperty: return EUsmapType::MapProperty;
+        case UEPropertyType::WeakObjectProperty: return EUsmapType::WeakObjectProperty;
+        case UEPropertyType::LazyObjectProperty: return EUsmapType::LazyObjectProperty;
+        case UEPropertyType::StrProperty: return EUsmapType::StrProperty;
+        case UEPropertyType::TextProperty: return EUsmapType::TextProperty;
+        case UEPropertyType::EnumProperty: return EUsmapType::EnumProperty;
+        case UEPropertyType::InterfaceProperty: return EUsmapType::InterfaceProperty;
+        case UEPropertyType::FieldPathProperty: return EUsmapType::FieldPathProperty;
+        default: return EUsmapType::Unknown;
+        }
+    }
+
+    class PayloadWriter
+    {
+        const UEReflectionGraph &_graph;
+        // graph name id -> mappings name index
+        std::vector<int32_t> _nameIndices;
+
+    public:
+        std::string Data;
+        std::vector<UEReflectionGraph::NameID> Names;
+
+        explicit PayloadWriter(const UEReflectionGraph &graph) : _graph(graph), _nameIndices(graph.GetNamesCount(), -1) {}
+
+        template <typename T>
+        void Put(T value)
+        {
+            Data.append(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        void PutName(UEReflectionGraph::NameID id)
+        {
+            int32_t &index = _nameIndices[id];
+            if (index < 0)
+            {
+                index = int32_t(Names.size());
+                Names.push_back(id);
+            }
+            Put<int32_t>(index);
+        }
+
+        void PutTypeNode(int32_t nodeIndex)
+        {
+            if (nodeIndex < 0)
+            {
+                Put<uint8_t>(uint8_t(EUsmapType::Unknown));
+                return;
+            }
+
+            const auto &node = _graph.TypeNodes[nodeIndex];
+            EUsmapType type = ToUsmapType(node.Kind);
+
+            // enum backed bytes are enum properties with a byte inner
+            if (type == EUsmapType::ByteProperty && node.HasName)
+            {
+                Put<uint8_t>(uint8_t(EUsmapType::EnumProperty));
+                Put<uint8_t>(uint8_t(EUsmapType::ByteProperty));
+                PutName(node.Name);
+                return;
+            }
+
+            // can't be named without the object
+            if ((type == EUsmapType::StructProperty || type == EUsmapType::EnumProperty) && !node.HasName)
+                type = EUsmapType::Unknown;
+
+            Put<uint8_t>(uint8_t(type));
+            switch (type)
+            {
+            case EUsmapType::EnumProperty:
+                PutTypeNode(node.Inner);
+                PutName(node.Name);
+                break;
+            case EUsmapType::StructProperty:
+                PutName(node.Name);
+                break;
+            case EUsmapType::ArrayProperty:
+            case EUsmapType::SetProperty:
+                PutTypeNode(node.Inner);
+                break;
+            case EUsmapType::MapProperty:
+                PutTypeNode(node.Inner);
+                PutTypeNode(node.Value);
+                break;
+            default:
+                break;
+            }
+        }
+    };
+}  // namespace
+
+UsmapWriter::Stats UsmapWriter::Write(const UEReflectionGraph &graph, BufferFmt &out)
+{
+    Stats stats;
+    PayloadWriter body(graph);
+
+    std::vector<const UEReflectionGraph::Type *> enumTypes, structTypes;
+    for (const auto &type : graph.Types)
+    {
+        if (type.Kind == UEReflectionGraph::ETypeKind::Enum)
+            enumTypes.push_back(&type);
+        else if (type.Size != 0)
+            structTypes.push_back(&type);
+    }
+
+    body.Put<uint32_t>(uint32_t(enumTypes.size()));
+    for (const auto *type : enumTypes)
+    {
+        // this version stores value names only, values are their indices
+        uint32_t count = std::min<uint32_t>(type->EnumValuesCount, 0xFF);
+        body.PutName(type->Name);
+        body.Put<uint8_t>(uint8_t(count));
+        for (uint32_t i = 0; i < count; i++)
+            body.PutName(graph.EnumValues[type->FirstEnumValue + i].Name);
+    }
+
+    body.Put<uint32_t>(uint32_t(structTypes.size()));
+    for (const auto *type : structTypes)
+    {
+        body.PutName(type->Name);
+        if (type->Super)
+            body.PutName(type->SuperName);
+        else
+            body.Put<int32_t>(-1);
+
+        uint32_t schemaCount = 0;
+        for (uint32_t i = 0; i < type->MembersCount; i++)
+            schemaCount += uint32_t(std::max(1, graph.Members[type->FirstMember + i].ArrayDim));
+
+        body.Put<uint16_t>(uint16_t(schemaCount));
+        body.Put<uint16_t>(uint16_t(type->MembersCount));
+
+        uint32_t schemaIndex = 0;
+        for (uint32_t i = 0; i < type->MembersCount; i++)
+        {
+            const auto &prop = graph.Members[type->FirstMember + i];
+            int32_t arrayDim = std::max(1, prop.ArrayDim);
+
+            body.Put<uint16_t>(uint16_t(schemaIndex));
+            body.Put<uint8_t>(uint8_t(arrayDim));
+            body.PutName(prop.Name);
+            body.PutTypeNode(prop.TypeTree);
+
+            schemaIndex += uint32_t(arrayDim);
+        }
+    }
+
+    // names go first in the payload
+    std::string names;
+    names.append(4, '\0');
+    uint32_t namesCount = uint32_t(body.Names.size());
+    memcpy(&names[0], &namesCount, sizeof(namesCount));
+    for (auto id : body.Names)
+    {
+        const std::string &name = graph.GetName(id);
+        uint8_t len = uint8_t(std::min<size_t>(name.size(), 0xFF));
+        names.push_back(char(len));
+        names.append(name, 0, len);
+    }
+
+    uint32_t payloadSize = uint32_t(names.size() + body.Data.size());
+
+    out.appendRaw(&kMagic, sizeof(kMagic));
+    uint8_t version = uint8_t(EVersion::Initial), compression = uint8_t(ECompression::None);
+    out.appendRaw(&version, sizeof(version));
+    out.appendRaw(&compression, sizeof(compression));
+    out.appendRaw(&payloadSize, sizeof(payloadSize));  // compressed
+    out.appendRaw(&payloadSize, sizeof(payloadSize));  // decompressed
+    out.appendRaw(names.data(), names.size());
+    out.appendRaw(body.Data.data(), body.Data.size());
+
+    stats.Names = body.Names.size();
+    stats.Enums = enumTypes.size();
+    stats.Structs = structTypes.size();
+    return stats;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "UE/UEReflectionGraph.hpp"
+
+#include "Utils/BufferFmt.hpp"
+
+// .usmap mappings (names, enums & property type trees) for unversioned asset parsers.
+// Written from the reflection graph, which must be acquired with type trees.
+class UsmapWriter
+{
+public:
+    static constexpr uint16_t kMagic = 0x30C4;
+
+    enum class EVersion : uint8_t
+    {
+        Initial = 0
+    };
+
+    enum class ECompression : uint8_t
+    {
+        None = 0
+    };
+
+    struct Stats
+    {
+        size_t Names = 0;
+        size_t Enums = 0;
+        size_t Structs = 0;
+    };
+
+    static Stats Write(const UEReflectionGraph &graph, BufferFmt &out);
+};
@@ -1,8 +1,127 @@
 #include "BufferFmt.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <unistd.h>
+
+#include "TraceUtils.hpp"
+
+BufferFmt::~BufferFmt()
+{
+    // never finished, don't leave a partial file behind
+    if (_stream)
+    {
+        std::fclose(_stream);
+        std::remove((_streamPath + ".tmp").c_str());
+    }
+}
+
+BufferFmt::BufferFmt(BufferFmt&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+BufferFmt& BufferFmt::operator=(BufferFmt&& other) noexcept
+{
+    if (this == &other) return *this;
+
+    if (_stream)
+    {
+        std::fclose(_stream);
+        std::remove((_streamPath + ".tmp").c_str());
+    }
+
+    _buffer = std::move(other._buffer);
+    _stream = other._stream;
+    _streamPath = std::move(other._streamPath);
+    _streamThreshold = other._streamThreshold;
+    _streamFlushed = other._streamFlushed;
+    _streamFailed = other._streamFailed;
+
+    other._buffer.clear();
+    other._stream = nullptr;
+    other._streamFlushed = 0;
+    other._streamFailed = false;
+    return *this;
+}
+
+bool BufferFmt::openStream(const std::string& filePath, size_t flushThreshold)
+{
+    if (_stream) return false;
+
+    FILE* file = std::fopen((filePath + ".tmp").c_str(), "wb");
+    if (!file) return false;
+
+    // buffering is done here already
+    std::setvbuf(file, nullptr, _IONBF, 0);
+
+    _stream = file;
+    _streamPath = filePath;
+    _streamThreshold = std::max<size_t>(kStreamChunkSize, (flushThreshold + kStreamChunkSize - 1) / kStreamChunkSize * kStreamChunkSize);
+    _streamFlushed = 0;
+    _streamFailed = false;
+
+    if (_buffer.size() >= _streamThreshold)
+        _flushStream(false);
+
+    return true;
+}
+
+bool BufferFmt::closeStream()
+{
+    if (!_stream) return false;
+
+    TRACE_SCOPE("BufferFmt::closeStream");
+
+    _flushStream(true);
+
+    bool ok = !_streamFailed && std::fclose(_stream) == 0;
+    _stream = nullptr;
+
+    std::string tmpPath = _streamPath + ".tmp";
+    if (ok)
+        ok = std::rename(tmpPath.c_str(), _streamPath.c_str()) == 0;
+    if (!ok)
+        std::remove(tmpPath.c_str());
+
+    return ok;
+}
+
+void BufferFmt::_flushStream(bool all)
+{
+    size_t toWrite = all ? _buffer.size() : (_buffer.size() / kStreamChunkSize * kStreamChunkSize);
+    if (toWrite == 0) return;
+
+    TRACE_SCOPE("BufferFmt::flushStream");
+
+    if (!_streamFailed && std::fwrite(_buffer.data(), 1, toWrite, _stream) != toWrite)
+        _streamFailed = true;
+
+    _streamFlushed += toWrite;
+
+    size_t remaining = _buffer.size() - toWrite;
+    if (remaining > 0)
+        std::memmove(_buffer.data(), _buffer.data() + toWrite, remaining);
+    _buffer.resize(remaining);
+}
+
+void BufferFmt::_resetStream()
+{
+    if (ftruncate(fileno(_stream), 0) != 0)
+        _streamFailed = true;
+    std::rewind(_stream);
+    _streamFlushed = 0;
+}
+
 bool BufferFmt::_writeBufferToFile(const std::string& filePath, const char* mode) const
 {
-    FILE* file = std::fopen(filePath.c_str(), mode);
+    TRACE_SCOPE_DETAIL("BufferFmt::writeBufferToFile", filePath);
+
+    // a whole file is written under a temp name first, so a partial one never looks complete
+    const bool replace = std::strcmp(mode, "wb") == 0;
+    const std::string outPath = replace ? filePath + ".tmp" : filePath;
+
+    FILE* file = std::fopen(outPath.c_str(), mode);
     if (!file) return false;
 
     size_t buffer_size = _buffer.size();
@@ -22,6 +141,7 @@ bool BufferFmt::_writeBufferToFile(const std::string& filePath, const char* mode
             if (written != to_write)
             {
                 std::fclose(file);
+                if (replace) std::remove(outPath.c_str());
                 return false;
             }
             offset += to_write;
@@ -29,8 +149,13 @@ bool BufferFmt::_writeBufferToFile(const std::string& filePath, const char* mode
         }
     }
 
-    std::fclose(file);
-    return true;
+    if (std::fclose(file) != 0)
+    {
+        if (replace) std::remove(outPath.c_str());
+        return false;
+    }
+
+    return !replace || std::rename(outPath.c_str(), filePath.c_str()) == 0;
 }
 
 std::vector<std::string> BufferFmt::readLines() const
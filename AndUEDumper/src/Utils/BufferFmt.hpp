@@ -7,23 +7,46 @@
 
 #include <fmt/format.h>
 
+// In stream mode the buffer only holds the tail that isn't flushed yet,
+// content goes to "<path>.tmp" in aligned chunks and is renamed to path by closeStream.
 class BufferFmt
 {
 private:
     fmt::memory_buffer _buffer;  // memory buffer
 
+    // stream mode
+    FILE* _stream = nullptr;
+    std::string _streamPath;
+    size_t _streamThreshold = 0;
+    size_t _streamFlushed = 0;
+    bool _streamFailed = false;
+
     // Write buffer to a file
     bool _writeBufferToFile(const std::string& filePath, const char* mode) const;
 
+    // Flush whole chunks once the pending data reaches the threshold
+    void _flushStream(bool all);
+    void _resetStream();
+
 public:
+    static constexpr size_t kStreamChunkSize = 1024 * 1024;
+
     BufferFmt() = default;
+    ~BufferFmt();
+
+    BufferFmt(const BufferFmt&) = delete;
+    BufferFmt& operator=(const BufferFmt&) = delete;
+    BufferFmt(BufferFmt&& other) noexcept;
+    BufferFmt& operator=(BufferFmt&& other) noexcept;
 
     // Write a formatted string to the buffer, overwriting existing content
     template <typename... Args>
     void write(fmt::format_string<Args...> format_str, Args&&... args)
     {
         _buffer.clear();
+        if (_stream) _resetStream();
         fmt::format_to(std::back_inserter(_buffer), format_str, std::forward<Args>(args)...);
+        if (_stream && _buffer.size() >= _streamThreshold) _flushStream(false);
     }
 
     // Append a formatted string to the buffer
@@ -31,8 +54,26 @@ public:
     void append(fmt::format_string<Args...> format_str, Args&&... args)
     {
         fmt::format_to(std::back_inserter(_buffer), format_str, std::forward<Args>(args)...);
+        if (_stream && _buffer.size() >= _streamThreshold) _flushStream(false);
+    }
+
+    // Append raw bytes
+    void appendRaw(const void* data, size_t size)
+    {
+        const char* bytes = static_cast<const char*>(data);
+        _buffer.append(bytes, bytes + size);
+        if (_stream && _buffer.size() >= _streamThreshold) _flushStream(false);
     }
 
+    // Switch to stream mode, pending content is kept and goes first.
+    // flushThreshold is rounded up to kStreamChunkSize
+    bool openStream(const std::string& filePath, size_t flushThreshold = 8 * kStreamChunkSize);
+
+    // Flush the rest and rename the temp file to its final path, false if any write failed
+    bool closeStream();
+
+    inline bool isStreaming() const { return _stream != nullptr; }
+
     // Read the entire buffer as a string (copies data)
     inline std::string read() const
     {
@@ -51,18 +92,19 @@ public:
     inline void clear()
     {
         _buffer.clear();
+        if (_stream) _resetStream();
     }
 
     // Check if buffer is empty
     inline bool empty() const
     {
-        return _buffer.size() == 0;
+        return size() == 0;
     }
 
-    // Get buffer size
+    // Get buffer size, including streamed out content
     inline size_t size() const
     {
-        return _buffer.size();
+        return _streamFlushed + _buffer.size();
     }
 
     inline bool writeBufferToFile(const std::string& filePath) const
@@ -0,0 +1,122 @@
+#include "JsonWriter.hpp"
+
+void JsonWriter::_newLine(size_t depth)
+{
+    _out.append("\n{:{}}", "", depth * _indent);
+}
+
+void JsonWriter::_beginValue()
+{
+    if (_afterKey)
+    {
+        _afterKey = false;
+        return;
+    }
+
+    if (_scopes.empty())
+        return;
+
+    Scope &scope = _scopes.back();
+    if (scope.count++ > 0)
+        _out.append(",");
+    _newLine(_scopes.size());
+}
+
+void JsonWriter::_appendString(std::string_view str)
+{
+    _out.append("\"");
+
+    size_t start = 0;
+    for (size_t i = 0; i < str.size(); i++)
+    {
+        unsigned char c = str[i];
+        if (c != '"' && c != '\\' && c >= 0x20)
+            continue;
+
+        _out.append("{}", str.substr(start, i - start));
+        switch (c)
+        {
+        case '"':  _out.append("\\\""); break;
+        case '\\': _out.append("\\\\"); break;
+        case '\b': _out.append("\\b"); break;
+        case '\f': _out.append("\\f"); break;
+        case '\n': _out.append("\\n"); break;
+        case '\r': _out.append("\\r"); break;
+        case '\t': _out.append("\\t"); break;
+        default:   _out.append("\\u{:04x}", c); break;
+        }
+        start = i + 1;
+    }
+
+    _out.append("{}\"", str.substr(start));
+}
+
+void JsonWriter::beginObject()
+{
+    _beginValue();
+    _out.append("{{");
+    _scopes.push_back({false, 0});
+}
+
+void JsonWriter::endObject()
+{
+    if (_scopes.empty() || _scopes.back().isArray) return;
+
+    bool hasItems = _scopes.back().count > 0;
+    _scopes.pop_back();
+    if (hasItems)
+        _newLine(_scopes.size());
+    _out.append("}}");
+}
+
+void JsonWriter::beginArray()
+{
+    _beginValue();
+    _out.append("[");
+    _scopes.push_back({true, 0});
+}
+
+void JsonWriter::endArray()
+{
+    if (_scopes.empty() || !_scopes.back().isArray) return;
+
+    bool hasItems = _scopes.back().count > 0;
+    _scopes.pop_back();
+    if (hasItems)
+        _newLine(_scopes.size());
+    _out.append("]");
+}
+
+void JsonWriter::key(std::string_view name)
+{
+    if (_scopes.empty() || _scopes.back().isArray) return;
+
+    _beginValue();
+    _appendString(name);
+    _out.append(": ");
+    _afterKey = true;
+}
+
+void JsonWriter::value(std::string_view str)
+{
+    _beginValue();
+    _appendString(str);
+}
+
+void JsonWriter::value(uint64_t number)
+{
+    _beginValue();
+    _out.append("{}", number);
+}
+
+void JsonWriter::value(int64_t number)
+{
+    _beginValue();
+    _out.append("{}", number);
+}
+
+void JsonWriter::value(bool b)
+{
+    _beginValue();
+    _out.append(b ? "true" : "false");
+}
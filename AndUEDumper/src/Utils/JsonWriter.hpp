@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "BufferFmt.hpp"
+
+// Streaming JSON emitter, writes straight into a BufferFmt sink.
+// Output is laid out like nlohmann::json::dump(indent).
+class JsonWriter
+{
+private:
+    struct Scope
+    {
+        bool isArray;
+        size_t count;
+    };
+
+    BufferFmt &_out;
+    int _indent;
+    std::vector<Scope> _scopes;
+    bool _afterKey = false;
+
+    void _beginValue();
+    void _newLine(size_t depth);
+    void _appendString(std::string_view str);
+
+public:
+    explicit JsonWriter(BufferFmt &out, int indent = 4) : _out(out), _indent(indent) {}
+
+    void beginObject();
+    void endObject();
+
+    void beginArray();
+    void endArray();
+
+    // key of the next value, only inside objects
+    void key(std::string_view name);
+
+    void value(std::string_view str);
+    inline void value(const char *str) { value(std::string_view(str)); }
+    void value(uint64_t number);
+    void value(int64_t number);
+    void value(bool b);
+
+    inline size_t depth() const { return _scopes.size(); }
+};
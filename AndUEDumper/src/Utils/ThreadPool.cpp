@@ -0,0 +1,253 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <sched.h>
+#include <unistd.h>
+
+#include "TraceUtils.hpp"
+
+namespace
+{
+    // pool and queue index of the current thread if it's a pool worker
+    thread_local const ThreadPool *tls_pool = nullptr;
+    thread_local size_t tls_queue = 0;
+
+    std::mutex sharedPoolMtx;
+    std::unique_ptr<ThreadPool> sharedPool;
+}  // namespace
+
+ThreadPool::ThreadPool(size_t workersCount, bool pinWorkers)
+{
+    if (workersCount == 0)
+        workersCount = std::max(1u, std::thread::hardware_concurrency());
+
+    for (size_t i = 0; i < workersCount; i++)
+        _queues.push_back(std::make_unique<WorkerQueue>());
+
+    for (size_t i = 0; i < workersCount; i++)
+        _threads.emplace_back(&ThreadPool::workerLoop, this, i, pinWorkers);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lk(_sleepMtx);
+        _stop = true;
+    }
+    _sleepCv.notify_all();
+
+    for (auto &it : _threads)
+    {
+        if (it.joinable())
+            it.join();
+    }
+}
+
+void ThreadPool::submit(Task task)
+{
+    size_t index = (tls_pool == this) ? tls_queue : (_nextQueue++ % _queues.size());
+
+    // counted before it's published, a worker popping it right away must not take _pending below zero
+    {
+        std::lock_guard<std::mutex> lk(_sleepMtx);
+        _pending++;
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(_queues[index]->mtx);
+        _queues[index]->tasks.push_back(std::move(task));
+    }
+    _sleepCv.notify_one();
+}
+
+bool ThreadPool::popTask(size_t index, Task &task)
+{
+    if (_pending.load() == 0)
+        return false;
+
+    // own queue first, newest task
+    {
+        auto &own = *_queues[index];
+        std::lock_guard<std::mutex> lk(own.mtx);
+        if (!own.tasks.empty())
+        {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            _pending--;
+            return true;
+        }
+    }
+
+    // steal oldest task from the others
+    for (size_t i = 1; i < _queues.size(); i++)
+    {
+        auto &other = *_queues[(index + i) % _queues.size()];
+        std::lock_guard<std::mutex> lk(other.mtx);
+        if (!other.tasks.empty())
+        {
+            task = std::move(other.tasks.front());
+            other.tasks.pop_front();
+            _pending--;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool ThreadPool::tryRunPending()
+{
+    Task task;
+    size_t index = (tls_pool == this) ? tls_queue : 0;
+    if (!popTask(index, task))
+        return false;
+
+    task();
+    return true;
+}
+
+void ThreadPool::workerLoop(size_t index, bool pin)
+{
+    tls_pool = this;
+    tls_queue = index;
+    TraceRecorder::setThreadName("worker " + std::to_string(index));
+
+    if (pin)
+    {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        if (cpus > 0)
+        {
+            cpu_set_t cpuSet;
+            CPU_ZERO(&cpuSet);
+            CPU_SET(int(index % size_t(cpus)), &cpuSet);
+            sched_setaffinity(0, sizeof(cpuSet), &cpuSet);
+        }
+    }
+
+    while (true)
+    {
+        Task task;
+        if (popTask(index, task))
+        {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lk(_sleepMtx);
+        _sleepCv.wait(lk, [this]
+        { return _stop.load() || _pending.load() > 0; });
+
+        if (_stop.load() && _pending.load() == 0)
+            break;
+    }
+}
+
+void ThreadPool::parallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)> &body)
+{
+    if (begin >= end)
+        return;
+
+    grain = std::max<size_t>(grain, 1);
+
+    TaskGroup group(*this);
+    for (size_t i = begin; i < end; i += grain)
+    {
+        size_t rangeEnd = std::min(i + grain, end);
+        group.run([&body, i, rangeEnd]
+        { body(i, rangeEnd); });
+    }
+    group.wait();
+}
+
+ThreadPool &ThreadPool::Get()
+{
+    std::lock_guard<std::mutex> lk(sharedPoolMtx);
+    if (!sharedPool)
+        sharedPool = std::make_unique<ThreadPool>();
+
+    return *sharedPool;
+}
+
+void ThreadPool::Configure(size_t workersCount, bool pinWorkers)
+{
+    std::lock_guard<std::mutex> lk(sharedPoolMtx);
+    sharedPool = std::make_unique<ThreadPool>(workersCount, pinWorkers);
+}
+
+TaskGroup::~TaskGroup()
+{
+    while (!waitFor(std::chrono::milliseconds(10)))
+    {
+    }
+}
+
+void TaskGroup::run(ThreadPool::Task task)
+{
+    _pending++;
+    _pool.submit([this, task = std::move(task)]
+    {
+        if (!_pool.isCancelled())
+        {
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lk(_errorMtx);
+                if (!_error)
+                    _error = std::current_exception();
+            }
+        }
+
+        // notify under the lock so the group can't be destroyed before we're done with it
+        std::lock_guard<std::mutex> lk(_doneMtx);
+        if (--_pending == 0)
+            _doneCv.notify_all();
+    });
+}
+
+bool TaskGroup::waitFor(std::chrono::milliseconds timeout)
+{
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    while (!isDone())
+    {
+        // help with pending tasks, otherwise sleep in short slices
+        // so tasks queued meanwhile can still be picked up here
+        if (_pool.tryRunPending())
+            continue;
+
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline)
+            return false;
+
+        std::unique_lock<std::mutex> lk(_doneMtx);
+        _doneCv.wait_until(lk, std::min(deadline, now + std::chrono::milliseconds(5)), [this]
+        { return isDone(); });
+    }
+
+    std::lock_guard<std::mutex> lk(_doneMtx);
+    return true;
+}
+
+void TaskGroup::wait()
+{
+    while (!waitFor(std::chrono::milliseconds(100)))
+    {
+    }
+
+    rethrowError();
+}
+
+void TaskGroup::rethrowError()
+{
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lk(_errorMtx);
+        std::swap(error, _error);
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool, each worker owns a deque,
+// pops its own tasks from the back and steals from the front of others.
+class ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    // workersCount 0 = hardware concurrency
+    explicit ThreadPool(size_t workersCount = 0, bool pinWorkers = false);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    inline size_t workersCount() const { return _threads.size(); }
+
+    void submit(Task task);
+
+    // Run one pending task on the calling thread, false if there was none
+    bool tryRunPending();
+
+    // Pending and future TaskGroup tasks are skipped until resetCancel
+    inline void cancel() { _cancelled = true; }
+    inline void resetCancel() { _cancelled = false; }
+    inline bool isCancelled() const { return _cancelled.load(); }
+
+    // Split [begin, end) into grain sized ranges and wait for all of them
+    void parallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)> &body);
+
+    // Shared pool used by the dumper stages
+    static ThreadPool &Get();
+
+    // Recreate the shared pool, call before any stage is running
+    static void Configure(size_t workersCount, bool pinWorkers);
+
+private:
+    struct WorkerQueue
+    {
+        std::mutex mtx;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> _queues;
+    std::vector<std::thread> _threads;
+
+    std::mutex _sleepMtx;
+    std::condition_variable _sleepCv;
+
+    std::atomic<size_t> _pending{0};
+    std::atomic<size_t> _nextQueue{0};
+    std::atomic<bool> _stop{false};
+    std::atomic<bool> _cancelled{false};
+
+    void workerLoop(size_t index, bool pin);
+    bool popTask(size_t index, Task &task);
+};
+
+// Tracks a set of tasks on a pool, waiting helps executing pending tasks.
+// First exception thrown by a task is rethrown from wait.
+class TaskGroup
+{
+public:
+    explicit TaskGroup(ThreadPool &pool = ThreadPool::Get()) : _pool(pool) {}
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+    void run(ThreadPool::Task task);
+
+    inline bool isDone() const { return _pending.load() == 0; }
+
+    // Wait up to timeout, true if all tasks finished
+    bool waitFor(std::chrono::milliseconds timeout);
+
+    void wait();
+
+private:
+    ThreadPool &_pool;
+    std::atomic<size_t> _pending{0};
+
+    std::mutex _doneMtx;
+    std::condition_variable _doneCv;
+
+    std::mutex _errorMtx;
+    std::exception_ptr _error;
+
+    void rethrowError();
+};
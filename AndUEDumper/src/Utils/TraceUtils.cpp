@@ -0,0 +1,134 @@
+#include "TraceUtils.hpp"
+
+#include <algorithm>
+
+#include "BufferFmt.hpp"
+#include "JsonWriter.hpp"
+
+namespace
+{
+    thread_local std::string tls_threadName;
+    thread_local void *tls_threadBuffer = nullptr;
+}  // namespace
+
+TraceRecorder &TraceRecorder::Get()
+{
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+int64_t TraceRecorder::now() const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _start).count();
+}
+
+void TraceRecorder::setThreadName(const std::string &name)
+{
+    tls_threadName = name;
+}
+
+TraceRecorder::ThreadBuffer *TraceRecorder::threadBuffer()
+{
+    if (tls_threadBuffer)
+        return static_cast<ThreadBuffer *>(tls_threadBuffer);
+
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->Events.resize(kThreadCapacity);
+
+    std::lock_guard<std::mutex> lock(_buffersMtx);
+    buffer->Tid = uint32_t(_buffers.size() + 1);
+    buffer->Name = tls_threadName.empty() ? "thread " + std::to_string(buffer->Tid) : tls_threadName;
+    tls_threadBuffer = buffer.get();
+    _buffers.push_back(std::move(buffer));
+    return _buffers.back().get();
+}
+
+void TraceRecorder::record(const char *name, std::string &&detail, int64_t beginUs, int64_t endUs)
+{
+    ThreadBuffer *buffer = threadBuffer();
+
+    Event &event = buffer->Events[buffer->Next % kThreadCapacity];
+    if (buffer->Next >= kThreadCapacity)
+        buffer->Dropped++;
+
+    event.Name = name;
+    event.Detail = std::move(detail);
+    event.BeginUs = beginUs;
+    event.DurationUs = endUs - beginUs;
+    buffer->Next++;
+}
+
+bool TraceRecorder::writeChromeTrace(const std::string &filePath) const
+{
+    BufferFmt bufferFmt;
+    JsonWriter json(bufferFmt, 0);
+
+    json.beginObject();
+    json.key("displayTimeUnit");
+    json.value("ms");
+    json.key("traceEvents");
+    json.beginArray();
+
+    // the file write below may be traced itself
+    std::unique_lock<std::mutex> lock(_buffersMtx);
+    for (const auto &buffer : _buffers)
+    {
+        json.beginObject();
+        json.key("name");
+        json.value("thread_name");
+        json.key("ph");
+        json.value("M");
+        json.key("pid");
+        json.value(int64_t(1));
+        json.key("tid");
+        json.value(int64_t(buffer->Tid));
+        json.key("args");
+        json.beginObject();
+        json.key("name");
+        json.value(buffer->Name);
+        json.key("dropped");
+        json.value(uint64_t(buffer->Dropped));
+        json.endObject();
+        json.endObject();
+
+        // oldest first once the ring wrapped
+        size_t count = std::min(buffer->Next, kThreadCapacity);
+        size_t first = buffer->Next - count;
+        for (size_t i = first; i < buffer->Next; i++)
+        {
+            const Event &event = buffer->Events[i % kThreadCapacity];
+
+            json.beginObject();
+            json.key("name");
+            json.value(event.Name);
+            json.key("cat");
+            json.value("dump");
+            json.key("ph");
+            json.value("X");
+            json.key("ts");
+            json.value(event.BeginUs);
+            json.key("dur");
+            json.value(event.DurationUs);
+            json.key("pid");
+            json.value(int64_t(1));
+            json.key("tid");
+            json.value(int64_t(buffer->Tid));
+            if (!event.Detail.empty())
+            {
+                json.key("args");
+                json.beginObject();
+                json.key("detail");
+                json.value(event.Detail);
+                json.endObject();
+            }
+            json.endObject();
+        }
+    }
+
+    lock.unlock();
+
+    json.endArray();
+    json.endObject();
+
+    return bufferFmt.writeBufferToFile(filePath);
+}
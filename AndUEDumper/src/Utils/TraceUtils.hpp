@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Scoped timeline events of the dump stages, written as Chrome trace JSON for Perfetto / chrome://tracing.
+// Each thread records into its own ring buffer, the oldest events are overwritten once it's full.
+class TraceRecorder
+{
+public:
+    static constexpr size_t kThreadCapacity = 1 << 16;
+
+    struct Event
+    {
+        const char *Name = nullptr;
+        std::string Detail;
+        int64_t BeginUs = 0;
+        int64_t DurationUs = 0;
+    };
+
+    static TraceRecorder &Get();
+
+    inline void setEnabled(bool enable) { _enabled = enable; }
+    inline bool isEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+    // microseconds since the recorder was created
+    int64_t now() const;
+
+    // name must outlive the recorder, a literal
+    void record(const char *name, std::string &&detail, int64_t beginUs, int64_t endUs);
+
+    // shown as the thread name in the timeline, can be set before recording is enabled
+    static void setThreadName(const std::string &name);
+
+    // call once recording threads are idle
+    bool writeChromeTrace(const std::string &filePath) const;
+
+private:
+    struct ThreadBuffer
+    {
+        uint32_t Tid = 0;
+        std::string Name;
+        std::vector<Event> Events;
+        size_t Next = 0;
+        size_t Dropped = 0;
+    };
+
+    std::atomic<bool> _enabled{false};
+    std::chrono::steady_clock::time_point _start = std::chrono::steady_clock::now();
+
+    mutable std::mutex _buffersMtx;
+    std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+
+    ThreadBuffer *threadBuffer();
+};
+
+class TraceScope
+{
+public:
+    explicit TraceScope(const char *name) : _name(name), _begin(-1)
+    {
+        if (TraceRecorder::Get().isEnabled())
+            _begin = TraceRecorder::Get().now();
+    }
+
+    ~TraceScope()
+    {
+        if (_begin >= 0)
+            TraceRecorder::Get().record(_name, std::move(_detail), _begin, TraceRecorder::Get().now());
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+    inline bool isActive() const { return _begin >= 0; }
+    inline void setDetail(std::string detail) { _detail = std::move(detail); }
+
+private:
+    const char *_name;
+    int64_t _begin;
+    std::string _detail;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(_traceScope, __LINE__)(name)
+
+// detail is only evaluated while recording
+#define TRACE_SCOPE_DETAIL(name, detail)                               \
+    TraceScope TRACE_CONCAT(_traceScope, __LINE__)(name);              \
+    if (TRACE_CONCAT(_traceScope, __LINE__).isActive())                \
+    TRACE_CONCAT(_traceScope, __LINE__).setDetail(detail)
@@ -12,11 +12,15 @@
 #include "Utils/KittyCmdln.hpp"
 #include "Utils/Logger.hpp"
 #include "Utils/ProgressUtils.hpp"
+#include "Utils/ThreadPool.hpp"
+#include "Utils/TraceUtils.hpp"
 
 #include "Dumper.hpp"
+#include "SDKDatabaseDiff.hpp"
 
 #include "UE/UEMemory.hpp"
 #include "UE/UEGameProfile.hpp"
+#include "UE/UEProfileDetector.hpp"
 
 #include "UE/UEGameProfiles/ArenaBreakout.hpp"
 #include "UE/UEGameProfiles/BlackClover.hpp"
@@ -47,6 +51,10 @@
 #include "UE/UEGameProfiles/LineageW.hpp"
 #include "UE/UEGameProfiles/RLSideswipe.hpp"
 #include "UE/UEGameProfiles/PUBG.hpp"
+#include "UE/UEGameProfiles/Generic.hpp"
+#ifndef __ANDROID__
+#include "UE/UEGameProfiles/Fixture.hpp"
+#endif
 
 std::vector<IGameProfile *> UE_Games = {
     new PESProfile(),
@@ -78,6 +86,12 @@ std::vector<IGameProfile *> UE_Games = {
     new LineageWProfile(),
     new RLSideswipeProfile(),
     new PUBGProfile(),
+    // last so the detector prefers a game profile on equal scores
+    new GenericProfile(),
+#ifndef __ANDROID__
+    // Linux host builds only, see Fixture/UEFixture.cpp
+    new FixtureProfile(),
+#endif
 };
 
 #define kUEDUMPER_VERSION "4.3.0"
@@ -107,9 +121,54 @@ int main(int argc, char **args)
     cmdline.addScanf("-p", "--package", "specify game package ID in advance.", false, "%s", sGamePkg);
 
     // options
+    bool bAutoDetect = false;
+    cmdline.addFlag("-u", "--auto-detect", "detect the game profile from the target instead of the package ID, unknown packages are always detected.", false, &bAutoDetect);
+
     bool bDumpLib = false;
     cmdline.addFlag("-d", "--dumplib", "dump UE library from memory.", false, &bDumpLib);
 
+    bool bSDKLayout = false;
+    cmdline.addFlag("-s", "--sdk", "also write one header per package into SDK directory.", false, &bSDKLayout);
+
+    bool bSDKDatabase = false;
+    cmdline.addFlag("-b", "--database", "also write SDK.db, a binary SDK database that can be memory mapped.", false, &bSDKDatabase);
+
+    bool bUsmap = false;
+    cmdline.addFlag("-m", "--usmap", "also write Mappings.usmap for unversioned assets parsers.", false, &bUsmap);
+
+    bool bOffsetsOnly = false;
+    cmdline.addFlag("-f", "--offsets-only", "only dump Offsets.hpp, objects are not gathered.", false, &bOffsetsOnly);
+
+    bool bDiscoverOffsets = false;
+    cmdline.addFlag("-g", "--discover-offsets", "infer the profile offsets from the core objects and write DiscoveredOffsets.hpp, no dump is done.", false, &bDiscoverOffsets);
+
+    bool bNoCache = false;
+    cmdline.addFlag("-n", "--no-cache", "don't use or update the offsets cache of the game build.", false, &bNoCache);
+
+    char sIncludeRules[0x1000] = {0};
+    cmdline.addScanf("-i", "--include", "only dump matching objects, rules separated by ';' e.g. \"package:Engine;class:F*Data\".", false, "%4095[^\n]", sIncludeRules);
+
+    char sExcludeRules[0x1000] = {0};
+    cmdline.addScanf("-e", "--exclude", "don't dump matching objects, rules separated by ';' e.g. \"package:re:^Niagara.*;full:ScriptStruct CoreUObject.Vector\".", false, "%4095[^\n]", sExcludeRules);
+
+    char sRootTypes[0x1000] = {0};
+    cmdline.addScanf("-r", "--roots", "only dump these types and what they need by value, full names separated by ';' e.g. \"Class Engine.Pawn;Class Engine.PlayerController\".", false, "%4095[^\n]", sRootTypes);
+
+    char sDiffOld[0xff] = {0};
+    cmdline.addScanf("-x", "--diff-old", "old SDK.db to diff against --diff-new, no dump is done.", false, "%s", sDiffOld);
+
+    char sDiffNew[0xff] = {0};
+    cmdline.addScanf("-y", "--diff-new", "new SDK.db, diff report is written to output directory as SDKDiff.txt.", false, "%s", sDiffNew);
+
+    int nThreads = 0;
+    cmdline.addScanf("-t", "--threads", "worker threads count, default is CPU cores count.", false, "%d", &nThreads);
+
+    bool bPinThreads = false;
+    cmdline.addFlag("-a", "--affinity", "pin worker threads to CPU cores.", false, &bPinThreads);
+
+    bool bTrace = false;
+    cmdline.addFlag("-j", "--trace", "also write Trace.json, a Chrome trace of the dump stages to open in Perfetto.", false, &bTrace);
+
     cmdline.parseArgs();
 
     if (bNeededHelp)
@@ -130,6 +189,48 @@ int main(int argc, char **args)
         return 1;
     }
 
+    if (sDiffOld[0] || sDiffNew[0])
+    {
+        if (!sDiffOld[0] || !sDiffNew[0])
+        {
+            LOGE("Diff needs both --diff-old and --diff-new.");
+            return 1;
+        }
+
+        if (IOUtils::mkdir_recursive(sOutDirectory, 0777) == -1 && errno != EEXIST)
+        {
+            int err = errno;
+            LOGE("Couldn't create Output Directory [\"%s\"] error=%d | %s.", sOutDirectory.c_str(), err, strerror(err));
+            return 1;
+        }
+
+        auto diffStart = std::chrono::steady_clock::now();
+
+        BufferFmt report;
+        SDKDatabaseDiff::Stats stats;
+        std::string diffError;
+        if (!SDKDatabaseDiff::CompareFiles(sDiffOld, sDiffNew, report, &stats, &diffError))
+        {
+            LOGE("Diff: %s.", diffError.c_str());
+            return 1;
+        }
+
+        std::chrono::duration<float, std::milli> diffDurationMS = (std::chrono::steady_clock::now() - diffStart);
+
+        std::string path = sOutDirectory + "/SDKDiff.txt";
+        if (!report.writeBufferToFile(path))
+        {
+            LOGE("Couldn't save %s", path.c_str());
+            return 1;
+        }
+
+        LOGI("Types: +%zu -%zu ~%zu", stats.TypesAdded, stats.TypesRemoved, stats.TypesChanged);
+        LOGI("Enums: +%zu -%zu ~%zu", stats.EnumsAdded, stats.EnumsRemoved, stats.EnumsChanged);
+        LOGI("Diff Duration: %.2fms", diffDurationMS.count());
+        LOGI("Diff Location: %s", path.c_str());
+        return 0;
+    }
+
     if (sGamePackage.empty())
     {
         std::sort(UE_Games.begin(), UE_Games.end(), [](const IGameProfile *a, const IGameProfile *b)
@@ -198,6 +299,40 @@ int main(int argc, char **args)
     LOGI("Process ID: %d", gamePID);
     LOGI("Output directory: %s", sOutDirectory.c_str());
     LOGI("Dump Library: %s", bDumpLib ? "true" : "false");
+    LOGI("SDK Layout: %s", bSDKLayout ? "true" : "false");
+    LOGI("SDK Database: %s", bSDKDatabase ? "true" : "false");
+    LOGI("Usmap: %s", bUsmap ? "true" : "false");
+    LOGI("Offsets Only: %s", bOffsetsOnly ? "true" : "false");
+    LOGI("Discover Offsets: %s", bDiscoverOffsets ? "true" : "false");
+
+    std::vector<std::string> rootTypes;
+    {
+        std::string roots = sRootTypes;
+        for (size_t start = 0, end = 0; start < roots.size(); start = end + 1)
+        {
+            end = roots.find(';', start);
+            if (end == std::string::npos)
+                end = roots.size();
+            if (end > start)
+                rootTypes.push_back(roots.substr(start, end - start));
+        }
+    }
+    LOGI("Root types: %zu", rootTypes.size());
+
+    UEDumpFilter dumpFilter;
+    std::string filterError;
+    if (!dumpFilter.AddRules(sIncludeRules, ';', '+', &filterError) || !dumpFilter.AddRules(sExcludeRules, ';', '-', &filterError))
+    {
+        LOGE("Filter: %s.", filterError.c_str());
+        return 1;
+    }
+
+    TraceRecorder::setThreadName("main");
+    TraceRecorder::Get().setEnabled(bTrace);
+    LOGI("Trace: %s", bTrace ? "true" : "false");
+
+    ThreadPool::Configure(size_t(std::max(0, nThreads)), bPinThreads);
+    LOGI("Worker threads: %d", int(ThreadPool::Get().workersCount()));
     LOGI("==========================");
 
     std::string sDumpDir = sOutDirectory + "/UEDump3r";
@@ -294,45 +429,77 @@ int main(int argc, char **args)
     std::unordered_map<std::string, BufferFmt> dumpbuffersMap;
     auto dmpStart = std::chrono::steady_clock::now();
 
-    for (auto &it : UE_Games)
+    IGameProfile *gameProfile = nullptr;
+    const UE_Pointers *knownPointers = nullptr;
+    if (!bAutoDetect)
     {
-        for (auto &pkg : it->GetAppIDs())
+        for (auto &it : UE_Games)
         {
-            if (sGamePackage != pkg)
-                continue;
+            const auto &appIDs = it->GetAppIDs();
+            if (std::find(appIDs.begin(), appIDs.end(), sGamePackage) != appIDs.end())
+            {
+                gameProfile = it;
+                break;
+            }
+        }
+    }
+
+    // unknown package or renamed build
+    UEProfileDetector::Result detected;
+    if (!gameProfile)
+    {
+        LOGI("Detecting game profile...");
+        detected = UEProfileDetector::Detect(UE_Games);
+        if (detected.Profile)
+        {
+            gameProfile = detected.Profile;
+            knownPointers = &detected.Pointers;
+            LOGI("Detected profile: %s", gameProfile->GetAppName().c_str());
+        }
+        LOGI("==========================");
+    }
 
-            if (bDumpLib)
+    if (gameProfile)
+    {
+        if (bDumpLib)
+        {
+            auto ue_elf = gameProfile->GetUnrealELF();
+            if (!ue_elf.isValid())
             {
-                auto ue_elf = it->GetUnrealELF();
-                if (!ue_elf.isValid())
-                {
-                    LOGE("Couldn't find a valid UE ELF in target process maps.");
-                    return 1;
-                }
-
-                LOGI("Dumping unreal lib from memory...");
-                std::string libDumpPath = KittyUtils::String::Fmt("%s/libUE_%p-%p.so", sDumpGameDir.c_str(), ue_elf.base(), ue_elf.end());
-                bool res = kMgr.dumpMemELF(ue_elf, libDumpPath);
-                LOGI("Dumping lib: %s.",  res ? "success" : "failed");
-                if (res)
-                {
-                    LOGI("%s", libDumpPath.c_str());
-                }
-                LOGI("==========================");
+                LOGE("Couldn't find a valid UE ELF in target process maps.");
+                return 1;
             }
 
-            LOGI("Initializing Dumper...");
-            if (uEDumper.Init(it))
+            LOGI("Dumping unreal lib from memory...");
+            TRACE_SCOPE("DumpLib");
+            std::string libDumpPath = KittyUtils::String::Fmt("%s/libUE_%p-%p.so", sDumpGameDir.c_str(), ue_elf.base(), ue_elf.end());
+            bool res = kMgr.dumpMemELF(ue_elf, libDumpPath);
+            LOGI("Dumping lib: %s.",  res ? "success" : "failed");
+            if (res)
             {
-                dumpSuccess = uEDumper.Dump(&dumpbuffersMap);
+                LOGI("%s", libDumpPath.c_str());
             }
+            LOGI("==========================");
+        }
 
-            goto done;
+        LOGI("Initializing Dumper...");
+        if (!bNoCache)
+            uEDumper.setCacheDirectory(sDumpDir + "/.cache");
+
+        if (uEDumper.Init(gameProfile, knownPointers))
+        {
+            uEDumper.setOutputDirectory(sDumpGameDir);
+            uEDumper.setSDKLayout(bSDKLayout);
+            uEDumper.setSDKDatabase(bSDKDatabase);
+            uEDumper.setUsmap(bUsmap);
+            uEDumper.setOffsetsOnly(bOffsetsOnly);
+            uEDumper.setDiscoverOffsets(bDiscoverOffsets);
+            uEDumper.setRootTypes(rootTypes);
+            uEDumper.setDumpFilter(dumpFilter);
+            dumpSuccess = uEDumper.Dump(&dumpbuffersMap);
         }
     }
 
-done:
-
     if (!dumpSuccess && uEDumper.GetLastError().empty())
     {
         LOGE("Game is not supported. check AppID.");
@@ -348,18 +515,28 @@ done:
 
     LOGI("Saving Files...");
 
-    for (const auto &it : dumpbuffersMap)
+    for (auto &it : dumpbuffersMap)
     {
         if (!it.first.empty())
         {
+            TRACE_SCOPE_DETAIL("SaveFile", it.first);
             std::string path = KittyUtils::String::Fmt("%s/%s", sDumpGameDir.c_str(), it.first.c_str());
-            it.second.writeBufferToFile(path);
+            bool saved = it.second.isStreaming() ? it.second.closeStream() : it.second.writeBufferToFile(path);
+            if (!saved)
+                LOGE("Couldn't save %s", path.c_str());
         }
     }
 
     auto dmpEnd = std::chrono::steady_clock::now();
     std::chrono::duration<float, std::milli> dmpDurationMS = (dmpEnd - dmpStart);
 
+    if (bTrace)
+    {
+        std::string tracePath = sDumpGameDir + "/Trace.json";
+        if (!TraceRecorder::Get().writeChromeTrace(tracePath))
+            LOGE("Couldn't save %s", tracePath.c_str());
+    }
+
     if (!uEDumper.GetLastError().empty())
     {
         LOGI("Dump Status: %s", uEDumper.GetLastError().c_str());
@@ -14,6 +14,7 @@
 
 #include "UE/UEMemory.hpp"
 #include "UE/UEGameProfile.hpp"
+#include "UE/UEProfileDetector.hpp"
 
 #include "UE/UEGameProfiles/ArenaBreakout.hpp"
 #include "UE/UEGameProfiles/BlackClover.hpp"
@@ -44,6 +45,7 @@
 #include "UE/UEGameProfiles/LineageW.hpp"
 #include "UE/UEGameProfiles/RLSideswipe.hpp"
 #include "UE/UEGameProfiles/PUBG.hpp"
+#include "UE/UEGameProfiles/Generic.hpp"
 
 std::vector<IGameProfile *> UE_Games = {
     new PESProfile(),
@@ -75,6 +77,8 @@ std::vector<IGameProfile *> UE_Games = {
     new LineageWProfile(),
     new RLSideswipeProfile(),
     new PUBGProfile(),
+    // last so the detector prefers a game profile on equal scores
+    new GenericProfile(),
 };
 
 #define kUEDUMPER_VERSION "4.3.0"
@@ -194,45 +198,64 @@ void dump_thread(bool bDumpLib)
     std::unordered_map<std::string, BufferFmt> dumpbuffersMap;
     auto dmpStart = std::chrono::steady_clock::now();
 
+    IGameProfile *gameProfile = nullptr;
+    const UE_Pointers *knownPointers = nullptr;
     for (auto &it : UE_Games)
     {
-        for (auto &pkg : it->GetAppIDs())
+        const auto &appIDs = it->GetAppIDs();
+        if (std::find(appIDs.begin(), appIDs.end(), sGamePackage) != appIDs.end())
         {
-            if (sGamePackage != pkg)
-                continue;
+            gameProfile = it;
+            break;
+        }
+    }
+
+    // unknown package or renamed build
+    UEProfileDetector::Result detected;
+    if (!gameProfile)
+    {
+        LOGI("Detecting game profile...");
+        detected = UEProfileDetector::Detect(UE_Games);
+        if (detected.Profile)
+        {
+            gameProfile = detected.Profile;
+            knownPointers = &detected.Pointers;
+            LOGI("Detected profile: %s", gameProfile->GetAppName().c_str());
+        }
+        LOGI("==========================");
+    }
 
-            if (bDumpLib)
+    if (gameProfile)
+    {
+        if (bDumpLib)
+        {
+            auto ue_elf = gameProfile->GetUnrealELF();
+            if (!ue_elf.isValid())
             {
-                auto ue_elf = it->GetUnrealELF();
-                if (!ue_elf.isValid())
-                {
-                    LOGE("Couldn't find a valid UE ELF in target process maps.");
-                    return;
-                }
-
-                LOGI("Dumping unreal lib from memory...");
-                std::string libDumpPath = KittyUtils::String::Fmt("%s/libUE_%p-%p.so", sDumpGameDir.c_str(), ue_elf.base(), ue_elf.end());
-                bool res = kMgr.dumpMemELF(ue_elf, libDumpPath);
-                LOGI("Dumping lib: %s.",  res ? "success" : "failed");
-                if (res)
-                {
-                    LOGI("%s", libDumpPath.c_str());
-                }
-                LOGI("==========================");
+                LOGE("Couldn't find a valid UE ELF in target process maps.");
+                return;
             }
 
-            LOGI("Initializing Dumper...");
-            if (uEDumper.Init(it))
+            LOGI("Dumping unreal lib from memory...");
+            std::string libDumpPath = KittyUtils::String::Fmt("%s/libUE_%p-%p.so", sDumpGameDir.c_str(), ue_elf.base(), ue_elf.end());
+            bool res = kMgr.dumpMemELF(ue_elf, libDumpPath);
+            LOGI("Dumping lib: %s.",  res ? "success" : "failed");
+            if (res)
             {
-                dumpSuccess = uEDumper.Dump(&dumpbuffersMap);
+                LOGI("%s", libDumpPath.c_str());
             }
+            LOGI("==========================");
+        }
 
-            goto done;
+        LOGI("Initializing Dumper...");
+        uEDumper.setCacheDirectory(sDumpDir + "/.cache");
+        if (uEDumper.Init(gameProfile, knownPointers))
+        {
+            uEDumper.setOutputDirectory(sDumpGameDir);
+            dumpSuccess = uEDumper.Dump(&dumpbuffersMap);
         }
     }
 
-done:
-
     if (!dumpSuccess && uEDumper.GetLastError().empty())
     {
         LOGE("Game is not supported. check AppID.");
@@ -248,12 +271,14 @@ done:
 
     LOGI("Saving Files...");
 
-    for (const auto &it : dumpbuffersMap)
+    for (auto &it : dumpbuffersMap)
     {
         if (!it.first.empty())
         {
             std::string path = KittyUtils::String::Fmt("%s/%s", sDumpGameDir.c_str(), it.first.c_str());
-            it.second.writeBufferToFile(path);
+            bool saved = it.second.isStreaming() ? it.second.closeStream() : it.second.writeBufferToFile(path);
+            if (!saved)
+                LOGE("Couldn't save %s", path.c_str());
         }
     }
 